@@ -31,6 +31,8 @@
 extern "C" {
 #endif
 
+#include <string.h>
+
 #include "app_timer_api.h"
 
 
@@ -48,29 +50,6 @@ extern "C" {
 #define FLAGS_TYPE_POS  (0x2u)
 
 
-#ifdef APP_TIMER_STATS_ENABLE
-static app_timer_stats_t _stats =
-{
-    .num_timers=0u,
-    .num_timers_high_watermark=0u,
-    .num_expiry_overflows=0u,
-    .next_active_timer=NULL,
-    .running_timer_count=0u,
-    .inside_target_count_reached=false
-};
-#endif // APP_TIMER_STATS_ENABLE
-
-
-/**
- * Represents a doubly-linked list of app_timer_t instances
- */
-typedef struct
-{
-    app_timer_t *head;
-    app_timer_t *tail;
-} _timer_list_t;
-
-
 /**
  * Represents all possible states that an app_timer_t instance can be in
  */
@@ -83,46 +62,48 @@ typedef enum
 
 
 /**
- * Keeps track of total elapsed timer counts, regardless of overflows, while there
- * are active timers
- */
-static volatile app_timer_running_count_t _running_timer_count = 0u;
-
-/**
- * The list of active timers stores all timer instances that have been started with
- * 'app_timer_start' but not yet expired.
- */
-static volatile _timer_list_t _active_timers = { .head=NULL, .tail=NULL };
-
-/**
- * The last value that was passed to set_timer_period_counts
+ * Most significant bit of app_timer_running_count_t, used for serial number arithmetic
  */
-static volatile app_timer_count_t _last_timer_period = 0u;
+#define RUNNING_COUNT_SIGN_BIT ((app_timer_running_count_t) 1u << ((sizeof(app_timer_running_count_t) * 8u) - 1u))
 
-/**
- * Hardware timer/counter value after it was last started (some timer/counters do not start counting from 0)
- */
-static volatile app_timer_count_t _counts_after_last_start = 0u;
 
 /**
- * True when app_timer_target_count_reached is executing
+ * Returns the timestamp, in timer counts, when an active timer will expire
+ *
+ * @param timer  Pointer to timer instance
+ *
+ * @return Expiry time of timer, in timer counts
  */
-static volatile bool _inside_target_count_reached = false;
+static inline app_timer_running_count_t _timer_expiry(app_timer_t *timer)
+{
+#ifdef APP_TIMER_ABSOLUTE_DEADLINE
+    return timer->expiry_counts;
+#else
+    return timer->start_counts + timer->total_counts;
+#endif // APP_TIMER_ABSOLUTE_DEADLINE
+}
 
-/**
- * True when app_timer_init has completed successfully
- */
-static bool _initialized = false;
 
 /**
- * Pointer to the hardware model in use
+ * Compares two timestamps using serial number arithmetic, so the result is correct across
+ * wraparound of app_timer_running_count_t, as long as the two timestamps are less than half
+ * the range of app_timer_running_count_t apart (app_timer_start enforces this by rejecting
+ * longer timer periods).
+ *
+ * @param a  First timestamp, in timer counts
+ * @param b  Second timestamp, in timer counts
+ *
+ * @return True if 'a' is earlier than 'b'
  */
-static app_timer_hw_model_t *_hw_model = NULL;
+static inline bool _counts_before(app_timer_running_count_t a, app_timer_running_count_t b)
+{
+    return (0u != ((a - b) & RUNNING_COUNT_SIGN_BIT));
+}
 
 
 /**
  * Calculate number of ticks until an active timer expires. Should only be used on
- * timers that are known to be active (i.e. timers linked into the active timers list).
+ * timers that are known to be active (i.e. timers linked into the set of active timers).
  *
  * @param now    Current timestamp in ticks
  * @param timer  Pointer to timer instance
@@ -131,9 +112,9 @@ static app_timer_hw_model_t *_hw_model = NULL;
  */
 static inline app_timer_running_count_t _ticks_until_expiry(app_timer_running_count_t now, app_timer_t *timer)
 {
-    app_timer_running_count_t expiry = timer->start_counts + timer->total_counts;
+    app_timer_running_count_t expiry = _timer_expiry(timer);
 
-    if (expiry < now)
+    if (_counts_before(expiry, now))
     {
         // Expiry was in the past
         return 0u;
@@ -145,42 +126,152 @@ static inline app_timer_running_count_t _ticks_until_expiry(app_timer_running_co
 }
 
 
+#ifdef APP_TIMER_SLACK_ENABLE
 /**
- * Inserts a new timer into the doubly-linked list of active timers, ensuring that the order of the
- * list is maintained (the next timer to expire must always be the head of the list).
+ * Moves an expiry time later, within the slack allowed for the timer, to the time with the
+ * most trailing zero bits. Timers whose slack windows overlap are likely to be moved to the
+ * same time, so they can all be handled by one interrupt.
  *
- * @note The #start_counts and #total_counts fields of the timer must be set before calling
- *       this function. #start_counts should be set to the timestamp in counts when the timer
- *       was added via #app_timer_start, and #total_counts should be set to the timer period
- *       in counts.
+ * @param timer   Pointer to timer instance (#total_counts and #slack_counts must be set)
+ * @param expiry  Expiry time of timer without slack, in timer counts
  *
- * @param timer Pointer to timer instance to insert
- * @param now   Current timestamp in timer counts
+ * @return Expiry time of timer with slack applied, in timer counts
  */
-static void _insert_active_timer(app_timer_t *timer, app_timer_running_count_t now)
+static app_timer_running_count_t _apply_slack(app_timer_t *timer, app_timer_running_count_t expiry)
 {
-    // Set timer state to active
-    timer->flags &= ~FLAGS_STATE_MASK;
-    timer->flags |= (TIMER_STATE_ACTIVE << FLAGS_STATE_POS);
+    app_timer_running_count_t slack = timer->slack_counts;
 
-#ifdef APP_TIMER_STATS_ENABLE
-    _stats.num_timers += 1u;
+    // Expiry time must stay less than half the range of app_timer_running_count_t away
+    if (slack >= (RUNNING_COUNT_SIGN_BIT - timer->total_counts))
+    {
+        slack = RUNNING_COUNT_SIGN_BIT - timer->total_counts - 1u;
+    }
 
-    if (_stats.num_timers_high_watermark < _stats.num_timers)
+    if (0u == slack)
     {
-        _stats.num_timers_high_watermark = _stats.num_timers;
+        return expiry;
     }
-#endif // APP_TIMER_STATS_ENABLE
 
-    if (NULL == _active_timers.head)
+    app_timer_running_count_t limit = expiry + slack;
+
+    // Set all bits below the most significant bit that differs between expiry and limit
+    app_timer_running_count_t mask = expiry ^ limit;
+
+    for (uint32_t shift = 1u; shift < (sizeof(app_timer_running_count_t) * 8u); shift <<= 1u)
+    {
+        mask |= (mask >> shift);
+    }
+
+    // Clearing those bits in limit gives the value in [expiry, limit] with the most trailing zeros
+    return limit & ~(mask >> 1u);
+}
+#endif // APP_TIMER_SLACK_ENABLE
+
+
+/**
+ * Sets the start time of a timer that is being started (#total_counts must already be set)
+ *
+ * @param timer  Pointer to timer instance
+ * @param now    Current timestamp in timer counts
+ */
+static inline void _set_start_timestamp(app_timer_t *timer, app_timer_running_count_t now)
+{
+#ifdef APP_TIMER_SLACK_ENABLE
+    // Timer may expire up to #slack_counts later than requested, to share an interrupt
+    app_timer_running_count_t expiry = _apply_slack(timer, now + timer->total_counts);
+#else
+    app_timer_running_count_t expiry = now + timer->total_counts;
+#endif // APP_TIMER_SLACK_ENABLE
+
+#ifdef APP_TIMER_ABSOLUTE_DEADLINE
+    timer->expiry_counts = expiry;
+#else
+    timer->start_counts = expiry - timer->total_counts;
+#endif // APP_TIMER_ABSOLUTE_DEADLINE
+}
+
+
+#if !defined(APP_TIMER_ACTIVE_SET_HEAP)
+/**
+ * Removes a timer from a doubly-linked list of timers.
+ *
+ * @param list   Pointer to list containing timer to be removed
+ * @param timer  Pointer to timer instance to unlink
+ */
+static void _remove_timer_from_list(volatile _app_timer_list_t *list, app_timer_t *timer)
+{
+    if (list->head == timer)
+    {
+        // Removing head timer
+        list->head = timer->next;
+    }
+
+    if (list->tail == timer)
+    {
+        // Removing tail timer
+        list->tail = timer->previous;
+    }
+
+    if (NULL != timer->next)
+    {
+        timer->next->previous = timer->previous;
+    }
+
+    if (NULL != timer->previous)
+    {
+        timer->previous->next = timer->next;
+    }
+
+    timer->next = NULL;
+    timer->previous = NULL;
+}
+
+
+/**
+ * Marks all timers in a doubly-linked list of timers as stopped, and unlinks them from
+ * each other. The list itself is left unchanged, and must be cleared by the caller.
+ *
+ * @param list  Pointer to list of timers to stop
+ */
+static void _stop_timer_list(volatile _app_timer_list_t *list)
+{
+    app_timer_t *curr = list->head;
+
+    while (NULL != curr)
+    {
+        app_timer_t *next = curr->next;
+        curr->next = NULL;
+        curr->previous = NULL;
+        curr->flags &= ~FLAGS_STATE_MASK;
+        curr = next;
+    }
+}
+#endif // !APP_TIMER_ACTIVE_SET_HEAP
+
+
+#if defined(APP_TIMER_ACTIVE_SET_SORTED_LIST)
+/**
+ * Inserts a new timer into the doubly-linked list of active timers, ensuring that the order of the
+ * list is maintained (the next timer to expire must always be the head of the list).
+ *
+ * @param ctx   Pointer to timer context
+ * @param timer Pointer to timer instance to insert
+ * @param now   Current timestamp in timer counts
+ *
+ * @return Always true (there is no limit on the length of the list)
+ */
+static bool _active_set_insert(app_timer_ctx_t *ctx, app_timer_t *timer, app_timer_running_count_t now)
+{
+    if (NULL == ctx->active_timers.head)
     {
         // No other active timers
-        _active_timers.head = timer;
-        _active_timers.tail = timer;
-        return;
+        ctx->active_timers.head = timer;
+        ctx->active_timers.tail = timer;
+        return true;
     }
 
-    app_timer_t *curr = _active_timers.head;
+    app_timer_t *curr = ctx->active_timers.head;
+    app_timer_running_count_t timer_ticks = _ticks_until_expiry(now, timer);
 
     /* Pending timers are maintained as a doubly-linked list, in ascending order
      * of expiry time, such that the timer set to expire next is always the head of
@@ -190,7 +281,7 @@ static void _insert_active_timer(app_timer_t *timer, app_timer_running_count_t n
     while (NULL != curr)
     {
         // Timer ticks until this timer expires (0u if it should have already expired)
-        if (_ticks_until_expiry(now, curr) > timer->total_counts)
+        if (_ticks_until_expiry(now, curr) > timer_ticks)
         {
             // First timer seen that expires later than new timer, break out
             break;
@@ -203,14 +294,14 @@ static void _insert_active_timer(app_timer_t *timer, app_timer_running_count_t n
     {
         /* Traversed the list without finding any timers that expire later than new timer,
          * so the new timer goes at the end and becomes the new tail of the list. */
-        timer->previous = _active_timers.tail;
+        timer->previous = ctx->active_timers.tail;
 
-        if (NULL != _active_timers.tail)
+        if (NULL != ctx->active_timers.tail)
         {
-            _active_timers.tail->next = timer;
+            ctx->active_timers.tail->next = timer;
         }
 
-        _active_timers.tail = timer;
+        ctx->active_timers.tail = timer;
         timer->next = NULL;
     }
     else
@@ -225,229 +316,2340 @@ static void _insert_active_timer(app_timer_t *timer, app_timer_running_count_t n
         timer->next = curr;
         curr->previous = timer;
 
-        if (curr == _active_timers.head)
+        if (curr == ctx->active_timers.head)
         {
-            _active_timers.head = timer;
+            ctx->active_timers.head = timer;
         }
     }
+
+    return true;
 }
 
 
 /**
- * Removes a timer from a doubly-linked list of timers.
+ * Removes a timer from the list of active timers
  *
- * @param list   Pointer to list containing timer to be removed
- * @param timer  Pointer to timer instance to unlink
+ * @param ctx    Pointer to timer context
+ * @param timer  Pointer to timer instance to remove
  */
-static void _remove_timer_from_list(volatile _timer_list_t *list, app_timer_t *timer)
+static inline void _active_set_remove(app_timer_ctx_t *ctx, app_timer_t *timer)
 {
-    if (list->head == timer)
-    {
-        // Removing head timer
-        list->head = timer->next;
-    }
-
-    if (list->tail == timer)
-    {
-        // Removing tail timer
-        list->tail = timer->previous;
-    }
-
-    if (NULL != timer->next)
-    {
-        timer->next->previous = timer->previous;
-    }
-
-    if (NULL != timer->previous)
-    {
-        timer->previous->next = timer->next;
-    }
-
-    timer->next = NULL;
-    timer->previous = NULL;
+    _remove_timer_from_list(&ctx->active_timers, timer);
 }
 
 
 /**
- * Helper function to configure the hardware timer/counter to expire after a certain
- * number of counts.
+ * Removes the next timer to expire from the list of active timers, because it has expired
  *
- * @param total_counts   Total timer/counter counts until expiry (if this value is larger
- *                       than _hw_model.max_count, then the timer/counter will be configured
- *                       for _hw_model.max_count instead)
+ * @param ctx    Pointer to timer context
+ * @param timer  Pointer to timer instance to remove (must be the head of the list)
  */
-static void _configure_timer(app_timer_running_count_t total_counts)
+static inline void _active_set_expire(app_timer_ctx_t *ctx, app_timer_t *timer)
 {
-    app_timer_count_t counts_from_now = (total_counts > ((app_timer_running_count_t) _hw_model->max_count)) ?
-                                       _hw_model->max_count :
-                                       (app_timer_count_t) total_counts;
-
-    _hw_model->set_timer_period_counts(counts_from_now);
-    _last_timer_period = counts_from_now;
+    _remove_timer_from_list(&ctx->active_timers, timer);
 }
 
 
 /**
- * Returns the total number of ticks elapsed since the first of the currently active
- * app_timer instances were started (Should return 0 when no app_timer instances are running)
+ * Returns the active timer that will expire next, or NULL if there are no active timers
  */
-static inline app_timer_running_count_t _total_timer_counts(void)
+static inline app_timer_t *_active_set_next(app_timer_ctx_t *ctx)
 {
-    app_timer_count_t ticks_elapsed = _hw_model->read_timer_counts() - _counts_after_last_start;
-    return _running_timer_count + ((app_timer_running_count_t) ticks_elapsed);
+    return ctx->active_timers.head;
 }
 
 
 /**
- * @see app_timer_api.h
+ * Removes all timers from the list of active timers, and marks them as stopped
+ *
+ * @param ctx  Pointer to timer context
  */
-void app_timer_target_count_reached(void)
+static void _active_set_clear(app_timer_ctx_t *ctx)
 {
-    /* Set flag indicating we are in the function handling an elapsed count, so
-     * that any calls to app_timer_start inside handlers will know not to configure
-     * the timer, since we will do that at the end of this function. This does not
-     * need to be protected from interrupts. */
-    _inside_target_count_reached = true;
+    _stop_timer_list(&ctx->active_timers);
+    ctx->active_timers.head = NULL;
+    ctx->active_timers.tail = NULL;
+}
 
-    // Disable interrupts to update _running_timer_count and pop expired timers off the list
-    app_timer_int_status_t int_status = 0u;
-    _hw_model->set_interrupts_enabled(false, &int_status);
+#elif defined(APP_TIMER_ACTIVE_SET_TIMING_WHEEL)
 
-    // The tick on which the head active timer should have expired
-    app_timer_running_count_t expiry_count = _running_timer_count + _last_timer_period;
+/**
+ * Bit mask to extract a slot index from a timestamp
+ */
+#define WHEEL_SLOT_MASK ((app_timer_running_count_t) (APP_TIMER_WHEEL_SLOT_COUNT - 1u))
 
-    // Update _running_timer_count with ticks elapsed since last update
-#ifdef APP_TIMER_FREERUNNING_COUNTER
-    _running_timer_count += (_hw_model->read_timer_counts() - _counts_after_last_start);
-#else
-    _running_timer_count += (app_timer_running_count_t) _last_timer_period;
-#endif // APP_TIMER_FREERUNNING_COUNTER
 
-    // Stop the timer counter, re-start it to time how long it takes to handle all expired timers
-#ifndef APP_TIMER_RECONFIG_WITHOUT_STOPPING
-    _hw_model->set_timer_running(false);
-#endif // APP_TIMER_RECONFIG_WITHOUT_STOPPING
-    _configure_timer(_hw_model->max_count);
-#ifndef APP_TIMER_RECONFIG_WITHOUT_STOPPING
-    _hw_model->set_timer_running(true);
-#endif // APP_TIMER_RECONFIG_WITHOUT_STOPPING
-    _counts_after_last_start = _hw_model->read_timer_counts();
+/**
+ * Returns the position of the lowest bit that is set in a non-zero value
+ */
+static inline uint8_t _lowest_set_bit(app_timer_running_count_t value)
+{
+#if defined(__GNUC__)
+    return (uint8_t) __builtin_ctzll((unsigned long long) value);
+#else
+    uint8_t pos = 0u;
 
-    // Remove all expired timers from the active list, and run their handlers
-    while ((NULL != _active_timers.head) && (_ticks_until_expiry(expiry_count, _active_timers.head) == 0u))
+    while (0u == (value & 1u))
     {
-        app_timer_t *curr = _active_timers.head;
+        value >>= 1u;
+        pos += 1u;
+    }
 
-        // Unlink timer from active list
-        _remove_timer_from_list(&_active_timers, curr);
+    return pos;
+#endif // __GNUC__
+}
 
-#ifdef APP_TIMER_STATS_ENABLE
-        _stats.num_timers -= 1u;
-#endif // APP_TIMER_STATS_ENABLE
 
-        // Clear state bits, set timer state to expired
-        curr->flags &= ~FLAGS_STATE_MASK;
-        curr->flags |= (TIMER_STATE_EXPIRED << FLAGS_STATE_POS);
+/**
+ * Calculate number of ticks from the 'now' timestamp of the wheel until an active timer expires.
+ *
+ * No timer can expire before 'now', since 'now' is only moved forward to the expiry time of
+ * the next timer, so unlike #_ticks_until_expiry this needs no comparison, and works for
+ * expiry times up to the full range of app_timer_running_count_t after 'now' (which can happen
+ * when 'now' lags behind the current time by up to one timer period).
+ *
+ * @param ctx    Pointer to timer context
+ * @param timer  Pointer to timer instance
+ *
+ * @return Ticks from the 'now' timestamp of the wheel until timer expires
+ */
+static inline app_timer_running_count_t _wheel_ticks_until_expiry(app_timer_ctx_t *ctx, app_timer_t *timer)
+{
+    return _timer_expiry(timer) - ctx->active_timers.now;
+}
 
-        // Run the handler
-        if (NULL != curr->handler)
-        {
-#ifdef APP_TIMER_ENABLE_INTERRUPTS_FOR_HANDLER
-            _hw_model->set_interrupts_enabled(true, &int_status);
-#endif // APP_TIMER_ENABLE_INTERRUPTS_FOR_HANDLER
 
-            curr->handler(curr->context);
+/**
+ * Finds the level and slot that a timer belongs in, based on its expiry time and the
+ * current 'now' timestamp of the wheel.
+ *
+ * @param ctx    Pointer to timer context
+ * @param timer  Pointer to timer instance
+ * @param level  Pointer to location to store level number
+ * @param slot   Pointer to location to store slot number
+ */
+static void _wheel_position(app_timer_ctx_t *ctx, app_timer_t *timer, uint8_t *level, uint8_t *slot)
+{
+    app_timer_running_count_t expiry = _timer_expiry(timer);
+    app_timer_running_count_t diff = expiry ^ ctx->active_timers.now;
+    uint8_t lvl = 0u;
 
-#ifdef APP_TIMER_ENABLE_INTERRUPTS_FOR_HANDLER
-            _hw_model->set_interrupts_enabled(false, &int_status);
-#endif // APP_TIMER_ENABLE_INTERRUPTS_FOR_HANDLER
+    while (diff > WHEEL_SLOT_MASK)
+    {
+        diff >>= APP_TIMER_WHEEL_SLOT_BITS;
+        lvl += 1u;
+    }
 
-        }
+    *level = lvl;
+    *slot = (uint8_t) ((expiry >> (lvl * APP_TIMER_WHEEL_SLOT_BITS)) & WHEEL_SLOT_MASK);
+}
 
-        // Extract timer type from flags var
-        app_timer_type_e type = (app_timer_type_e) ((curr->flags & FLAGS_TYPE_MASK) >> FLAGS_TYPE_POS);
 
-        // Extract timer state from flags var
-        _timer_state_e state = (_timer_state_e) ((curr->flags & FLAGS_STATE_MASK) >> FLAGS_STATE_POS);
+/**
+ * Appends a timer to the slot it belongs in, based on the current 'now' timestamp of the wheel
+ *
+ * @param ctx    Pointer to timer context
+ * @param timer  Pointer to timer instance
+ */
+static void _wheel_link(app_timer_ctx_t *ctx, app_timer_t *timer)
+{
+    uint8_t level;
+    uint8_t slot;
+    _wheel_position(ctx, timer, &level, &slot);
 
-        if ((APP_TIMER_TYPE_REPEATING == type) && (TIMER_STATE_EXPIRED == state))
-        {
-            /* Timer is repeating, and was not-restarted or stopped by the handler,
-             * so must be re-inserted with a new start time */
-            curr->start_counts = expiry_count;
-            _insert_active_timer(curr, _total_timer_counts());
-        }
-    }
+    volatile _app_timer_list_t *list = &ctx->active_timers.slots[level][slot];
+
+    timer->next = NULL;
+    timer->previous = list->tail;
 
-    if (NULL == _active_timers.head)
+    if (NULL == list->tail)
     {
-        // No more active timers, stop the counter
-        _running_timer_count = 0u;
-        _hw_model->set_timer_running(false);
+        list->head = timer;
     }
     else
     {
-        // Update running timer count with time taken to run expired handlers
-        _running_timer_count += (_hw_model->read_timer_counts() - _counts_after_last_start);
+        list->tail->next = timer;
+    }
 
-        // Configure timer for the next expiration and re-start
-        app_timer_running_count_t ticks_until_expiry = _ticks_until_expiry(_running_timer_count, _active_timers.head);
+    list->tail = timer;
 
-        /* If the head timer should have already expired (it expired while we were handling
-         * other expired timers in the loop above), just configure the hardware for 1 tick,
-         * and the head timer will be handled in the next call (although it does have the downside
-         * that the head timer will expire at least 1 tick late) */
-        bool expiry_overflow = (ticks_until_expiry == 0u);
+    ctx->active_timers.occupied_slots[level] |= (1u << slot);
+    ctx->active_timers.occupied_levels |= ((app_timer_running_count_t) 1u << level);
+}
 
-#ifndef APP_TIMER_RECONFIG_WITHOUT_STOPPING
-    _hw_model->set_timer_running(false);
-#endif // APP_TIMER_RECONFIG_WITHOUT_STOPPING
 
-        _configure_timer(expiry_overflow ? 1u : ticks_until_expiry);
-#ifdef APP_TIMER_STATS_ENABLE
-        _stats.num_expiry_overflows += (uint32_t) expiry_overflow;
-#endif // APP_TIMER_STATS_ENABLE
+/**
+ * Unlinks a timer from the slot it is in, based on the current 'now' timestamp of the wheel
+ *
+ * @param ctx    Pointer to timer context
+ * @param timer  Pointer to timer instance
+ */
+static void _wheel_unlink(app_timer_ctx_t *ctx, app_timer_t *timer)
+{
+    uint8_t level;
+    uint8_t slot;
+    _wheel_position(ctx, timer, &level, &slot);
 
-#ifndef APP_TIMER_RECONFIG_WITHOUT_STOPPING
-        _hw_model->set_timer_running(true);
-#endif // APP_TIMER_RECONFIG_WITHOUT_STOPPING
-        _counts_after_last_start = _hw_model->read_timer_counts();
-    }
+    volatile _app_timer_list_t *list = &ctx->active_timers.slots[level][slot];
+    _remove_timer_from_list(list, timer);
 
-    _hw_model->set_interrupts_enabled(true, &int_status);
+    if (NULL == list->head)
+    {
+        ctx->active_timers.occupied_slots[level] &= ~(1u << slot);
 
-    _inside_target_count_reached = false;
+        if (0u == ctx->active_timers.occupied_slots[level])
+        {
+            ctx->active_timers.occupied_levels &= ~((app_timer_running_count_t) 1u << level);
+        }
+    }
 }
 
 
 /**
- * @see app_timer_api.h
+ * Inserts a new timer into the timing wheel
+ *
+ * @param ctx   Pointer to timer context
+ * @param timer Pointer to timer instance to insert
+ * @param now   Current timestamp in timer counts (only used if the wheel is empty; slots are
+ *              otherwise relative to the wheel's own timestamp)
+ *
+ * @return Always true (there is no limit on the number of timers in a slot)
  */
-app_timer_error_e app_timer_create(app_timer_t *timer, app_timer_handler_t handler, app_timer_type_e type)
+static bool _active_set_insert(app_timer_ctx_t *ctx, app_timer_t *timer, app_timer_running_count_t now)
 {
-    if (!_initialized)
+    if (0u == ctx->active_timers.occupied_levels)
     {
-        return APP_TIMER_INVALID_STATE;
+        // No other active timers, wheel starts again from the current time
+        ctx->active_timers.now = now;
+        ctx->active_timers.next = timer;
     }
+    else if ((NULL != ctx->active_timers.next) &&
+             (_wheel_ticks_until_expiry(ctx, ctx->active_timers.next) > _wheel_ticks_until_expiry(ctx, timer)))
+    {
+        // New timer expires before the cached next timer
+        ctx->active_timers.next = timer;
+    }
+
+    _wheel_link(ctx, timer);
+
+    return true;
+}
+
+
+/**
+ * Removes a timer from the timing wheel
+ *
+ * @param ctx    Pointer to timer context
+ * @param timer  Pointer to timer instance to remove
+ */
+static void _active_set_remove(app_timer_ctx_t *ctx, app_timer_t *timer)
+{
+    _wheel_unlink(ctx, timer);
+
+    if (ctx->active_timers.next == timer)
+    {
+        // Next timer will be found again the next time it's needed
+        ctx->active_timers.next = NULL;
+    }
+
+}
+
+
+/**
+ * Moves the 'now' timestamp of the timing wheel forward to the expiry time of the next
+ * timer, and then removes that timer from the wheel. Any higher-level slots that 'now'
+ * moves into are cascaded down into the lower levels.
+ *
+ * @param ctx    Pointer to timer context
+ * @param timer  Pointer to timer instance to remove (must be the next timer to expire)
+ */
+static void _active_set_expire(app_timer_ctx_t *ctx, app_timer_t *timer)
+{
+    app_timer_running_count_t expiry = _timer_expiry(timer);
+    app_timer_running_count_t old_now = ctx->active_timers.now;
+
+    if (expiry != old_now)
+    {
+        ctx->active_timers.now = expiry;
+
+        /* No timer expires before the new 'now', so any slots that 'now' skipped over are
+         * empty, and only the slot that 'now' lands in needs to be cascaded, for each level
+         * where 'now' moved into a new slot */
+        for (uint8_t level = APP_TIMER_WHEEL_LEVEL_COUNT - 1u; level > 0u; level--)
+        {
+            uint8_t shift = level * APP_TIMER_WHEEL_SLOT_BITS;
+
+            if ((expiry >> shift) == (old_now >> shift))
+            {
+                // 'now' is still in the same slot at this level
+                continue;
+            }
+
+            uint8_t slot = (uint8_t) ((expiry >> shift) & WHEEL_SLOT_MASK);
+
+            if (0u == (ctx->active_timers.occupied_slots[level] & (1u << slot)))
+            {
+                continue;
+            }
+
+            // Detach all timers in this slot, and re-link them relative to the new 'now'
+            app_timer_t *curr = ctx->active_timers.slots[level][slot].head;
+            ctx->active_timers.slots[level][slot].head = NULL;
+            ctx->active_timers.slots[level][slot].tail = NULL;
+            ctx->active_timers.occupied_slots[level] &= ~(1u << slot);
+
+            if (0u == ctx->active_timers.occupied_slots[level])
+            {
+                ctx->active_timers.occupied_levels &= ~((app_timer_running_count_t) 1u << level);
+            }
+
+            while (NULL != curr)
+            {
+                app_timer_t *next = curr->next;
+                _wheel_link(ctx, curr);
+                curr = next;
+            }
+        }
+    }
+
+    _active_set_remove(ctx, timer);
+}
+
+
+/**
+ * Returns the active timer that will expire next, or NULL if there are no active timers
+ */
+static app_timer_t *_active_set_next(app_timer_ctx_t *ctx)
+{
+    if ((NULL == ctx->active_timers.next) && (0u != ctx->active_timers.occupied_levels))
+    {
+        /* Earliest timers are always in the lowest occupied level, in the first occupied slot
+         * from the slot that 'now' is in. Only the top level can have occupied slots before
+         * the slot that 'now' is in, which happens when expiry times wrap around past the
+         * end of app_timer_running_count_t, and those slots expire after all the others. */
+        uint8_t level = _lowest_set_bit(ctx->active_timers.occupied_levels);
+        uint32_t occupied = ctx->active_timers.occupied_slots[level];
+        uint8_t now_slot = (uint8_t) ((ctx->active_timers.now >> (level * APP_TIMER_WHEEL_SLOT_BITS)) & WHEEL_SLOT_MASK);
+        uint32_t later = occupied & ~((1u << now_slot) - 1u);
+        uint8_t slot = _lowest_set_bit((0u == later) ? occupied : later);
+        app_timer_t *curr = ctx->active_timers.slots[level][slot].head;
+
+        ctx->active_timers.next = curr;
+
+        if (0u < level)
+        {
+            // Timers in higher levels may have different expiry times, need to find the earliest one
+            while (NULL != curr)
+            {
+                if (_wheel_ticks_until_expiry(ctx, curr) < _wheel_ticks_until_expiry(ctx, ctx->active_timers.next))
+                {
+                    ctx->active_timers.next = curr;
+                }
+
+                curr = curr->next;
+            }
+        }
+    }
+
+    return ctx->active_timers.next;
+}
+
+
+/**
+ * Removes all timers from the timing wheel, and marks them as stopped. Only the occupied
+ * slots are visited.
+ *
+ * @param ctx  Pointer to timer context
+ */
+static void _active_set_clear(app_timer_ctx_t *ctx)
+{
+    while (0u != ctx->active_timers.occupied_levels)
+    {
+        uint8_t level = _lowest_set_bit(ctx->active_timers.occupied_levels);
+
+        while (0u != ctx->active_timers.occupied_slots[level])
+        {
+            uint8_t slot = _lowest_set_bit(ctx->active_timers.occupied_slots[level]);
+            volatile _app_timer_list_t *list = &ctx->active_timers.slots[level][slot];
+
+            _stop_timer_list(list);
+            list->head = NULL;
+            list->tail = NULL;
+            ctx->active_timers.occupied_slots[level] &= ~(1u << slot);
+        }
+
+        ctx->active_timers.occupied_levels &= ~((app_timer_running_count_t) 1u << level);
+    }
+
+    ctx->active_timers.next = NULL;
+}
+
+#elif defined(APP_TIMER_ACTIVE_SET_HEAP)
+
+/**
+ * Stores a timer at a specific position in the heap array
+ *
+ * @param ctx    Pointer to timer context
+ * @param timer  Pointer to timer instance
+ * @param index  Position in heap array
+ */
+static inline void _heap_place(app_timer_ctx_t *ctx, app_timer_t *timer, uint32_t index)
+{
+    ctx->active_timers.timers[index] = timer;
+    timer->heap_index = index;
+}
+
+
+/**
+ * Moves a timer towards the top of the heap until its parent expires no later than it does
+ *
+ * @param ctx    Pointer to timer context
+ * @param index  Position of timer in heap array
+ */
+static void _heap_sift_up(app_timer_ctx_t *ctx, uint32_t index)
+{
+    app_timer_t *timer = ctx->active_timers.timers[index];
+    app_timer_running_count_t expiry = _timer_expiry(timer);
+
+    while (0u < index)
+    {
+        uint32_t parent = (index - 1u) / 2u;
+
+        if (!_counts_before(expiry, _timer_expiry(ctx->active_timers.timers[parent])))
+        {
+            break;
+        }
+
+        _heap_place(ctx, ctx->active_timers.timers[parent], index);
+        index = parent;
+    }
+
+    _heap_place(ctx, timer, index);
+}
+
+
+/**
+ * Moves a timer towards the bottom of the heap until neither of its children expire before it does
+ *
+ * @param ctx    Pointer to timer context
+ * @param index  Position of timer in heap array
+ */
+static void _heap_sift_down(app_timer_ctx_t *ctx, uint32_t index)
+{
+    app_timer_t *timer = ctx->active_timers.timers[index];
+    app_timer_running_count_t expiry = _timer_expiry(timer);
+
+    while (1)
+    {
+        uint32_t child = (index * 2u) + 1u;
+
+        if (child >= ctx->active_timers.count)
+        {
+            break;
+        }
+
+        // Pick whichever child expires first
+        if (((child + 1u) < ctx->active_timers.count) &&
+            _counts_before(_timer_expiry(ctx->active_timers.timers[child + 1u]), _timer_expiry(ctx->active_timers.timers[child])))
+        {
+            child += 1u;
+        }
+
+        if (!_counts_before(_timer_expiry(ctx->active_timers.timers[child]), expiry))
+        {
+            break;
+        }
+
+        _heap_place(ctx, ctx->active_timers.timers[child], index);
+        index = child;
+    }
+
+    _heap_place(ctx, timer, index);
+}
+
+
+/**
+ * Inserts a new timer into the heap of active timers
+ *
+ * @param ctx   Pointer to timer context
+ * @param timer Pointer to timer instance to insert
+ * @param now   Current timestamp in timer counts (unused; the heap is keyed on expiry time)
+ *
+ * @return True if successful, false if the heap is full
+ */
+static bool _active_set_insert(app_timer_ctx_t *ctx, app_timer_t *timer, app_timer_running_count_t now)
+{
+    (void) now;
+
+    if (APP_TIMER_HEAP_CAPACITY <= ctx->active_timers.count)
+    {
+        return false;
+    }
+
+    ctx->active_timers.timers[ctx->active_timers.count] = timer;
+    ctx->active_timers.count += 1u;
+    _heap_sift_up(ctx, ctx->active_timers.count - 1u);
+
+    return true;
+}
+
+
+/**
+ * Removes a timer from the heap of active timers
+ *
+ * @param ctx    Pointer to timer context
+ * @param timer  Pointer to timer instance to remove
+ */
+static void _active_set_remove(app_timer_ctx_t *ctx, app_timer_t *timer)
+{
+    uint32_t index = timer->heap_index;
+
+    if ((index >= ctx->active_timers.count) || (ctx->active_timers.timers[index] != timer))
+    {
+        // Timer is not in the heap
+        return;
+    }
+
+    ctx->active_timers.count -= 1u;
+
+    if (index < ctx->active_timers.count)
+    {
+        // Move the last timer into the vacated position, and restore heap order
+        app_timer_t *moved = ctx->active_timers.timers[ctx->active_timers.count];
+        _heap_place(ctx, moved, index);
+        _heap_sift_down(ctx, index);
+        _heap_sift_up(ctx, moved->heap_index);
+    }
+
+    ctx->active_timers.timers[ctx->active_timers.count] = NULL;
+}
+
+
+/**
+ * Removes the next timer to expire from the heap of active timers, because it has expired
+ *
+ * @param ctx    Pointer to timer context
+ * @param timer  Pointer to timer instance to remove (must be at the top of the heap)
+ */
+static inline void _active_set_expire(app_timer_ctx_t *ctx, app_timer_t *timer)
+{
+    _active_set_remove(ctx, timer);
+}
+
+
+/**
+ * Returns the active timer that will expire next, or NULL if there are no active timers
+ */
+static inline app_timer_t *_active_set_next(app_timer_ctx_t *ctx)
+{
+    return (0u == ctx->active_timers.count) ? NULL : ctx->active_timers.timers[0];
+}
+
+
+/**
+ * Removes all timers from the heap of active timers, and marks them as stopped
+ *
+ * @param ctx  Pointer to timer context
+ */
+static void _active_set_clear(app_timer_ctx_t *ctx)
+{
+    for (uint32_t i = 0u; i < ctx->active_timers.count; i++)
+    {
+        ctx->active_timers.timers[i]->flags &= ~FLAGS_STATE_MASK;
+        ctx->active_timers.timers[i] = NULL;
+    }
+
+    ctx->active_timers.count = 0u;
+}
+
+#elif defined(APP_TIMER_ACTIVE_SET_PERIOD_FIFO)
+
+/**
+ * Bit mask and bit position for the index of the FIFO holding an active timer
+ */
+#define FLAGS_FIFO_MASK (0xF0u)
+#define FLAGS_FIFO_POS  (0x4u)
+
+/**
+ * Index of the FIFO used for timers whose period does not match any other FIFO
+ */
+#define OVERFLOW_FIFO_INDEX (APP_TIMER_PERIOD_FIFO_COUNT)
+
+
+/**
+ * Finds the FIFO that a timer should be inserted into; the FIFO already holding timers with
+ * the same period, or an unused FIFO, or the overflow FIFO if all other FIFOs are in use.
+ *
+ * @param ctx     Pointer to timer context
+ * @param period  Period of timer to insert, in timer counts
+ *
+ * @return Index of FIFO to insert timer into
+ */
+static uint8_t _fifo_find(app_timer_ctx_t *ctx, app_timer_running_count_t period)
+{
+    uint8_t unused = OVERFLOW_FIFO_INDEX;
+
+    for (uint8_t i = 0u; i < APP_TIMER_PERIOD_FIFO_COUNT; i++)
+    {
+        volatile _app_timer_period_fifo_t *fifo = &ctx->active_timers.fifos[i];
+
+        if (NULL == fifo->timers.head)
+        {
+            if (OVERFLOW_FIFO_INDEX == unused)
+            {
+                unused = i;
+            }
+        }
+        else if (fifo->period == period)
+        {
+            return i;
+        }
+    }
+
+    return unused;
+}
+
+
+/**
+ * Removes a non-empty FIFO from the index
+ *
+ * @param ctx   Pointer to timer context
+ * @param fifo  Pointer to FIFO to unlink
+ */
+static void _fifo_unlink(app_timer_ctx_t *ctx, _app_timer_period_fifo_t *fifo)
+{
+    if (ctx->active_timers.head == fifo)
+    {
+        ctx->active_timers.head = fifo->next;
+    }
+
+    if (NULL != fifo->next)
+    {
+        fifo->next->previous = fifo->previous;
+    }
+
+    if (NULL != fifo->previous)
+    {
+        fifo->previous->next = fifo->next;
+    }
+
+    fifo->next = NULL;
+    fifo->previous = NULL;
+}
+
+
+/**
+ * Inserts a non-empty FIFO into the index, ensuring that the order of the index is
+ * maintained (the FIFO whose head timer expires next must always be the head of the index)
+ *
+ * @param ctx   Pointer to timer context
+ * @param fifo  Pointer to FIFO to link
+ */
+static void _fifo_link(app_timer_ctx_t *ctx, _app_timer_period_fifo_t *fifo)
+{
+    app_timer_running_count_t expiry = _timer_expiry(fifo->timers.head);
+    _app_timer_period_fifo_t *previous = NULL;
+    _app_timer_period_fifo_t *curr = ctx->active_timers.head;
+
+    // Find the first FIFO whose head timer expires later than the head timer of the new FIFO
+    while ((NULL != curr) && !_counts_before(expiry, _timer_expiry(curr->timers.head)))
+    {
+        previous = curr;
+        curr = curr->next;
+    }
+
+    fifo->previous = previous;
+    fifo->next = curr;
+
+    if (NULL != curr)
+    {
+        curr->previous = fifo;
+    }
+
+    if (NULL == previous)
+    {
+        ctx->active_timers.head = fifo;
+    }
+    else
+    {
+        previous->next = fifo;
+    }
+}
+
+
+/**
+ * Inserts a new timer into the FIFO for its period
+ *
+ * @param ctx   Pointer to timer context
+ * @param timer Pointer to timer instance to insert
+ * @param now   Current timestamp in timer counts (unused; FIFOs are ordered by expiry time)
+ *
+ * @return Always true (the overflow FIFO has no limit on the number of timers)
+ */
+static bool _active_set_insert(app_timer_ctx_t *ctx, app_timer_t *timer, app_timer_running_count_t now)
+{
+    (void) now;
+
+    uint8_t index = _fifo_find(ctx, timer->total_counts);
+    _app_timer_period_fifo_t *fifo = (_app_timer_period_fifo_t *) &ctx->active_timers.fifos[index];
+    app_timer_running_count_t expiry = _timer_expiry(timer);
+
+    fifo->period = timer->total_counts;
+    timer->flags &= ~FLAGS_FIFO_MASK;
+    timer->flags |= (uint8_t) ((index << FLAGS_FIFO_POS) & FLAGS_FIFO_MASK);
+
+    /* Walk backwards from the tail to find the last timer that expires no later than the new
+     * timer. For a per-period FIFO this is almost always the tail itself; a repeating timer
+     * re-inserted after a late expiry can expire slightly before timers of the same period that
+     * were started in the meantime, and the overflow FIFO can hold timers of any period. */
+    app_timer_t *curr = fifo->timers.tail;
+
+    while ((NULL != curr) && _counts_before(expiry, _timer_expiry(curr)))
+    {
+        curr = curr->previous;
+    }
+
+    if (NULL == curr)
+    {
+        // New timer becomes the head of the FIFO
+        timer->previous = NULL;
+        timer->next = fifo->timers.head;
+
+        if (NULL == fifo->timers.head)
+        {
+            fifo->timers.tail = timer;
+        }
+        else
+        {
+            fifo->timers.head->previous = timer;
+            _fifo_unlink(ctx, fifo);
+        }
+
+        fifo->timers.head = timer;
+
+        // Head timer of this FIFO changed, so re-position the FIFO in the index
+        _fifo_link(ctx, fifo);
+    }
+    else
+    {
+        // Insert new timer after curr
+        timer->previous = curr;
+        timer->next = curr->next;
+
+        if (NULL == curr->next)
+        {
+            fifo->timers.tail = timer;
+        }
+        else
+        {
+            curr->next->previous = timer;
+        }
+
+        curr->next = timer;
+    }
+
+    return true;
+}
+
+
+/**
+ * Removes a timer from the FIFO holding it
+ *
+ * @param ctx    Pointer to timer context
+ * @param timer  Pointer to timer instance to remove
+ */
+static void _active_set_remove(app_timer_ctx_t *ctx, app_timer_t *timer)
+{
+    uint8_t index = (uint8_t) ((timer->flags & FLAGS_FIFO_MASK) >> FLAGS_FIFO_POS);
+    _app_timer_period_fifo_t *fifo = (_app_timer_period_fifo_t *) &ctx->active_timers.fifos[index];
+
+    if (fifo->timers.head != timer)
+    {
+        _remove_timer_from_list(&fifo->timers, timer);
+        return;
+    }
+
+    // Removing the head timer of this FIFO, so re-position the FIFO in the index
+    _fifo_unlink(ctx, fifo);
+    _remove_timer_from_list(&fifo->timers, timer);
+
+    if (NULL != fifo->timers.head)
+    {
+        _fifo_link(ctx, fifo);
+    }
+}
+
+
+/**
+ * Removes the next timer to expire from the FIFO holding it, because it has expired
+ *
+ * @param ctx    Pointer to timer context
+ * @param timer  Pointer to timer instance to remove (must be the head of the first FIFO)
+ */
+static inline void _active_set_expire(app_timer_ctx_t *ctx, app_timer_t *timer)
+{
+    _active_set_remove(ctx, timer);
+}
+
+
+/**
+ * Returns the active timer that will expire next, or NULL if there are no active timers
+ */
+static inline app_timer_t *_active_set_next(app_timer_ctx_t *ctx)
+{
+    return (NULL == ctx->active_timers.head) ? NULL : ctx->active_timers.head->timers.head;
+}
+
+
+/**
+ * Removes all timers from the FIFOs, and marks them as stopped. Only the FIFOs in the
+ * index (the non-empty ones) are visited.
+ *
+ * @param ctx  Pointer to timer context
+ */
+static void _active_set_clear(app_timer_ctx_t *ctx)
+{
+    _app_timer_period_fifo_t *fifo = ctx->active_timers.head;
+
+    while (NULL != fifo)
+    {
+        _app_timer_period_fifo_t *next = fifo->next;
+
+        _stop_timer_list(&fifo->timers);
+        fifo->timers.head = NULL;
+        fifo->timers.tail = NULL;
+        fifo->next = NULL;
+        fifo->previous = NULL;
+        fifo = next;
+    }
+
+    ctx->active_timers.head = NULL;
+}
+
+#elif defined(APP_TIMER_ACTIVE_SET_DELTA_LIST)
+
+/**
+ * Inserts a new timer into the delta list of active timers
+ *
+ * @param ctx   Pointer to timer context
+ * @param timer Pointer to timer instance to insert
+ * @param now   Current timestamp in timer counts (unused; deltas are relative to the head timer)
+ *
+ * @return Always true (there is no limit on the length of the list)
+ */
+static bool _active_set_insert(app_timer_ctx_t *ctx, app_timer_t *timer, app_timer_running_count_t now)
+{
+    (void) now;
+
+    app_timer_running_count_t expiry = _timer_expiry(timer);
+    app_timer_t *head = ctx->active_timers.timers.head;
+
+    if ((NULL == head) || _counts_before(expiry, ctx->active_timers.head_expiry))
+    {
+        // New timer becomes the head of the list
+        if (NULL == head)
+        {
+            ctx->active_timers.timers.tail = timer;
+        }
+        else
+        {
+            head->delta_counts = ctx->active_timers.head_expiry - expiry;
+            head->previous = timer;
+        }
+
+        timer->delta_counts = 0u;
+        timer->previous = NULL;
+        timer->next = head;
+        ctx->active_timers.timers.head = timer;
+        ctx->active_timers.head_expiry = expiry;
+        return true;
+    }
+
+    /* Walk the list, consuming deltas, until the next timer expires later than the new
+     * timer. What remains is the delta between curr and the new timer. */
+    app_timer_running_count_t remaining = expiry - ctx->active_timers.head_expiry;
+    app_timer_t *curr = head;
+
+    while ((NULL != curr->next) && (curr->next->delta_counts <= remaining))
+    {
+        remaining -= curr->next->delta_counts;
+        curr = curr->next;
+    }
+
+    // Insert new timer after curr
+    timer->delta_counts = remaining;
+    timer->previous = curr;
+    timer->next = curr->next;
+
+    if (NULL == curr->next)
+    {
+        ctx->active_timers.timers.tail = timer;
+    }
+    else
+    {
+        // Timer after the new one is now relative to the new one
+        curr->next->delta_counts -= remaining;
+        curr->next->previous = timer;
+    }
+
+    curr->next = timer;
+
+    return true;
+}
+
+
+/**
+ * Removes a timer from the delta list of active timers
+ *
+ * @param ctx    Pointer to timer context
+ * @param timer  Pointer to timer instance to remove
+ */
+static void _active_set_remove(app_timer_ctx_t *ctx, app_timer_t *timer)
+{
+    if (NULL != timer->next)
+    {
+        if (ctx->active_timers.timers.head == timer)
+        {
+            // Next timer becomes the head, so its expiry becomes the absolute one
+            ctx->active_timers.head_expiry += timer->next->delta_counts;
+            timer->next->delta_counts = 0u;
+        }
+        else
+        {
+            // Next timer is now relative to the timer before the removed one
+            timer->next->delta_counts += timer->delta_counts;
+        }
+    }
+
+    _remove_timer_from_list(&ctx->active_timers.timers, timer);
+}
+
+
+/**
+ * Removes the next timer to expire from the delta list of active timers, because it has expired
+ *
+ * @param ctx    Pointer to timer context
+ * @param timer  Pointer to timer instance to remove (must be the head of the list)
+ */
+static inline void _active_set_expire(app_timer_ctx_t *ctx, app_timer_t *timer)
+{
+    _active_set_remove(ctx, timer);
+}
+
+
+/**
+ * Returns the active timer that will expire next, or NULL if there are no active timers
+ */
+static inline app_timer_t *_active_set_next(app_timer_ctx_t *ctx)
+{
+    return ctx->active_timers.timers.head;
+}
+
+
+/**
+ * Removes all timers from the delta list of active timers, and marks them as stopped
+ *
+ * @param ctx  Pointer to timer context
+ */
+static void _active_set_clear(app_timer_ctx_t *ctx)
+{
+    _stop_timer_list(&ctx->active_timers.timers);
+    ctx->active_timers.timers.head = NULL;
+    ctx->active_timers.timers.tail = NULL;
+}
+
+#else
+#error "Active timer set data structure is not defined"
+#endif // APP_TIMER_ACTIVE_SET_*
+
+
+/**
+ * Inserts a new timer into the set of active timers, ensuring that the next timer
+ * to expire can always be found.
+ *
+ * @note The #start_counts and #total_counts fields of the timer must be set before calling
+ *       this function. #start_counts should be set to the timestamp in counts when the timer
+ *       was added via #app_timer_start, and #total_counts should be set to the timer period
+ *       in counts. If APP_TIMER_ABSOLUTE_DEADLINE is defined, #expiry_counts should be set
+ *       to the timestamp in counts when the timer will expire, instead of #start_counts.
+ *
+ * @param ctx   Pointer to timer context
+ * @param timer Pointer to timer instance to insert
+ * @param now   Current timestamp in timer counts
+ *
+ * @return True if successful, false if there is no space for another active timer
+ */
+static bool _insert_active_timer(app_timer_ctx_t *ctx, app_timer_t *timer, app_timer_running_count_t now)
+{
+    if (!_active_set_insert(ctx, timer, now))
+    {
+        return false;
+    }
+
+    // Set timer state to active
+    timer->flags &= ~FLAGS_STATE_MASK;
+    timer->flags |= (TIMER_STATE_ACTIVE << FLAGS_STATE_POS);
+
+#ifdef APP_TIMER_TOUCH_ENABLE
+    // Timer has been positioned at its real expiry time
+    timer->deadline_counts = _timer_expiry(timer);
+#endif // APP_TIMER_TOUCH_ENABLE
+
+#ifdef APP_TIMER_STATS_ENABLE
+    ctx->stats.num_timers += 1u;
+
+    if (ctx->stats.num_timers_high_watermark < ctx->stats.num_timers)
+    {
+        ctx->stats.num_timers_high_watermark = ctx->stats.num_timers;
+    }
+#endif // APP_TIMER_STATS_ENABLE
+
+    return true;
+}
+
+
+/**
+ * Helper function to configure the hardware timer/counter to expire after a certain
+ * number of counts.
+ *
+ * @param ctx            Pointer to timer context
+ * @param total_counts   Total timer/counter counts until expiry (if this value is larger
+ *                       than hw_model->max_count, then the timer/counter will be configured
+ *                       for hw_model->max_count instead)
+ */
+static void _configure_timer(app_timer_ctx_t *ctx, app_timer_running_count_t total_counts)
+{
+    app_timer_count_t counts_from_now = (total_counts > ((app_timer_running_count_t) ctx->hw_model->max_count)) ?
+                                       ctx->hw_model->max_count :
+                                       (app_timer_count_t) total_counts;
+
+    ctx->hw_model->set_timer_period_counts(counts_from_now);
+    ctx->last_timer_period = counts_from_now;
+}
+
+
+/**
+ * Returns the total number of ticks elapsed since the first of the currently active
+ * app_timer instances were started (Should return 0 when no app_timer instances are running)
+ */
+static inline app_timer_running_count_t _total_timer_counts(app_timer_ctx_t *ctx)
+{
+    app_timer_count_t ticks_elapsed = ctx->hw_model->read_timer_counts() - ctx->counts_after_last_start;
+    return ctx->running_timer_count + ((app_timer_running_count_t) ticks_elapsed);
+}
+
+
+#ifdef APP_TIMER_DEFERRED_DISPATCH
+/**
+ * Checks whether the dispatch ring is full. Must only be called from
+ * app_timer_target_count_reached.
+ *
+ * @param ctx  Pointer to timer context
+ *
+ * @return True if the ring is full
+ */
+static bool _dispatch_ring_full(app_timer_ctx_t *ctx)
+{
+    uint32_t head = atomic_load_explicit(&ctx->dispatch_ring.head, memory_order_relaxed);
+
+    // Consumer must be done reading an entry before it is released to be overwritten
+    return (head - atomic_load_explicit(&ctx->dispatch_ring.tail, memory_order_acquire)) >= APP_TIMER_DISPATCH_RING_SIZE;
+}
+
+
+/**
+ * Pushes an expired timer onto the dispatch ring. Must only be called from
+ * app_timer_target_count_reached, after _dispatch_ring_full has returned false.
+ *
+ * @param ctx    Pointer to timer context
+ * @param timer  Pointer to expired timer instance
+ */
+static void _dispatch_ring_push(app_timer_ctx_t *ctx, app_timer_t *timer)
+{
+    uint32_t head = atomic_load_explicit(&ctx->dispatch_ring.head, memory_order_relaxed);
+
+    // Entry must be written before the new head is visible to the consumer
+    ctx->dispatch_ring.timers[head & (APP_TIMER_DISPATCH_RING_SIZE - 1u)] = timer;
+    atomic_store_explicit(&ctx->dispatch_ring.head, head + 1u, memory_order_release);
+}
+#endif // APP_TIMER_DEFERRED_DISPATCH
+
+
+#ifdef APP_TIMER_LATENESS_STATS_ENABLE
+/**
+ * Records how many timer counts after its expiry time an expired timer is being handled, in
+ * the lateness histogram. Must only be called from app_timer_target_count_reached.
+ *
+ * @param ctx    Pointer to timer context
+ * @param timer  Pointer to expired timer instance
+ */
+static void _record_lateness(app_timer_ctx_t *ctx, app_timer_t *timer)
+{
+    app_timer_running_count_t lateness = _total_timer_counts(ctx) - _timer_expiry(timer);
+
+    // Bucket index is the number of significant bits in the lateness value
+    uint32_t bucket = 0u;
+    for (app_timer_running_count_t rem = lateness;
+         (0u != rem) && (bucket < (APP_TIMER_LATENESS_HISTOGRAM_BUCKETS - 1u));
+         rem >>= 1u)
+    {
+        bucket += 1u;
+    }
+
+    ctx->stats.lateness_histogram[bucket] += 1u;
+    ctx->stats.num_lateness_samples += 1u;
+    ctx->stats.lateness_total += (uint64_t) lateness;
+
+    if (ctx->stats.lateness_max < lateness)
+    {
+        ctx->stats.lateness_max = lateness;
+    }
+}
+#endif // APP_TIMER_LATENESS_STATS_ENABLE
+
+
+#ifdef APP_TIMER_DURATION_STATS_ENABLE
+/**
+ * Returns the number of timer counts between two hw_model->read_timer_counts values, read in
+ * that order while the counter was running with the same period (ctx->last_timer_period).
+ * The counter may have wrapped around once in between; if it wrapped around more than once,
+ * then the real duration can't be known, and a shorter duration is returned.
+ *
+ * @param ctx           Pointer to timer context
+ * @param start_counts  Counter value at the start of the duration
+ * @param end_counts    Counter value at the end of the duration
+ *
+ * @return Duration in timer counts
+ */
+static uint64_t _duration_counts(app_timer_ctx_t *ctx, app_timer_count_t start_counts, app_timer_count_t end_counts)
+{
+#ifdef APP_TIMER_FREERUNNING_COUNTER
+    // Counter keeps counting past the end of its period, and wraps around at the width of app_timer_count_t
+    (void) ctx;
+    return (uint64_t) ((app_timer_count_t) (end_counts - start_counts));
+#else
+    if (end_counts < start_counts)
+    {
+        // Counter was reset at the end of its period
+        return ((uint64_t) end_counts + (uint64_t) ctx->last_timer_period) - (uint64_t) start_counts;
+    }
+
+    return (uint64_t) (end_counts - start_counts);
+#endif // APP_TIMER_FREERUNNING_COUNTER
+}
+
+
+/**
+ * Adds a measured duration to a set of duration stats. Durations can only be measured up to
+ * hw_model->max_count, since that is the longest the counter can run for without wrapping
+ * around, so longer durations are recorded as max_count, and counted in #num_duration_overruns.
+ *
+ * @param ctx       Pointer to timer context
+ * @param duration  Pointer to duration stats to update
+ * @param counts    Measured duration, in timer counts
+ *
+ * @return True if this is the longest duration measured so far
+ */
+static bool _record_duration(app_timer_ctx_t *ctx, app_timer_duration_t *duration, uint64_t counts)
+{
+    if (counts >= (uint64_t) ctx->hw_model->max_count)
+    {
+        counts = (uint64_t) ctx->hw_model->max_count;
+        ctx->stats.num_duration_overruns += 1u;
+    }
+
+    duration->count += 1u;
+    duration->total += counts;
+
+    if ((1u == duration->count) || (duration->max < counts))
+    {
+        duration->max = (app_timer_running_count_t) counts;
+        return true;
+    }
+
+    return false;
+}
+#endif // APP_TIMER_DURATION_STATS_ENABLE
+
+
+#if defined(APP_TIMER_MAX_EXPIRIES_PER_INTERRUPT) || defined(APP_TIMER_MAX_COUNTS_PER_INTERRUPT)
+
+#if defined(APP_TIMER_MAX_EXPIRIES_PER_INTERRUPT) && (APP_TIMER_MAX_EXPIRIES_PER_INTERRUPT < 1)
+#error "APP_TIMER_MAX_EXPIRIES_PER_INTERRUPT must be at least 1"
+#endif // APP_TIMER_MAX_EXPIRIES_PER_INTERRUPT
+
+#if defined(APP_TIMER_MAX_COUNTS_PER_INTERRUPT) && (APP_TIMER_MAX_COUNTS_PER_INTERRUPT < 1)
+#error "APP_TIMER_MAX_COUNTS_PER_INTERRUPT must be at least 1"
+#endif // APP_TIMER_MAX_COUNTS_PER_INTERRUPT
+
+/**
+ * Checks whether app_timer_target_count_reached has used up its budget for handling expired
+ * timers in a single call. Must only be called from app_timer_target_count_reached.
+ *
+ * @param ctx          Pointer to timer context
+ * @param num_handled  Number of expired timers handled so far in this call
+ *
+ * @return True if no more expired timers should be handled in this call
+ */
+static bool _interrupt_budget_exhausted(app_timer_ctx_t *ctx, uint32_t num_handled)
+{
+#ifdef APP_TIMER_MAX_EXPIRIES_PER_INTERRUPT
+    if (num_handled >= (uint32_t) APP_TIMER_MAX_EXPIRIES_PER_INTERRUPT)
+    {
+        return true;
+    }
+#else
+    (void) num_handled;
+#endif // APP_TIMER_MAX_EXPIRIES_PER_INTERRUPT
+
+#ifdef APP_TIMER_MAX_COUNTS_PER_INTERRUPT
+    // Counter was re-started at the beginning of app_timer_target_count_reached
+    app_timer_count_t counts_elapsed = ctx->hw_model->read_timer_counts() - ctx->counts_after_last_start;
+    if (counts_elapsed >= (app_timer_count_t) APP_TIMER_MAX_COUNTS_PER_INTERRUPT)
+    {
+        return true;
+    }
+#else
+    (void) ctx;
+#endif // APP_TIMER_MAX_COUNTS_PER_INTERRUPT
+
+    return false;
+}
+#endif // APP_TIMER_MAX_EXPIRIES_PER_INTERRUPT || APP_TIMER_MAX_COUNTS_PER_INTERRUPT
+
+
+/**
+ * @see app_timer_api.h
+ */
+void app_timer_ctx_target_count_reached(app_timer_ctx_t *ctx)
+{
+    /* Set flag indicating we are in the function handling an elapsed count, so
+     * that any calls to app_timer_start inside handlers will know not to configure
+     * the timer, since we will do that at the end of this function. This does not
+     * need to be protected from interrupts. */
+    ctx->inside_target_count_reached = true;
+
+    // Disable interrupts to update ctx->running_timer_count and pop expired timers off the list
+    app_timer_int_status_t int_status = 0u;
+    ctx->hw_model->set_interrupts_enabled(false, &int_status);
+
+#ifdef APP_TIMER_DURATION_STATS_ENABLE
+    // Start timing as soon as interrupts are disabled, the counter is still running the expired period
+    app_timer_count_t entry_counts = ctx->hw_model->read_timer_counts();
+#endif // APP_TIMER_DURATION_STATS_ENABLE
+
+    // The tick on which the head active timer should have expired
+    app_timer_running_count_t expiry_count = ctx->running_timer_count + ctx->last_timer_period;
+
+    // Update ctx->running_timer_count with ticks elapsed since last update
+#ifdef APP_TIMER_FREERUNNING_COUNTER
+    ctx->running_timer_count += (ctx->hw_model->read_timer_counts() - ctx->counts_after_last_start);
+#else
+    ctx->running_timer_count += (app_timer_running_count_t) ctx->last_timer_period;
+#endif // APP_TIMER_FREERUNNING_COUNTER
+
+#ifdef APP_TIMER_DURATION_STATS_ENABLE
+    // Time until the counter is stopped, it may have wrapped around at the end of the expired period
+    uint64_t prologue_counts = _duration_counts(ctx, entry_counts, ctx->hw_model->read_timer_counts());
+#endif // APP_TIMER_DURATION_STATS_ENABLE
+
+    // Stop the timer counter, re-start it to time how long it takes to handle all expired timers
+#ifndef APP_TIMER_RECONFIG_WITHOUT_STOPPING
+    ctx->hw_model->set_timer_running(false);
+#endif // APP_TIMER_RECONFIG_WITHOUT_STOPPING
+    _configure_timer(ctx, ctx->hw_model->max_count);
+#ifndef APP_TIMER_RECONFIG_WITHOUT_STOPPING
+    ctx->hw_model->set_timer_running(true);
+#endif // APP_TIMER_RECONFIG_WITHOUT_STOPPING
+    ctx->counts_after_last_start = ctx->hw_model->read_timer_counts();
+
+    // Remove all expired timers from the active set, and run their handlers
+    app_timer_t *curr = _active_set_next(ctx);
+
+#if defined(APP_TIMER_SLACK_ENABLE) && defined(APP_TIMER_STATS_ENABLE)
+    // Set once the first timer has expired in this call
+    bool expired_any = false;
+#endif // APP_TIMER_SLACK_ENABLE && APP_TIMER_STATS_ENABLE
+
+#if defined(APP_TIMER_MAX_EXPIRIES_PER_INTERRUPT) || defined(APP_TIMER_MAX_COUNTS_PER_INTERRUPT)
+    // Number of expired timers handled so far, and whether we stopped early to bound the time spent here
+    uint32_t num_handled = 0u;
+#ifdef APP_TIMER_STATS_ENABLE
+    bool budget_exhausted = false;
+#endif // APP_TIMER_STATS_ENABLE
+#endif // APP_TIMER_MAX_EXPIRIES_PER_INTERRUPT || APP_TIMER_MAX_COUNTS_PER_INTERRUPT
+
+#if defined(APP_TIMER_DEFERRED_DISPATCH) && defined(APP_TIMER_STATS_ENABLE)
+    // Set if we stopped early because the dispatch ring is full
+    bool dispatch_ring_full = false;
+#endif // APP_TIMER_DEFERRED_DISPATCH && APP_TIMER_STATS_ENABLE
+
+#ifdef APP_TIMER_DURATION_STATS_ENABLE
+    /* Time spent in this call is measured in segments between counter reads, before, during
+     * and after each handler, so that a handler which makes the counter wrap around only cuts
+     * off the measurement of its own segment */
+    app_timer_count_t segment_start_counts = ctx->counts_after_last_start;
+    uint64_t critical_counts = prologue_counts;
+    uint64_t handler_total_counts = 0u;
+#endif // APP_TIMER_DURATION_STATS_ENABLE
+
+    while ((NULL != curr) && (_ticks_until_expiry(expiry_count, curr) == 0u))
+    {
+#if defined(APP_TIMER_MAX_EXPIRIES_PER_INTERRUPT) || defined(APP_TIMER_MAX_COUNTS_PER_INTERRUPT)
+        /* Always handle at least one timer, so that we make progress. Any remaining expired
+         * timers are left in the active set, and will be handled in the next call */
+        if ((num_handled > 0u) && _interrupt_budget_exhausted(ctx, num_handled))
+        {
+#ifdef APP_TIMER_STATS_ENABLE
+            budget_exhausted = true;
+#endif // APP_TIMER_STATS_ENABLE
+            break;
+        }
+
+        num_handled += 1u;
+#endif // APP_TIMER_MAX_EXPIRIES_PER_INTERRUPT || APP_TIMER_MAX_COUNTS_PER_INTERRUPT
+
+#ifdef APP_TIMER_DEFERRED_DISPATCH
+        /* Handlers are never run here. If there is no space to queue the handler, then this
+         * timer and any remaining expired timers are left in the active set, and will be
+         * handled in the next call, hopefully after app_timer_dispatch_pending has made space */
+        if ((NULL != curr->handler) && _dispatch_ring_full(ctx))
+        {
+#ifdef APP_TIMER_STATS_ENABLE
+            ctx->stats.num_dispatch_overflows += 1u;
+            dispatch_ring_full = true;
+#endif // APP_TIMER_STATS_ENABLE
+            break;
+        }
+#endif // APP_TIMER_DEFERRED_DISPATCH
+
+        // Unlink timer from active set
+        _active_set_expire(ctx, curr);
+
+#ifdef APP_TIMER_STATS_ENABLE
+        ctx->stats.num_timers -= 1u;
+#endif // APP_TIMER_STATS_ENABLE
+
+#ifdef APP_TIMER_TOUCH_ENABLE
+        if (_counts_before(expiry_count, curr->deadline_counts))
+        {
+            /* Timer was extended by app_timer_touch, and the new expiry time has not been
+             * reached yet, so re-insert the timer at the new expiry time instead of running
+             * the handler (can't fail, since the timer was just removed) */
+            app_timer_running_count_t touch_count = curr->deadline_counts - curr->total_counts;
+#ifdef APP_TIMER_ABSOLUTE_DEADLINE
+            curr->expiry_counts = curr->deadline_counts;
+#else
+            curr->start_counts = touch_count;
+#endif // APP_TIMER_ABSOLUTE_DEADLINE
+            (void) _insert_active_timer(ctx, curr, touch_count);
+
+#ifdef APP_TIMER_STATS_ENABLE
+            ctx->stats.num_touch_reinserts += 1u;
+#endif // APP_TIMER_STATS_ENABLE
+
+            curr = _active_set_next(ctx);
+            continue;
+        }
+#endif // APP_TIMER_TOUCH_ENABLE
+
+        // Clear state bits, set timer state to expired
+        curr->flags &= ~FLAGS_STATE_MASK;
+        curr->flags |= (TIMER_STATE_EXPIRED << FLAGS_STATE_POS);
+
+#if defined(APP_TIMER_SLACK_ENABLE) && defined(APP_TIMER_STATS_ENABLE)
+        if (expired_any && (0u != curr->slack_counts))
+        {
+            // Timer with slack is sharing an interrupt with an earlier timer
+            ctx->stats.num_coalesced_expiries += 1u;
+        }
+
+        expired_any = true;
+#endif // APP_TIMER_SLACK_ENABLE && APP_TIMER_STATS_ENABLE
+
+#ifdef APP_TIMER_LATENESS_STATS_ENABLE
+        _record_lateness(ctx, curr);
+#endif // APP_TIMER_LATENESS_STATS_ENABLE
+
+#ifdef APP_TIMER_DEFERRED_DISPATCH
+        // Queue the handler to be run by app_timer_dispatch_pending (there is space, checked above)
+        if (NULL != curr->handler)
+        {
+            _dispatch_ring_push(ctx, curr);
+        }
+#else
+        // Run the handler
+        if (NULL != curr->handler)
+        {
+#ifdef APP_TIMER_ENABLE_INTERRUPTS_FOR_HANDLER
+            ctx->hw_model->set_interrupts_enabled(true, &int_status);
+#endif // APP_TIMER_ENABLE_INTERRUPTS_FOR_HANDLER
+
+#ifdef APP_TIMER_DURATION_STATS_ENABLE
+            /* The counter is not re-configured until the end of this call, so the handler
+             * duration is just the difference between two counter values */
+            app_timer_count_t handler_start_counts = ctx->hw_model->read_timer_counts();
+            critical_counts += _duration_counts(ctx, segment_start_counts, handler_start_counts);
+#endif // APP_TIMER_DURATION_STATS_ENABLE
+
+            curr->handler(curr->context);
+
+#ifdef APP_TIMER_DURATION_STATS_ENABLE
+            segment_start_counts = ctx->hw_model->read_timer_counts();
+            uint64_t handler_counts = _duration_counts(ctx, handler_start_counts, segment_start_counts);
+
+            if (_record_duration(ctx, &ctx->stats.handler_duration, handler_counts))
+            {
+                ctx->stats.slowest_handler_timer = curr;
+            }
+
+            handler_total_counts += handler_counts;
+#endif // APP_TIMER_DURATION_STATS_ENABLE
+
+#ifdef APP_TIMER_ENABLE_INTERRUPTS_FOR_HANDLER
+            ctx->hw_model->set_interrupts_enabled(false, &int_status);
+#endif // APP_TIMER_ENABLE_INTERRUPTS_FOR_HANDLER
+
+        }
+#endif // APP_TIMER_DEFERRED_DISPATCH
+
+        // Extract timer type from flags var
+        app_timer_type_e type = (app_timer_type_e) ((curr->flags & FLAGS_TYPE_MASK) >> FLAGS_TYPE_POS);
+
+        // Extract timer state from flags var
+        _timer_state_e state = (_timer_state_e) ((curr->flags & FLAGS_STATE_MASK) >> FLAGS_STATE_POS);
+
+        if ((APP_TIMER_TYPE_REPEATING == type) && (TIMER_STATE_EXPIRED == state))
+        {
+            /* Timer is repeating, and was not-restarted or stopped by the handler,
+             * so must be re-inserted with a new start time */
+            _set_start_timestamp(curr, expiry_count);
+
+            if (!_insert_active_timer(ctx, curr, _total_timer_counts(ctx)))
+            {
+                // No space to re-insert timer (handler must have started other timers), so it has to be stopped
+                curr->flags &= ~FLAGS_STATE_MASK;
+            }
+        }
+
+        curr = _active_set_next(ctx);
+    }
+
+#ifdef APP_TIMER_DURATION_STATS_ENABLE
+    // Counter value after handling expired timers, since the counter was re-started at the beginning of this call
+    app_timer_count_t end_counts = ctx->hw_model->read_timer_counts();
+    critical_counts += _duration_counts(ctx, segment_start_counts, end_counts);
+#endif // APP_TIMER_DURATION_STATS_ENABLE
+
+    if (NULL == curr)
+    {
+        // No more active timers, stop the counter
+#ifndef APP_TIMER_ABSOLUTE_DEADLINE
+        ctx->running_timer_count = 0u;
+#endif // APP_TIMER_ABSOLUTE_DEADLINE
+        ctx->hw_model->set_timer_running(false);
+    }
+    else
+    {
+        // Update running timer count with time taken to run expired handlers
+#ifdef APP_TIMER_DURATION_STATS_ENABLE
+        ctx->running_timer_count += (app_timer_count_t) (end_counts - ctx->counts_after_last_start);
+#else
+        ctx->running_timer_count += (ctx->hw_model->read_timer_counts() - ctx->counts_after_last_start);
+#endif // APP_TIMER_DURATION_STATS_ENABLE
+
+        // Configure timer for the next expiration and re-start
+        app_timer_running_count_t ticks_until_expiry = _ticks_until_expiry(ctx->running_timer_count, curr);
+
+        /* If the head timer should have already expired (it expired while we were handling
+         * other expired timers in the loop above, or we ran out of budget before handling it),
+         * just configure the hardware for 1 tick, and the head timer will be handled in the next
+         * call (although it does have the downside that the head timer will expire at least 1 tick late) */
+        bool expiry_overflow = (ticks_until_expiry == 0u);
+
+#ifndef APP_TIMER_RECONFIG_WITHOUT_STOPPING
+    ctx->hw_model->set_timer_running(false);
+#endif // APP_TIMER_RECONFIG_WITHOUT_STOPPING
+
+        _configure_timer(ctx, expiry_overflow ? 1u : ticks_until_expiry);
+#ifdef APP_TIMER_STATS_ENABLE
+#if defined(APP_TIMER_MAX_EXPIRIES_PER_INTERRUPT) || defined(APP_TIMER_MAX_COUNTS_PER_INTERRUPT)
+        if (budget_exhausted)
+        {
+            // Head timer was left over from this call, rather than expiring while handling other timers
+            ctx->stats.num_budget_exhausted += 1u;
+            expiry_overflow = false;
+        }
+#endif // APP_TIMER_MAX_EXPIRIES_PER_INTERRUPT || APP_TIMER_MAX_COUNTS_PER_INTERRUPT
+#ifdef APP_TIMER_DEFERRED_DISPATCH
+        if (dispatch_ring_full)
+        {
+            // Head timer was left over from this call, because its handler could not be queued
+            expiry_overflow = false;
+        }
+#endif // APP_TIMER_DEFERRED_DISPATCH
+        ctx->stats.num_expiry_overflows += (uint32_t) expiry_overflow;
+#endif // APP_TIMER_STATS_ENABLE
+
+#ifndef APP_TIMER_RECONFIG_WITHOUT_STOPPING
+        ctx->hw_model->set_timer_running(true);
+#endif // APP_TIMER_RECONFIG_WITHOUT_STOPPING
+        ctx->counts_after_last_start = ctx->hw_model->read_timer_counts();
+    }
+
+#ifdef APP_TIMER_DURATION_STATS_ENABLE
+    if (NULL != curr)
+    {
+        // Time since the counter was re-started for the next expiration
+        critical_counts += _duration_counts(ctx, ctx->counts_after_last_start, ctx->hw_model->read_timer_counts());
+    }
+
+    /* The counter is stopped while it is re-configured, so the time spent doing that can't be
+     * measured, but the rest of this call has been measured, up to re-enabling interrupts */
+    (void) _record_duration(ctx, &ctx->stats.target_count_reached_duration, critical_counts + handler_total_counts);
+#ifdef APP_TIMER_ENABLE_INTERRUPTS_FOR_HANDLER
+    (void) _record_duration(ctx, &ctx->stats.target_count_reached_critical_duration, critical_counts);
+#else
+    (void) _record_duration(ctx, &ctx->stats.target_count_reached_critical_duration, critical_counts + handler_total_counts);
+#endif // APP_TIMER_ENABLE_INTERRUPTS_FOR_HANDLER
+#endif // APP_TIMER_DURATION_STATS_ENABLE
+
+    ctx->hw_model->set_interrupts_enabled(true, &int_status);
+
+    ctx->inside_target_count_reached = false;
+}
+
+
+/**
+ * @see app_timer_api.h
+ */
+app_timer_error_e app_timer_ctx_create(app_timer_ctx_t *ctx, app_timer_t *timer, app_timer_handler_t handler, app_timer_type_e type)
+{
+    if (NULL == ctx)
+    {
+        return APP_TIMER_NULL_PARAM;
+    }
+
+    if (!ctx->initialized)
+    {
+        return APP_TIMER_INVALID_STATE;
+    }
+
+    if (NULL == timer)
+    {
+        return APP_TIMER_NULL_PARAM;
+    }
+
+    if (APP_TIMER_TYPE_COUNT <= type)
+    {
+        return APP_TIMER_INVALID_PARAM;
+    }
+
+    timer->handler = handler;
+#ifdef APP_TIMER_ABSOLUTE_DEADLINE
+    timer->expiry_counts = 0u;
+#else
+    timer->start_counts = 0u;
+#endif // APP_TIMER_ABSOLUTE_DEADLINE
+    timer->total_counts = 0u;
+#ifdef APP_TIMER_SLACK_ENABLE
+    timer->slack_counts = 0u;
+#endif // APP_TIMER_SLACK_ENABLE
+    timer->next = NULL;
+    timer->previous = NULL;
+
+    /* Set timer type. Other flags should be 0 by default */
+    timer->flags = ((((uint8_t) type) << FLAGS_TYPE_POS) & FLAGS_TYPE_MASK);
+
+    return APP_TIMER_OK;
+}
+
+
+/**
+ * Returns the current timestamp to use as the start time for timers that are being started.
+ * Must be called with interrupts disabled.
+ *
+ * @param ctx         Pointer to timer context
+ * @param only_timer  True if there are no other active timers
+ *
+ * @return Current timestamp in timer counts
+ */
+static app_timer_running_count_t _start_timestamp(app_timer_ctx_t *ctx, bool only_timer)
+{
+    if (only_timer && !ctx->inside_target_count_reached)
+    {
+        /* No other timers are running, and we're not being called from
+         * app_timer_target_count_reached, so the counter is stopped. */
+#ifdef APP_TIMER_ABSOLUTE_DEADLINE
+        // ctx->running_timer_count is not reset when the counter stops, start from where it left off
+        return ctx->running_timer_count;
+#else
+        // ctx->running_timer_count is reset when the counter stops, so start_counts should be 0
+        return 0u;
+#endif // APP_TIMER_ABSOLUTE_DEADLINE
+    }
+    else
+    {
+        /* Other timers are already running, or we are being called from
+         * app_timer_target_count_reached. Calculate timestamp for start_counts based on
+         * the current hardware timer/counter value. */
+        return _total_timer_counts(ctx);
+    }
+}
+
+
+/**
+ * Re-configures the hardware timer/counter for a timer that has just been started, and has
+ * become the new head of the set of active timers. Must be called with interrupts disabled,
+ * and not from inside app_timer_target_count_reached.
+ *
+ * The counter is configured from the current timestamp to the expiry time of the new head
+ * timer, rather than from the time the new head timer was started, since the counter keeps
+ * running while the set of active timers is being modified.
+ *
+ * @param ctx         Pointer to timer context
+ * @param head        Pointer to new head timer instance
+ * @param only_timer  True if there were no other active timers before the new head was started
+ */
+static void _configure_timer_for_new_head(app_timer_ctx_t *ctx, app_timer_t *head, bool only_timer)
+{
+    if (!only_timer)
+    {
+        /* If we've replaced another timer as the head timer, then we need to
+         * update ctx->running_timer_count with the number of ticks that have elapsed
+         * for the previous head timer. */
+        ctx->running_timer_count += (ctx->hw_model->read_timer_counts() - ctx->counts_after_last_start);
+    }
+
+    /* If the head timer should have already expired (e.g. a long batch of timers was started),
+     * configure the hardware for 1 tick, so that it is handled as soon as possible */
+    app_timer_running_count_t ticks_until_expiry = _ticks_until_expiry(ctx->running_timer_count, head);
+
+#ifndef APP_TIMER_RECONFIG_WITHOUT_STOPPING
+    // We should stop the counter before re-configuring it
+    ctx->hw_model->set_timer_running(false);
+#endif // APP_TIMER_RECONFIG_WITHOUT_STOPPING
+    _configure_timer(ctx, (0u == ticks_until_expiry) ? 1u : ticks_until_expiry);
+#ifdef APP_TIMER_RECONFIG_WITHOUT_STOPPING
+    /* Since we're not stopping/restarting the counter with each timer period,
+     * we may need to start the counter if this is the only active timer */
+    if (only_timer)
+    {
+        ctx->hw_model->set_timer_running(true);
+    }
+#else
+    ctx->hw_model->set_timer_running(true);
+#endif // APP_TIMER_RECONFIG_WITHOUT_STOPPING
+    ctx->counts_after_last_start = ctx->hw_model->read_timer_counts();
+}
+
+
+/**
+ * @see app_timer_api.h
+ */
+app_timer_error_e app_timer_ctx_start(app_timer_ctx_t *ctx, app_timer_t *timer, app_timer_period_t time_from_now, void *context)
+{
+    if (NULL == ctx)
+    {
+        return APP_TIMER_NULL_PARAM;
+    }
+
+    if (!ctx->initialized)
+    {
+        return APP_TIMER_INVALID_STATE;
+    }
+
+    if (NULL == timer)
+    {
+        return APP_TIMER_NULL_PARAM;
+    }
+
+    if (0u == time_from_now)
+    {
+        return APP_TIMER_INVALID_PARAM;
+    }
+
+    // Read timer state
+    _timer_state_e state = (_timer_state_e) ((timer->flags & FLAGS_STATE_MASK) >> FLAGS_STATE_POS);
+
+    if (TIMER_STATE_ACTIVE == state)
+    {
+        // Timer is already active
+        return APP_TIMER_OK;
+    }
+
+    app_timer_running_count_t total_counts = ctx->hw_model->units_to_timer_counts(time_from_now);
+
+    if (0u != (total_counts & RUNNING_COUNT_SIGN_BIT))
+    {
+        // Timer period must be less than half the range of app_timer_running_count_t
+        return APP_TIMER_INVALID_PARAM;
+    }
+
+    /* Disable interrupts, don't want another app_timer function being called from ISR
+     * context to interrupt modification of the list of active timers */
+    app_timer_int_status_t int_status = 0u;
+    ctx->hw_model->set_interrupts_enabled(false, &int_status);
+
+    timer->context = context;
+    timer->total_counts = total_counts;
+
+    // Were any timers running before this one?
+    bool only_timer = (NULL == _active_set_next(ctx));
+
+    /* The expiry time of the timer must be set before calling _insert_active_timer,
+     * in order to position the new timer correctly within the set of active timers */
+    app_timer_running_count_t now = _start_timestamp(ctx, only_timer);
+    _set_start_timestamp(timer, now);
+
+    // Insert timer into active set
+    if (!_insert_active_timer(ctx, timer, now))
+    {
+        ctx->hw_model->set_interrupts_enabled(true, &int_status);
+        return APP_TIMER_FULL;
+    }
+
+    /* If this is the new head of the list, we need to re-configure the hardware timer/counter */
+    bool new_head = (timer == _active_set_next(ctx)) && !ctx->inside_target_count_reached;
+
+    if (new_head)
+    {
+        _configure_timer_for_new_head(ctx, timer, only_timer);
+    }
+
+#ifdef APP_TIMER_DURATION_STATS_ENABLE
+    /* If the counter was not running before, then the time spent before it was started can't
+     * be measured, so this call is not measured at all (rather than being recorded as 0) */
+    if (!only_timer || ctx->inside_target_count_reached)
+    {
+        /* If the counter was re-configured, then it was just re-started, so
+         * ctx->running_timer_count is the current timestamp */
+        app_timer_running_count_t end = new_head ? ctx->running_timer_count : _total_timer_counts(ctx);
+        (void) _record_duration(ctx, &ctx->stats.start_critical_duration, (uint64_t) (app_timer_running_count_t) (end - now));
+    }
+#endif // APP_TIMER_DURATION_STATS_ENABLE
+
+    ctx->hw_model->set_interrupts_enabled(true, &int_status);
+
+    return APP_TIMER_OK;
+}
+
+
+#ifdef APP_TIMER_SLACK_ENABLE
+/**
+ * @see app_timer_api.h
+ */
+app_timer_error_e app_timer_ctx_start_slack(app_timer_ctx_t *ctx, app_timer_t *timer, app_timer_period_t time_from_now,
+                                            app_timer_period_t slack, void *context)
+{
+    if (NULL == ctx)
+    {
+        return APP_TIMER_NULL_PARAM;
+    }
+
+    if (!ctx->initialized)
+    {
+        return APP_TIMER_INVALID_STATE;
+    }
+
+    if (NULL == timer)
+    {
+        return APP_TIMER_NULL_PARAM;
+    }
+
+    app_timer_running_count_t slack_counts = (0u == slack) ? 0u : ctx->hw_model->units_to_timer_counts(slack);
+
+    if (0u != (slack_counts & RUNNING_COUNT_SIGN_BIT))
+    {
+        // Slack must be less than half the range of app_timer_running_count_t
+        return APP_TIMER_INVALID_PARAM;
+    }
+
+    // Slack is only used when the timer expiry time is set, so it can be changed at any time
+    timer->slack_counts = slack_counts;
+
+    return app_timer_ctx_start(ctx, timer, time_from_now, context);
+}
+#endif // APP_TIMER_SLACK_ENABLE
+
+
+/**
+ * @see app_timer_api.h
+ */
+app_timer_error_e app_timer_ctx_start_many(app_timer_ctx_t *ctx, app_timer_t **timers, const app_timer_period_t *periods, void **contexts, size_t n)
+{
+    if (NULL == ctx)
+    {
+        return APP_TIMER_NULL_PARAM;
+    }
+
+    if (!ctx->initialized)
+    {
+        return APP_TIMER_INVALID_STATE;
+    }
+
+    if ((NULL == timers) || (NULL == periods))
+    {
+        return APP_TIMER_NULL_PARAM;
+    }
+
+    // Check all parameters before starting anything
+    for (size_t i = 0u; i < n; i++)
+    {
+        if (NULL == timers[i])
+        {
+            return APP_TIMER_NULL_PARAM;
+        }
+
+        if (0u == periods[i])
+        {
+            return APP_TIMER_INVALID_PARAM;
+        }
+    }
+
+    /* Convert all timer periods to timer counts before disabling interrupts, so that
+     * units_to_timer_counts is not called n times with interrupts disabled. The period of each
+     * timer that is not already active is stored in #total_counts, ready for the timer to be
+     * inserted. Walk the batch backwards, so that if a timer appears in the batch more than once,
+     * the first occurrence decides its period (as for the context). */
+    for (size_t i = n; i > 0u; i--)
+    {
+        app_timer_t *timer = timers[i - 1u];
+        _timer_state_e state = (_timer_state_e) ((timer->flags & FLAGS_STATE_MASK) >> FLAGS_STATE_POS);
+
+        if (TIMER_STATE_ACTIVE == state)
+        {
+            // Timer is already active, and its period must not be changed
+            continue;
+        }
+
+        app_timer_running_count_t total_counts = ctx->hw_model->units_to_timer_counts(periods[i - 1u]);
+
+        if (0u != (total_counts & RUNNING_COUNT_SIGN_BIT))
+        {
+            // Timer period must be less than half the range of app_timer_running_count_t
+            return APP_TIMER_INVALID_PARAM;
+        }
+
+        timer->total_counts = total_counts;
+    }
+
+    app_timer_error_e ret = APP_TIMER_OK;
+
+    /* Disable interrupts, don't want another app_timer function being called from ISR
+     * context to interrupt modification of the list of active timers */
+    app_timer_int_status_t int_status = 0u;
+    ctx->hw_model->set_interrupts_enabled(false, &int_status);
+
+    // Were any timers running before these ones?
+    app_timer_t *old_head = _active_set_next(ctx);
+    bool only_timer = (NULL == old_head);
+
+    // All timers in the batch are started at the same time
+    app_timer_running_count_t now = _start_timestamp(ctx, only_timer);
+
+    for (size_t i = 0u; i < n; i++)
+    {
+        app_timer_t *timer = timers[i];
+        _timer_state_e state = (_timer_state_e) ((timer->flags & FLAGS_STATE_MASK) >> FLAGS_STATE_POS);
+
+        if (TIMER_STATE_ACTIVE == state)
+        {
+            // Timer is already active (or appears in the batch more than once)
+            continue;
+        }
+
+        // #total_counts was set above
+        timer->context = (NULL == contexts) ? NULL : contexts[i];
+        _set_start_timestamp(timer, now);
+
+        if (!_insert_active_timer(ctx, timer, now))
+        {
+            ret = APP_TIMER_FULL;
+        }
+    }
+
+    /* If the head of the list changed, we need to re-configure the hardware timer/counter,
+     * but only once for the whole batch */
+    app_timer_t *new_head = _active_set_next(ctx);
+
+    if ((new_head != old_head) && !ctx->inside_target_count_reached)
+    {
+        _configure_timer_for_new_head(ctx, new_head, only_timer);
+    }
+
+    ctx->hw_model->set_interrupts_enabled(true, &int_status);
+
+    return ret;
+}
+
+
+/**
+ * Removes a timer from the set of active timers, and sets the timer state to stopped.
+ * Must be called with interrupts disabled.
+ *
+ * @param ctx    Pointer to timer context
+ * @param timer  Pointer to timer instance to stop
+ *
+ * @return True if the timer was removed from the set of active timers, false if the timer
+ *         was already stopped or had expired
+ */
+static bool _stop_timer(app_timer_ctx_t *ctx, app_timer_t *timer)
+{
+    // Read timer state
+    _timer_state_e state = (_timer_state_e) ((timer->flags & FLAGS_STATE_MASK) >> FLAGS_STATE_POS);
+
+    if (TIMER_STATE_ACTIVE == state)
+    {
+        // Remove from active timers set
+        _active_set_remove(ctx, timer);
+
+#ifdef APP_TIMER_STATS_ENABLE
+        ctx->stats.num_timers -= 1u;
+#endif // APP_TIMER_STATS_ENABLE
+    }
+
+    /* An expired timer (whose handler is running or pending, or a single-shot timer whose
+     * handler has returned) was already removed from the active set when it expired */
+    timer->flags &= ~FLAGS_STATE_MASK;
+
+    return (TIMER_STATE_ACTIVE == state);
+}
+
+
+/**
+ * Re-configures the hardware timer/counter after one or more timers have been stopped.
+ * Must be called with interrupts disabled.
+ *
+ * @param ctx       Pointer to timer context
+ * @param old_head  Pointer to the head timer before any timers were stopped
+ */
+static void _configure_timer_after_stop(app_timer_ctx_t *ctx, app_timer_t *old_head)
+{
+    // Don't want to touch the hardware if called from app_timer_target_count_reached
+    if (!ctx->inside_target_count_reached)
+    {
+        app_timer_t *new_head = _active_set_next(ctx);
+
+        if (NULL == new_head)
+        {
+            // If there are no more active timers, stop the counter
+            ctx->hw_model->set_timer_running(false);
+#ifndef APP_TIMER_ABSOLUTE_DEADLINE
+            ctx->running_timer_count = 0u;
+#endif // APP_TIMER_ABSOLUTE_DEADLINE
+        }
+        else if (new_head != old_head)
+        {
+            /* Head timer removed, and there are more active timers. Need to update
+             * ctx->running_timer_count and re-configure counter (unless we're being called
+             * from inside app_timer_target_count_reached, which will re-config the counter
+             * as needed when it finishes). */
+            ctx->running_timer_count += (ctx->hw_model->read_timer_counts() - ctx->counts_after_last_start);
+#ifndef APP_TIMER_RECONFIG_WITHOUT_STOPPING
+            ctx->hw_model->set_timer_running(false);
+#endif // APP_TIMER_RECONFIG_WITHOUT_STOPPING
+            _configure_timer(ctx, _ticks_until_expiry(ctx->running_timer_count, new_head));
+#ifndef APP_TIMER_RECONFIG_WITHOUT_STOPPING
+            ctx->hw_model->set_timer_running(true);
+#endif // APP_TIMER_RECONFIG_WITHOUT_STOPPING
+            ctx->counts_after_last_start = ctx->hw_model->read_timer_counts();
+        }
+        else
+        {
+            ; // Nothing to do if the head timer wasn't removed
+        }
+    }
+}
+
+
+/**
+ * @see app_timer_api.h
+ */
+app_timer_error_e app_timer_ctx_stop(app_timer_ctx_t *ctx, app_timer_t *timer)
+{
+    if (NULL == ctx)
+    {
+        return APP_TIMER_NULL_PARAM;
+    }
+
+    if (!ctx->initialized)
+    {
+        return APP_TIMER_INVALID_STATE;
+    }
+
+    if (NULL == timer)
+    {
+        return APP_TIMER_NULL_PARAM;
+    }
+
+    /* Disable interrupts, don't want another app_timer function being called from ISR
+     * context to interrupt modification of the list of active timers */
+    app_timer_int_status_t int_status = 0u;
+    ctx->hw_model->set_interrupts_enabled(false, &int_status);
+
+    app_timer_t *old_head = _active_set_next(ctx);
+
+#ifdef APP_TIMER_DURATION_STATS_ENABLE
+    // Counter only runs while there are active timers, or while app_timer_target_count_reached is in progress
+    bool counter_running = (NULL != old_head) || ctx->inside_target_count_reached;
+    app_timer_running_count_t start = counter_running ? _total_timer_counts(ctx) : 0u;
+#endif // APP_TIMER_DURATION_STATS_ENABLE
+
+    if (_stop_timer(ctx, timer))
+    {
+        _configure_timer_after_stop(ctx, old_head);
+    }
+
+#ifdef APP_TIMER_DURATION_STATS_ENABLE
+    if (counter_running)
+    {
+        app_timer_t *new_head = _active_set_next(ctx);
+
+        if (ctx->inside_target_count_reached || (new_head == old_head))
+        {
+            // Counter was not re-configured
+            (void) _record_duration(ctx, &ctx->stats.stop_critical_duration, (uint64_t) (app_timer_running_count_t) (_total_timer_counts(ctx) - start));
+        }
+        else if (NULL != new_head)
+        {
+            // Counter was re-configured and re-started, so ctx->running_timer_count is the current timestamp
+            (void) _record_duration(ctx, &ctx->stats.stop_critical_duration, (uint64_t) (app_timer_running_count_t) (ctx->running_timer_count - start));
+        }
+        else
+        {
+            ; // Counter was stopped, so the end of this critical section can't be timed
+        }
+    }
+#endif // APP_TIMER_DURATION_STATS_ENABLE
+
+    ctx->hw_model->set_interrupts_enabled(true, &int_status);
+    return APP_TIMER_OK;
+}
+
+
+/**
+ * Moves a timer to a new position within the set of active timers (or inserts it, if it is
+ * not active), and re-configures the hardware timer/counter only if the head timer changes.
+ * Must be called with interrupts disabled.
+ *
+ * @param ctx           Pointer to timer context
+ * @param timer         Pointer to timer instance to move
+ * @param total_counts  New timer period in timer counts
+ * @param context       Pointer to pass to handler function
+ * @param old_head      Pointer to the head timer before the timer is moved
+ * @param now           Current timestamp, read before the timer is moved
+ *
+ * @return True if successful, false if the timer was not active and there was no space for it
+ */
+static bool _move_timer(app_timer_ctx_t *ctx, app_timer_t *timer, app_timer_running_count_t total_counts,
+                        void *context, app_timer_t *old_head, app_timer_running_count_t now)
+{
+    // Read timer state
+    _timer_state_e state = (_timer_state_e) ((timer->flags & FLAGS_STATE_MASK) >> FLAGS_STATE_POS);
+
+    if (TIMER_STATE_ACTIVE == state)
+    {
+        // Remove timer from its current position, without touching the counter
+        (void) _stop_timer(ctx, timer);
+    }
+
+    timer->context = context;
+    timer->total_counts = total_counts;
+    _set_start_timestamp(timer, now);
+
+    // Insert timer into active set, at its new position
+    if (!_insert_active_timer(ctx, timer, now))
+    {
+        // Can only fail if the timer was not already active, so the active set is unchanged
+        return false;
+    }
+
+    // Only need to re-configure the hardware timer/counter if the head timer changed
+    if (!ctx->inside_target_count_reached)
+    {
+        if (timer == _active_set_next(ctx))
+        {
+            // Timer is the new head timer, or was the head timer and its expiry time changed
+            _configure_timer_for_new_head(ctx, timer, (NULL == old_head));
+        }
+        else if (timer == old_head)
+        {
+            // Timer was the head timer, and another timer has replaced it
+            _configure_timer_after_stop(ctx, old_head);
+        }
+        else
+        {
+            ; // Head timer did not change, nothing to do
+        }
+    }
+
+    return true;
+}
+
+
+/**
+ * Restarts a timer with a new period, moving it within the set of active timers in a single
+ * critical section, and re-configures the hardware timer/counter only if the head timer changes.
+ *
+ * @param ctx           Pointer to timer context
+ * @param timer         Pointer to timer instance to restart
+ * @param total_counts  New timer period in timer counts
+ * @param context       Pointer to pass to handler function
+ *
+ * @return #APP_TIMER_OK if successful
+ */
+static app_timer_error_e _restart_timer(app_timer_ctx_t *ctx, app_timer_t *timer, app_timer_running_count_t total_counts, void *context)
+{
+    /* Disable interrupts, don't want another app_timer function being called from ISR
+     * context to interrupt modification of the list of active timers */
+    app_timer_int_status_t int_status = 0u;
+    ctx->hw_model->set_interrupts_enabled(false, &int_status);
+
+    /* The start time must be read before the timer is removed, since the counter is still
+     * running for this timer even if it is the only active timer */
+    app_timer_t *old_head = _active_set_next(ctx);
+    app_timer_running_count_t now = _start_timestamp(ctx, (NULL == old_head));
+
+    bool moved = _move_timer(ctx, timer, total_counts, context, old_head, now);
+
+    ctx->hw_model->set_interrupts_enabled(true, &int_status);
+
+    return moved ? APP_TIMER_OK : APP_TIMER_FULL;
+}
+
+
+/**
+ * @see app_timer_api.h
+ */
+app_timer_error_e app_timer_ctx_restart(app_timer_ctx_t *ctx, app_timer_t *timer, app_timer_period_t time_from_now, void *context)
+{
+    if (NULL == ctx)
+    {
+        return APP_TIMER_NULL_PARAM;
+    }
+
+    if (!ctx->initialized)
+    {
+        return APP_TIMER_INVALID_STATE;
+    }
+
+    if (NULL == timer)
+    {
+        return APP_TIMER_NULL_PARAM;
+    }
+
+    if (0u == time_from_now)
+    {
+        return APP_TIMER_INVALID_PARAM;
+    }
+
+    app_timer_running_count_t total_counts = ctx->hw_model->units_to_timer_counts(time_from_now);
+
+    if (0u != (total_counts & RUNNING_COUNT_SIGN_BIT))
+    {
+        // Timer period must be less than half the range of app_timer_running_count_t
+        return APP_TIMER_INVALID_PARAM;
+    }
+
+    return _restart_timer(ctx, timer, total_counts, context);
+}
+
+
+#ifdef APP_TIMER_TOUCH_ENABLE
+/**
+ * @see app_timer_api.h
+ */
+app_timer_error_e app_timer_ctx_touch(app_timer_ctx_t *ctx, app_timer_t *timer, app_timer_period_t time_from_now)
+{
+    if (NULL == ctx)
+    {
+        return APP_TIMER_NULL_PARAM;
+    }
+
+    if (!ctx->initialized)
+    {
+        return APP_TIMER_INVALID_STATE;
+    }
+
+    if (NULL == timer)
+    {
+        return APP_TIMER_NULL_PARAM;
+    }
+
+    if (0u == time_from_now)
+    {
+        return APP_TIMER_INVALID_PARAM;
+    }
+
+    app_timer_running_count_t total_counts = ctx->hw_model->units_to_timer_counts(time_from_now);
+
+    if (0u != (total_counts & RUNNING_COUNT_SIGN_BIT))
+    {
+        // Timer period must be less than half the range of app_timer_running_count_t
+        return APP_TIMER_INVALID_PARAM;
+    }
+
+    app_timer_int_status_t int_status = 0u;
+    ctx->hw_model->set_interrupts_enabled(false, &int_status);
+
+    // Read timer state
+    _timer_state_e state = (_timer_state_e) ((timer->flags & FLAGS_STATE_MASK) >> FLAGS_STATE_POS);
+
+    if (TIMER_STATE_ACTIVE != state)
+    {
+        // Stopped, or expired and waiting for the handler to run; only a running timer can be extended
+        ctx->hw_model->set_interrupts_enabled(true, &int_status);
+        return APP_TIMER_INVALID_STATE;
+    }
+
+    // Timer is active, so the counter is running and the current timestamp can be read
+    app_timer_running_count_t now = _total_timer_counts(ctx);
+    app_timer_running_count_t deadline = now + total_counts;
+
+    if (_counts_before(deadline, _timer_expiry(timer)))
+    {
+        // New expiry time is earlier, timer must be moved (can't fail, since it is already active)
+        (void) _move_timer(ctx, timer, total_counts, timer->context, _active_set_next(ctx), now);
+    }
+    else
+    {
+        /* New expiry time is no earlier than the position of the timer in the set of
+         * active timers, just record it, and the timer will be re-inserted when it
+         * reaches its current position */
+#ifndef APP_TIMER_ABSOLUTE_DEADLINE
+        // Period may change, keep start_counts + total_counts the same
+        timer->start_counts += timer->total_counts - total_counts;
+#endif // APP_TIMER_ABSOLUTE_DEADLINE
+        timer->total_counts = total_counts;
+        timer->deadline_counts = deadline;
+    }
+
+    ctx->hw_model->set_interrupts_enabled(true, &int_status);
+
+    return APP_TIMER_OK;
+}
+#endif // APP_TIMER_TOUCH_ENABLE
+
+
+/**
+ * @see app_timer_api.h
+ */
+app_timer_error_e app_timer_ctx_stop_many(app_timer_ctx_t *ctx, app_timer_t **timers, size_t n)
+{
+    if (NULL == ctx)
+    {
+        return APP_TIMER_NULL_PARAM;
+    }
+
+    if (!ctx->initialized)
+    {
+        return APP_TIMER_INVALID_STATE;
+    }
+
+    if (NULL == timers)
+    {
+        return APP_TIMER_NULL_PARAM;
+    }
+
+    // Check all parameters before stopping anything
+    for (size_t i = 0u; i < n; i++)
+    {
+        if (NULL == timers[i])
+        {
+            return APP_TIMER_NULL_PARAM;
+        }
+    }
+
+    /* Disable interrupts, don't want another app_timer function being called from ISR
+     * context to interrupt modification of the list of active timers */
+    app_timer_int_status_t int_status = 0u;
+    ctx->hw_model->set_interrupts_enabled(false, &int_status);
+
+    app_timer_t *old_head = _active_set_next(ctx);
+    bool stopped = false;
+
+    for (size_t i = 0u; i < n; i++)
+    {
+        stopped |= _stop_timer(ctx, timers[i]);
+    }
+
+    // Re-configure the counter only once, for the whole batch
+    if (stopped)
+    {
+        _configure_timer_after_stop(ctx, old_head);
+    }
+
+    ctx->hw_model->set_interrupts_enabled(true, &int_status);
+    return APP_TIMER_OK;
+}
+
+
+/**
+ * @see app_timer_api.h
+ */
+app_timer_error_e app_timer_ctx_stop_all(app_timer_ctx_t *ctx)
+{
+    if (NULL == ctx)
+    {
+        return APP_TIMER_NULL_PARAM;
+    }
+
+    if (!ctx->initialized)
+    {
+        return APP_TIMER_INVALID_STATE;
+    }
+
+    /* Disable interrupts, don't want another app_timer function being called from ISR
+     * context to interrupt modification of the list of active timers */
+    app_timer_int_status_t int_status = 0u;
+    ctx->hw_model->set_interrupts_enabled(false, &int_status);
+
+    app_timer_t *old_head = _active_set_next(ctx);
+
+    if (NULL != old_head)
+    {
+        // Empty the active set in one pass, then re-configure the counter once
+        _active_set_clear(ctx);
+
+#ifdef APP_TIMER_STATS_ENABLE
+        ctx->stats.num_timers = 0u;
+#endif // APP_TIMER_STATS_ENABLE
+
+        _configure_timer_after_stop(ctx, old_head);
+    }
+
+    ctx->hw_model->set_interrupts_enabled(true, &int_status);
+    return APP_TIMER_OK;
+}
 
-    if (NULL == timer)
+
+/**
+ * @see app_timer_api.h
+ */
+app_timer_error_e app_timer_ctx_is_active(app_timer_ctx_t *ctx, app_timer_t *timer, bool *is_active)
+{
+    if (NULL == ctx)
     {
         return APP_TIMER_NULL_PARAM;
     }
 
-    if (APP_TIMER_TYPE_COUNT <= type)
+    if (!ctx->initialized)
     {
-        return APP_TIMER_INVALID_PARAM;
+        // Not initialized
+        return APP_TIMER_INVALID_STATE;
     }
 
-    timer->handler = handler;
-    timer->start_counts = 0u;
-    timer->total_counts = 0u;
-    timer->next = NULL;
-    timer->previous = NULL;
+    if ((NULL == timer) || (NULL == is_active))
+    {
+        return APP_TIMER_NULL_PARAM;
+    }
 
-    /* Set timer type. Other flags should be 0 by default */
-    timer->flags = ((((uint8_t) type) << FLAGS_TYPE_POS) & FLAGS_TYPE_MASK);
+    // Read timer state
+    _timer_state_e state = (_timer_state_e) ((timer->flags & FLAGS_STATE_MASK) >> FLAGS_STATE_POS);
+
+    // Report true if timer is in active state
+    *is_active = (TIMER_STATE_ACTIVE == state);
 
     return APP_TIMER_OK;
 }
@@ -456,206 +2658,127 @@ app_timer_error_e app_timer_create(app_timer_t *timer, app_timer_handler_t handl
 /**
  * @see app_timer_api.h
  */
-app_timer_error_e app_timer_start(app_timer_t *timer, app_timer_period_t time_from_now, void *context)
+app_timer_error_e app_timer_ctx_ticks_until_next_expiry(app_timer_ctx_t *ctx, app_timer_running_count_t *ticks)
 {
-    if (!_initialized)
-    {
-        return APP_TIMER_INVALID_STATE;
-    }
-
-    if (NULL == timer)
+    if (NULL == ctx)
     {
         return APP_TIMER_NULL_PARAM;
     }
 
-    if (0u == time_from_now)
+    if (!ctx->initialized)
     {
-        return APP_TIMER_INVALID_PARAM;
+        // Not initialized
+        return APP_TIMER_INVALID_STATE;
     }
 
-    // Read timer state
-    _timer_state_e state = (_timer_state_e) ((timer->flags & FLAGS_STATE_MASK) >> FLAGS_STATE_POS);
-
-    if (TIMER_STATE_ACTIVE == state)
+    if (NULL == ticks)
     {
-        // Timer is already active
-        return APP_TIMER_OK;
+        return APP_TIMER_NULL_PARAM;
     }
 
-    app_timer_running_count_t total_counts = _hw_model->units_to_timer_counts(time_from_now);
-
-    /* Disable interrupts, don't want another app_timer function being called from ISR
-     * context to interrupt modification of the list of active timers */
+    app_timer_error_e ret = APP_TIMER_OK;
     app_timer_int_status_t int_status = 0u;
-    _hw_model->set_interrupts_enabled(false, &int_status);
-
-    timer->context = context;
-    timer->total_counts = total_counts;
+    ctx->hw_model->set_interrupts_enabled(false, &int_status);
 
-    // Were any timers running before this one?
-    bool only_timer = (NULL == _active_timers.head);
+    app_timer_t *head = _active_set_next(ctx);
 
-    /* timer->start_counts must be set before calling _insert_active_timer; the expiry
-     * time of the timer must be known in order to position the new timer correctly
-     * within the list */
-    if (only_timer && !_inside_target_count_reached)
+    if (NULL == head)
     {
-        /* No other timers are running, and we're not being called from
-         * app_timer_target_count_reached, so start_counts should be 0. */
-        timer->start_counts = 0u;
+        ret = APP_TIMER_NO_ACTIVE_TIMERS;
     }
     else
     {
-        /* Other timers are already running, or we are being called from
-         * app_timer_target_count_reached. Calculate timestamp for start_counts based on
-         * the current hardware timer/counter value. */
-        timer->start_counts = _total_timer_counts();
-    }
-
-    // Insert timer into list
-    _insert_active_timer(timer, timer->start_counts);
-
-    /* If this is the new head of the list, we need to re-configure the hardware timer/counter */
-    if ((timer == _active_timers.head) && !_inside_target_count_reached)
-    {
-        if (!only_timer)
-        {
-            /* If we've replaced another timer as the head timer, then we need to
-             * update _running_timer_count with the number of ticks that have elapsed
-             * for the previous head timer. */
-            _running_timer_count += (_hw_model->read_timer_counts() - _counts_after_last_start);
-        }
-
-#ifndef APP_TIMER_RECONFIG_WITHOUT_STOPPING
-        // We should stop the counter before re-configuring it
-        _hw_model->set_timer_running(false);
-#endif // APP_TIMER_RECONFIG_WITHOUT_STOPPING
-        _configure_timer(timer->total_counts);
-#ifdef APP_TIMER_RECONFIG_WITHOUT_STOPPING
-        /* Since we're not stopping/restarting the counter with each timer period,
-         * we may need to start the counter if this is the only active timer */
-        if (only_timer)
-        {
-            _hw_model->set_timer_running(true);
-        }
-#else
-        _hw_model->set_timer_running(true);
-#endif // APP_TIMER_RECONFIG_WITHOUT_STOPPING
-        _counts_after_last_start = _hw_model->read_timer_counts();
+        // Same calculation used to configure the counter for the head timer
+        *ticks = _ticks_until_expiry(_total_timer_counts(ctx), head);
     }
 
-    _hw_model->set_interrupts_enabled(true, &int_status);
+    ctx->hw_model->set_interrupts_enabled(true, &int_status);
 
-    return APP_TIMER_OK;
+    return ret;
 }
 
 
 /**
  * @see app_timer_api.h
  */
-app_timer_error_e app_timer_stop(app_timer_t *timer)
+app_timer_error_e app_timer_ctx_units_until_next_expiry(app_timer_ctx_t *ctx, app_timer_period_t *units)
 {
-    if (!_initialized)
+    if (NULL == units)
     {
-        return APP_TIMER_INVALID_STATE;
+        return APP_TIMER_NULL_PARAM;
     }
 
-    if (NULL == timer)
+    if ((NULL != ctx) && ctx->initialized && (NULL == ctx->hw_model->timer_counts_to_units))
     {
-        return APP_TIMER_NULL_PARAM;
+        // Hardware model does not support converting counts to units
+        return APP_TIMER_INVALID_STATE;
     }
 
-    /* Disable interrupts, don't want another app_timer function being called from ISR
-     * context to interrupt modification of the list of active timers */
-    app_timer_int_status_t int_status = 0u;
-    _hw_model->set_interrupts_enabled(false, &int_status);
-
-    // Read timer state
-    _timer_state_e state = (_timer_state_e) ((timer->flags & FLAGS_STATE_MASK) >> FLAGS_STATE_POS);
+    app_timer_running_count_t ticks = 0u;
+    app_timer_error_e ret = app_timer_ctx_ticks_until_next_expiry(ctx, &ticks);
 
-    if ((TIMER_STATE_ACTIVE == state) || (TIMER_STATE_EXPIRED == state))
+    if (APP_TIMER_OK == ret)
     {
-        // Remove from active timers list
-        bool head_removed  = (_active_timers.head == timer);
-        _remove_timer_from_list(&_active_timers, timer);
-
-#ifdef APP_TIMER_STATS_ENABLE
-        _stats.num_timers -= 1u;
-#endif // APP_TIMER_STATS_ENABLE
-
-        // Clear state bits to set timer state to stopped
-        timer->flags &= ~FLAGS_STATE_MASK;
-
-        // Don't want to touch the hardware if called from app_timer_target_count_reached
-        if (!_inside_target_count_reached)
-        {
-            if (NULL == _active_timers.head)
-            {
-                // If this was the only active timer, stop the counter
-                _hw_model->set_timer_running(false);
-                _running_timer_count = 0u;
-            }
-            else if (head_removed)
-            {
-                /* Head timer removed, and there are more active timers. Need to update
-                 * _running_timer_count and re-configure counter (unless we're being called
-                 * from inside app_timer_target_count_reached, which will re-config the counter
-                 * as needed when it finishes). */
-                _running_timer_count += (_hw_model->read_timer_counts() - _counts_after_last_start);
-#ifndef APP_TIMER_RECONFIG_WITHOUT_STOPPING
-                _hw_model->set_timer_running(false);
-#endif // APP_TIMER_RECONFIG_WITHOUT_STOPPING
-                _configure_timer(_ticks_until_expiry(_running_timer_count, _active_timers.head));
-#ifndef APP_TIMER_RECONFIG_WITHOUT_STOPPING
-                _hw_model->set_timer_running(true);
-#endif // APP_TIMER_RECONFIG_WITHOUT_STOPPING
-                _counts_after_last_start = _hw_model->read_timer_counts();
-            }
-            else
-            {
-                ; // Nothing to do if removed timer wasn't the head, or if inside target_count_reached
-            }
-        }
+        *units = ctx->hw_model->timer_counts_to_units(ticks);
     }
 
-    _hw_model->set_interrupts_enabled(true, &int_status);
-    return APP_TIMER_OK;
+    return ret;
 }
 
 
+#ifdef APP_TIMER_DEFERRED_DISPATCH
 /**
  * @see app_timer_api.h
  */
-app_timer_error_e app_timer_is_active(app_timer_t *timer, bool *is_active)
+app_timer_error_e app_timer_ctx_dispatch_pending(app_timer_ctx_t *ctx)
 {
-    if (!_initialized)
+    if (NULL == ctx)
     {
-        // Not initialized
-        return APP_TIMER_INVALID_STATE;
+        return APP_TIMER_NULL_PARAM;
     }
 
-    if ((NULL == timer) || (NULL == is_active))
+    if (!ctx->initialized)
     {
-        return APP_TIMER_NULL_PARAM;
+        return APP_TIMER_INVALID_STATE;
     }
 
-    // Read timer state
-    _timer_state_e state = (_timer_state_e) ((timer->flags & FLAGS_STATE_MASK) >> FLAGS_STATE_POS);
+    uint32_t tail = atomic_load_explicit(&ctx->dispatch_ring.tail, memory_order_relaxed);
 
-    // Report true if timer is in active state
-    *is_active = (TIMER_STATE_ACTIVE == state);
+    // Handlers run here may start timers that expire and are pushed while the ring is being emptied
+    while (tail != atomic_load_explicit(&ctx->dispatch_ring.head, memory_order_acquire))
+    {
+        app_timer_t *timer = ctx->dispatch_ring.timers[tail & (APP_TIMER_DISPATCH_RING_SIZE - 1u)];
+
+        // Entry must be read before it is released to the producer
+        tail += 1u;
+        atomic_store_explicit(&ctx->dispatch_ring.tail, tail, memory_order_release);
+
+        // Timers stopped after they expired, but before now, should not run their handlers
+        _timer_state_e state = (_timer_state_e) ((timer->flags & FLAGS_STATE_MASK) >> FLAGS_STATE_POS);
+
+        if ((TIMER_STATE_STOPPED != state) && (NULL != timer->handler))
+        {
+            timer->handler(timer->context);
+        }
+    }
 
     return APP_TIMER_OK;
 }
+#endif // APP_TIMER_DEFERRED_DISPATCH
 
 
 #ifdef APP_TIMER_STATS_ENABLE
 /**
  * @see app_timer_api.h
  */
-app_timer_error_e app_timer_stats(app_timer_stats_t *stats)
+app_timer_error_e app_timer_ctx_stats(app_timer_ctx_t *ctx, app_timer_stats_t *stats)
 {
-    if (!_initialized)
+    if (NULL == ctx)
+    {
+        return APP_TIMER_NULL_PARAM;
+    }
+
+    if (!ctx->initialized)
     {
         // Not initialized
         return APP_TIMER_INVALID_STATE;
@@ -666,11 +2789,18 @@ app_timer_error_e app_timer_stats(app_timer_stats_t *stats)
         return APP_TIMER_NULL_PARAM;
     }
 
-    _stats.running_timer_count = _running_timer_count;
-    _stats.inside_target_count_reached = _inside_target_count_reached;
-    _stats.next_active_timer = _active_timers.head;
+    ctx->stats.running_timer_count = ctx->running_timer_count;
+    ctx->stats.inside_target_count_reached = ctx->inside_target_count_reached;
+    ctx->stats.next_active_timer = _active_set_next(ctx);
+
+#ifdef APP_TIMER_LATENESS_STATS_ENABLE
+    if (0u < ctx->stats.num_lateness_samples)
+    {
+        ctx->stats.lateness_mean = (app_timer_running_count_t) (ctx->stats.lateness_total / ctx->stats.num_lateness_samples);
+    }
+#endif // APP_TIMER_LATENESS_STATS_ENABLE
 
-    *stats = _stats;
+    *stats = ctx->stats;
 
     return APP_TIMER_OK;
 }
@@ -680,11 +2810,16 @@ app_timer_error_e app_timer_stats(app_timer_stats_t *stats)
 /**
  * @see app_timer_api.h
  */
-app_timer_error_e app_timer_init(app_timer_hw_model_t *model)
+app_timer_error_e app_timer_ctx_init(app_timer_ctx_t *ctx, app_timer_hw_model_t *model)
 {
-    if (_initialized)
+    if (NULL == ctx)
+    {
+        return APP_TIMER_NULL_PARAM;
+    }
+
+    if (ctx->initialized)
     {
-        // Already initialized
+        // Already initialized, don't discard any active timers
         return APP_TIMER_OK;
     }
 
@@ -704,24 +2839,185 @@ app_timer_error_e app_timer_init(app_timer_hw_model_t *model)
         return APP_TIMER_INVALID_PARAM;
     }
 
-    _hw_model = model;
+    // All-zero state is an empty set of active timers, with no pending handlers
+    (void) memset((void *) ctx, 0, sizeof(app_timer_ctx_t));
+    ctx->hw_model = model;
 
-    if (!_hw_model->init())
+    if (!ctx->hw_model->init())
     {
         return APP_TIMER_ERROR;
     }
 
-    _hw_model->set_timer_running(false);
+    ctx->hw_model->set_timer_running(false);
 
     // Enable interrupt(s) initially
     app_timer_int_status_t int_status = 0u;
-    _hw_model->set_interrupts_enabled(true, &int_status);
+    ctx->hw_model->set_interrupts_enabled(true, &int_status);
 
-    _initialized = true;
+    ctx->initialized = true;
 
     return APP_TIMER_OK;
 }
 
+
+/**
+ * Timer context used by all app_timer_* functions that do not take a context
+ */
+static app_timer_ctx_t _default_ctx;
+
+
+/**
+ * @see app_timer_api.h
+ */
+void app_timer_target_count_reached(void)
+{
+    app_timer_ctx_target_count_reached(&_default_ctx);
+}
+
+
+#ifdef APP_TIMER_DEFERRED_DISPATCH
+/**
+ * @see app_timer_api.h
+ */
+app_timer_error_e app_timer_dispatch_pending(void)
+{
+    return app_timer_ctx_dispatch_pending(&_default_ctx);
+}
+#endif // APP_TIMER_DEFERRED_DISPATCH
+
+
+/**
+ * @see app_timer_api.h
+ */
+app_timer_error_e app_timer_create(app_timer_t *timer, app_timer_handler_t handler, app_timer_type_e type)
+{
+    return app_timer_ctx_create(&_default_ctx, timer, handler, type);
+}
+
+
+/**
+ * @see app_timer_api.h
+ */
+app_timer_error_e app_timer_start(app_timer_t *timer, app_timer_period_t time_from_now, void *context)
+{
+    return app_timer_ctx_start(&_default_ctx, timer, time_from_now, context);
+}
+
+
+#ifdef APP_TIMER_SLACK_ENABLE
+/**
+ * @see app_timer_api.h
+ */
+app_timer_error_e app_timer_start_slack(app_timer_t *timer, app_timer_period_t time_from_now,
+                                        app_timer_period_t slack, void *context)
+{
+    return app_timer_ctx_start_slack(&_default_ctx, timer, time_from_now, slack, context);
+}
+#endif // APP_TIMER_SLACK_ENABLE
+
+
+/**
+ * @see app_timer_api.h
+ */
+app_timer_error_e app_timer_start_many(app_timer_t **timers, const app_timer_period_t *periods, void **contexts, size_t n)
+{
+    return app_timer_ctx_start_many(&_default_ctx, timers, periods, contexts, n);
+}
+
+
+/**
+ * @see app_timer_api.h
+ */
+app_timer_error_e app_timer_stop(app_timer_t *timer)
+{
+    return app_timer_ctx_stop(&_default_ctx, timer);
+}
+
+
+/**
+ * @see app_timer_api.h
+ */
+app_timer_error_e app_timer_restart(app_timer_t *timer, app_timer_period_t time_from_now, void *context)
+{
+    return app_timer_ctx_restart(&_default_ctx, timer, time_from_now, context);
+}
+
+
+#ifdef APP_TIMER_TOUCH_ENABLE
+/**
+ * @see app_timer_api.h
+ */
+app_timer_error_e app_timer_touch(app_timer_t *timer, app_timer_period_t time_from_now)
+{
+    return app_timer_ctx_touch(&_default_ctx, timer, time_from_now);
+}
+#endif // APP_TIMER_TOUCH_ENABLE
+
+
+/**
+ * @see app_timer_api.h
+ */
+app_timer_error_e app_timer_stop_many(app_timer_t **timers, size_t n)
+{
+    return app_timer_ctx_stop_many(&_default_ctx, timers, n);
+}
+
+
+/**
+ * @see app_timer_api.h
+ */
+app_timer_error_e app_timer_stop_all(void)
+{
+    return app_timer_ctx_stop_all(&_default_ctx);
+}
+
+
+/**
+ * @see app_timer_api.h
+ */
+app_timer_error_e app_timer_is_active(app_timer_t *timer, bool *is_active)
+{
+    return app_timer_ctx_is_active(&_default_ctx, timer, is_active);
+}
+
+
+/**
+ * @see app_timer_api.h
+ */
+app_timer_error_e app_timer_ticks_until_next_expiry(app_timer_running_count_t *ticks)
+{
+    return app_timer_ctx_ticks_until_next_expiry(&_default_ctx, ticks);
+}
+
+
+/**
+ * @see app_timer_api.h
+ */
+app_timer_error_e app_timer_units_until_next_expiry(app_timer_period_t *units)
+{
+    return app_timer_ctx_units_until_next_expiry(&_default_ctx, units);
+}
+
+
+#ifdef APP_TIMER_STATS_ENABLE
+/**
+ * @see app_timer_api.h
+ */
+app_timer_error_e app_timer_stats(app_timer_stats_t *stats)
+{
+    return app_timer_ctx_stats(&_default_ctx, stats);
+}
+#endif // APP_TIMER_STATS_ENABLE
+
+
+/**
+ * @see app_timer_api.h
+ */
+app_timer_error_e app_timer_init(app_timer_hw_model_t *model)
+{
+    return app_timer_ctx_init(&_default_ctx, model);
+}
+
 #ifdef __cplusplus
 }
 #endif
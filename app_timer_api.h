@@ -38,6 +38,10 @@ extern "C" {
 #include <stdbool.h>
 #include <stdint.h>
 
+#ifdef APP_TIMER_DEFERRED_DISPATCH
+#include <stdatomic.h>  // Dispatch ring indices, see APP_TIMER_DISPATCH_RING_SIZE
+#endif // APP_TIMER_DEFERRED_DISPATCH
+
 
 #define APP_TIMER_VERSION "v0.9.0"
 
@@ -74,6 +78,76 @@ extern "C" {
 #endif
 
 
+/**
+ * Defines the data structure used to hold the set of active timers
+ */
+#if !defined(APP_TIMER_ACTIVE_SET_SORTED_LIST) && !defined(APP_TIMER_ACTIVE_SET_TIMING_WHEEL) && \
+    !defined(APP_TIMER_ACTIVE_SET_HEAP) && !defined(APP_TIMER_ACTIVE_SET_PERIOD_FIFO) && \
+    !defined(APP_TIMER_ACTIVE_SET_DELTA_LIST)
+#define APP_TIMER_ACTIVE_SET_SORTED_LIST  // Keep active timers in a sorted linked list by default
+#endif
+
+
+/**
+ * Defines the number of slots in each level of the timing wheel, as a power of 2
+ * (only used when APP_TIMER_ACTIVE_SET_TIMING_WHEEL is defined)
+ */
+#if !defined(APP_TIMER_WHEEL_SLOT_BITS)
+#define APP_TIMER_WHEEL_SLOT_BITS (4u)  // 16 slots per level by default
+#endif
+
+
+/**
+ * Defines the maximum number of timers that can be active at the same time
+ * (only used when APP_TIMER_ACTIVE_SET_HEAP is defined)
+ */
+#if !defined(APP_TIMER_HEAP_CAPACITY)
+#define APP_TIMER_HEAP_CAPACITY (64u)  // Up to 64 active timers by default
+#endif
+
+
+/**
+ * Defines the number of distinct timer periods that get their own FIFO, valid range is 1-15
+ * (only used when APP_TIMER_ACTIVE_SET_PERIOD_FIFO is defined)
+ */
+#if !defined(APP_TIMER_PERIOD_FIFO_COUNT)
+#define APP_TIMER_PERIOD_FIFO_COUNT (8u)  // 8 per-period FIFOs by default
+#endif
+
+
+/**
+ * Defines the number of expired timers that can be waiting for their handlers to be run by
+ * app_timer_dispatch_pending, must be a power of 2
+ * (only used when APP_TIMER_DEFERRED_DISPATCH is defined)
+ */
+#if !defined(APP_TIMER_DISPATCH_RING_SIZE)
+#define APP_TIMER_DISPATCH_RING_SIZE (16u)  // Up to 16 pending handlers by default
+#endif
+
+
+/**
+ * When APP_TIMER_DEFERRED_DISPATCH is defined, expired timers are passed from
+ * app_timer_target_count_reached to app_timer_dispatch_pending through a ring buffer whose
+ * head and tail indices are C11 atomics. Each side publishes its own index with a release
+ * store, and reads the other side's index with an acquire load, so the two functions may
+ * run on different CPU cores. This needs a C11 compiler with <stdatomic.h> (e.g. -std=c11),
+ * so APP_TIMER_DEFERRED_DISPATCH can't be used when building app_timer.c as C99 or C++.
+ */
+#if defined(APP_TIMER_DEFERRED_DISPATCH) && \
+    (!defined(__STDC_VERSION__) || (__STDC_VERSION__ < 201112L) || defined(__STDC_NO_ATOMICS__))
+#error "APP_TIMER_DEFERRED_DISPATCH requires C11 atomics, e.g. build with -std=c11"
+#endif
+
+
+/**
+ * Defines the number of log2-sized buckets in the expiry lateness histogram, must be at least 2
+ * (only used when APP_TIMER_LATENESS_STATS_ENABLE is defined)
+ */
+#if !defined(APP_TIMER_LATENESS_HISTOGRAM_BUCKETS)
+#define APP_TIMER_LATENESS_HISTOGRAM_BUCKETS (16u)  // Up to 16384 counts late in the last bucket by default
+#endif
+
+
 /**
  * Datatype used to represent the period for a timer (e.g. the 'time_from_now' parameter
  * passed to app_timer_start).
@@ -111,17 +185,13 @@ typedef uint32_t app_timer_count_t;
  * Datatype used to represent a running counter that tracks total elapsed time
  * since one or more active timers have been running continuously.
  *
- * You should pick this according to the expected lifetime of your system. Let's
- *  say, for example, that you are using a counter driven by a 32KHz clock; this
- * would mean using uint32_t for the running counter allows the app_timer module
- * to have timers running continuously for up to 2^32(-1) ticks, before the running
- * counter overflows. 2^32(-1) ticks at 32KHz is about 36 hours. Using
- * uint64_t for the running counter, so 2^64(-1) ticks before overflow, with the same
- * setup would get you over a million years before overflow.
- *
- * This running counter also gets reset to 0 when there are no active timers, so the overflow
- * condition will only occur when there have been one or more active timers continuously for
- * the maximum number of ticks.
+ * The running counter is allowed to overflow and wrap around; timestamps are compared
+ * using serial number arithmetic, so timers keep working across any number of wraps, as
+ * long as no single timer period is longer than half the range of the running counter
+ * (app_timer_start returns APP_TIMER_INVALID_PARAM for longer periods). You should pick
+ * this according to the longest timer period you need. Let's say, for example, that you
+ * are using a counter driven by a 32KHz clock; this would mean using uint32_t for the
+ * running counter allows timer periods of up to 2^31(-1) ticks, which is about 18 hours.
  */
 #if defined(APP_TIMER_RUNNING_COUNT_UINT32)
 typedef uint32_t app_timer_running_count_t;
@@ -159,7 +229,9 @@ typedef enum
     APP_TIMER_NULL_PARAM,           ///< NULL pointer passed as parameter
     APP_TIMER_INVALID_PARAM,        ///< Invalid data passed as parameter
     APP_TIMER_INVALID_STATE,        ///< Operation not allowed in current state (has app_timer_init been called?)
-    APP_TIMER_ERROR                 ///< Unspecified internal error
+    APP_TIMER_ERROR,                ///< Unspecified internal error
+    APP_TIMER_FULL,                 ///< No space for another active timer (APP_TIMER_ACTIVE_SET_HEAP only)
+    APP_TIMER_NO_ACTIVE_TIMERS      ///< No timers are active (app_timer_ticks_until_next_expiry only)
 } app_timer_error_e;
 
 
@@ -179,19 +251,35 @@ typedef enum
  */
 typedef struct _app_timer_t
 {
+#ifdef APP_TIMER_ABSOLUTE_DEADLINE
+    volatile app_timer_running_count_t expiry_counts; ///< Timer counts when timer will expire next
+#else
     volatile app_timer_running_count_t start_counts;  ///< Timer counts when timer was started
+#endif // APP_TIMER_ABSOLUTE_DEADLINE
     volatile app_timer_running_count_t total_counts;  ///< Total timer counts until the next expiry
     struct _app_timer_t *volatile next;               ///< Timer scheduled to expire after this one
     struct _app_timer_t *volatile previous;           ///< Timer scheduled to expire before this one
     app_timer_handler_t handler;                      ///< Handler to run on expiry
     void *context;                                    ///< Optional pointer to extra data
+#ifdef APP_TIMER_ACTIVE_SET_HEAP
+    uint32_t heap_index;                              ///< Position of timer in the heap of active timers
+#endif // APP_TIMER_ACTIVE_SET_HEAP
+#ifdef APP_TIMER_ACTIVE_SET_DELTA_LIST
+    app_timer_running_count_t delta_counts;           ///< Counts between expiry of previous timer and expiry of this timer
+#endif // APP_TIMER_ACTIVE_SET_DELTA_LIST
+#ifdef APP_TIMER_SLACK_ENABLE
+    app_timer_running_count_t slack_counts;           ///< Max. timer counts that the timer may expire late by, to share an interrupt with other timers
+#endif // APP_TIMER_SLACK_ENABLE
+#ifdef APP_TIMER_TOUCH_ENABLE
+    app_timer_running_count_t deadline_counts;        ///< Real expiry time in timer counts, may be later than the expiry time used to position the timer (see #app_timer_touch)
+#endif // APP_TIMER_TOUCH_ENABLE
 
     /**
      * Bit flags for timer
      *
      * Bits 0-1  : timer state, one of _timer_state_e (defined in app_timer.c)
      * Bits 2-3  : timer type, one of app_timer_type_e
-     * Bits 4-7  : unused
+     * Bits 4-7  : index of FIFO holding the timer (APP_TIMER_ACTIVE_SET_PERIOD_FIFO only), otherwise unused
      */
     volatile uint8_t flags;
 } app_timer_t;
@@ -267,9 +355,47 @@ typedef struct
      * The maximum value that the timer/counter can count up to before overflowing
      */
     app_timer_count_t max_count;
+
+    /**
+     * Convert timer counts to units (the reverse of #units_to_timer_counts). Optional, may be
+     * NULL; this is only used by #app_timer_units_until_next_expiry. The result should be
+     * rounded down, so that a caller sleeping for the returned time never oversleeps.
+     *
+     * @param counts  Number of timer counts
+     *
+     * @return Number of units in 'counts'
+     */
+    app_timer_period_t (*timer_counts_to_units)(app_timer_running_count_t counts);
 } app_timer_hw_model_t;
 
 
+#if defined(APP_TIMER_LATENESS_STATS_ENABLE) && !defined(APP_TIMER_STATS_ENABLE)
+#error "APP_TIMER_LATENESS_STATS_ENABLE requires APP_TIMER_STATS_ENABLE"
+#endif // APP_TIMER_LATENESS_STATS_ENABLE && !APP_TIMER_STATS_ENABLE
+
+#if defined(APP_TIMER_LATENESS_STATS_ENABLE) && (APP_TIMER_LATENESS_HISTOGRAM_BUCKETS < 2)
+#error "APP_TIMER_LATENESS_HISTOGRAM_BUCKETS must be at least 2"
+#endif // APP_TIMER_LATENESS_STATS_ENABLE
+
+#if defined(APP_TIMER_DURATION_STATS_ENABLE) && !defined(APP_TIMER_STATS_ENABLE)
+#error "APP_TIMER_DURATION_STATS_ENABLE requires APP_TIMER_STATS_ENABLE"
+#endif // APP_TIMER_DURATION_STATS_ENABLE && !APP_TIMER_STATS_ENABLE
+
+
+#ifdef APP_TIMER_DURATION_STATS_ENABLE
+/**
+ * Holds durations measured with hw_model->read_timer_counts, in timer counts. Durations
+ * that reach hw_model->max_count are recorded as max_count (see #num_duration_overruns).
+ */
+typedef struct
+{
+    uint32_t count;                 ///< Number of durations measured
+    uint64_t total;                 ///< Sum of all durations measured
+    app_timer_running_count_t max;  ///< Longest duration measured
+} app_timer_duration_t;
+#endif // APP_TIMER_DURATION_STATS_ENABLE
+
+
 #ifdef APP_TIMER_STATS_ENABLE
 /**
  * Holds information that can be collected about the current state of app_timer module
@@ -279,6 +405,39 @@ typedef struct
     uint32_t num_timers;                            ///< Number of active timers currently
     uint32_t num_timers_high_watermark;             ///< Max. number of active timers seen at once
     uint32_t num_expiry_overflows;                  ///< Number of times a timer expired while handling other timers
+#ifdef APP_TIMER_DEFERRED_DISPATCH
+    uint32_t num_dispatch_overflows;                ///< Number of times expired timers were left for the next interrupt, because the dispatch ring was full
+#endif // APP_TIMER_DEFERRED_DISPATCH
+#ifdef APP_TIMER_SLACK_ENABLE
+    uint32_t num_coalesced_expiries;                ///< Number of times a timer with slack expired in the same interrupt as an earlier timer
+#endif // APP_TIMER_SLACK_ENABLE
+#ifdef APP_TIMER_TOUCH_ENABLE
+    uint32_t num_touch_reinserts;                   ///< Number of times a timer reached its old expiry time after #app_timer_touch, and was re-inserted
+#endif // APP_TIMER_TOUCH_ENABLE
+#if defined(APP_TIMER_MAX_EXPIRIES_PER_INTERRUPT) || defined(APP_TIMER_MAX_COUNTS_PER_INTERRUPT)
+    uint32_t num_budget_exhausted;                  ///< Number of times #app_timer_target_count_reached left expired timers for the next interrupt
+#endif // APP_TIMER_MAX_EXPIRIES_PER_INTERRUPT || APP_TIMER_MAX_COUNTS_PER_INTERRUPT
+#ifdef APP_TIMER_LATENESS_STATS_ENABLE
+    /**
+     * Number of expired timers, by how many timer counts after their expiry time they were
+     * handled. Bucket 0 holds timers handled on time, bucket n (n > 0) holds timers handled
+     * 2^(n-1) to (2^n)-1 counts late, and the last bucket also holds all later timers.
+     */
+    uint32_t lateness_histogram[APP_TIMER_LATENESS_HISTOGRAM_BUCKETS];
+    uint32_t num_lateness_samples;                  ///< Number of expired timers counted in #lateness_histogram
+    uint64_t lateness_total;                        ///< Sum of the lateness of all expired timers, in timer counts
+    app_timer_running_count_t lateness_max;         ///< Max. lateness of an expired timer, in timer counts
+    app_timer_running_count_t lateness_mean;        ///< Mean lateness of all expired timers, in timer counts (rounded down)
+#endif // APP_TIMER_LATENESS_STATS_ENABLE
+#ifdef APP_TIMER_DURATION_STATS_ENABLE
+    app_timer_duration_t handler_duration;          ///< Time spent in each handler run by #app_timer_target_count_reached
+    app_timer_t *slowest_handler_timer;             ///< Timer whose handler took the longest to run (#handler_duration max)
+    app_timer_duration_t start_critical_duration;   ///< Time spent with interrupts disabled in each #app_timer_start call
+    app_timer_duration_t stop_critical_duration;    ///< Time spent with interrupts disabled in each #app_timer_stop call
+    app_timer_duration_t target_count_reached_critical_duration; ///< Time spent with interrupts disabled in each #app_timer_target_count_reached call
+    app_timer_duration_t target_count_reached_duration;          ///< Time spent in each #app_timer_target_count_reached call
+    uint32_t num_duration_overruns;                 ///< Number of durations that reached hw_model->max_count, and were recorded as max_count
+#endif // APP_TIMER_DURATION_STATS_ENABLE
     app_timer_t *next_active_timer;                 ///< Active timer instance that will expire next
     app_timer_running_count_t running_timer_count;  ///< Current _running_timer_count value
     bool inside_target_count_reached;               ///< True if app_timer_target_count_reached is in progress
@@ -286,16 +445,232 @@ typedef struct
 #endif // APP_TIMER_STATS_ENABLE
 
 
+/*
+ * The data structures below hold the state of an app_timer_ctx_t instance. They are only
+ * defined here so that app_timer_ctx_t instances can be allocated by the application (e.g.
+ * statically), and should not be accessed directly.
+ */
+
+/**
+ * Represents a doubly-linked list of app_timer_t instances
+ */
+typedef struct
+{
+    app_timer_t *head;
+    app_timer_t *tail;
+} _app_timer_list_t;
+
+
+#if defined(APP_TIMER_ACTIVE_SET_SORTED_LIST)
+
+/**
+ * The list of active timers stores all timer instances that have been started with
+ * 'app_timer_start' but not yet expired, next to expire at the head
+ */
+typedef _app_timer_list_t _app_timer_active_set_t;
+
+#elif defined(APP_TIMER_ACTIVE_SET_TIMING_WHEEL)
+
+#if (APP_TIMER_WHEEL_SLOT_BITS < 1) || (APP_TIMER_WHEEL_SLOT_BITS > 5)
+#error "APP_TIMER_WHEEL_SLOT_BITS must be between 1 and 5"
+#endif // APP_TIMER_WHEEL_SLOT_BITS
+
+/**
+ * Number of slots in each level of the timing wheel
+ */
+#define APP_TIMER_WHEEL_SLOT_COUNT (1u << APP_TIMER_WHEEL_SLOT_BITS)
+
+/**
+ * Number of levels required for the timing wheel to span the full range of app_timer_running_count_t
+ */
+#define APP_TIMER_WHEEL_LEVEL_COUNT \
+    (((sizeof(app_timer_running_count_t) * 8u) + (APP_TIMER_WHEEL_SLOT_BITS - 1u)) / APP_TIMER_WHEEL_SLOT_BITS)
+
+
+/**
+ * Hierarchical timing wheel holding all active timers.
+ *
+ * Timers are placed in a slot according to their expiry time, relative to the 'now'
+ * timestamp of the wheel. The level of a timer is the most significant group of
+ * APP_TIMER_WHEEL_SLOT_BITS bits in which its expiry time differs from 'now', and the slot
+ * is the value of that group in the expiry time. This means that all timers in level 0
+ * expire before all timers in level 1, and so on, and within a level, lower slots expire
+ * before higher slots. Timers in a level 0 slot all share the same expiry time.
+ *
+ * 'now' is only moved forward as timers expire, and whenever 'now' crosses into a new
+ * slot of a higher level, the timers in that slot are cascaded down into the lower levels.
+ */
+typedef struct
+{
+    _app_timer_list_t slots[APP_TIMER_WHEEL_LEVEL_COUNT][APP_TIMER_WHEEL_SLOT_COUNT];  ///< Timers in each slot, in order of insertion
+    uint32_t occupied_slots[APP_TIMER_WHEEL_LEVEL_COUNT];                          ///< Bit N is set if slot N of a level holds any timers
+    app_timer_running_count_t occupied_levels;                                     ///< Bit N is set if level N holds any timers (one bit per bit of app_timer_running_count_t is always enough)
+    app_timer_running_count_t now;                                                 ///< Timestamp that slot positions are relative to
+    app_timer_t *next;                                                             ///< Cached next timer to expire, NULL if not yet known
+} _app_timer_active_set_t;
+
+#elif defined(APP_TIMER_ACTIVE_SET_HEAP)
+
+#if (APP_TIMER_HEAP_CAPACITY < 1)
+#error "APP_TIMER_HEAP_CAPACITY must be at least 1"
+#endif // APP_TIMER_HEAP_CAPACITY
+
+/**
+ * Binary min-heap of active timers, keyed on expiry time, stored in a fixed-size array.
+ * Each timer stores its own position in the array (#heap_index), so that any timer can be
+ * removed without searching for it.
+ */
+typedef struct
+{
+    app_timer_t *timers[APP_TIMER_HEAP_CAPACITY];  ///< Heap array, next timer to expire is always at index 0
+    uint32_t count;                                ///< Number of timers in the heap
+} _app_timer_active_set_t;
+
+#elif defined(APP_TIMER_ACTIVE_SET_PERIOD_FIFO)
+
+#if (APP_TIMER_PERIOD_FIFO_COUNT < 1) || (APP_TIMER_PERIOD_FIFO_COUNT > 15)
+#error "APP_TIMER_PERIOD_FIFO_COUNT must be between 1 and 15"
+#endif // APP_TIMER_PERIOD_FIFO_COUNT
+
+/**
+ * Holds active timers that share the same period, in order of expiry time
+ */
+typedef struct _app_timer_period_fifo_t
+{
+    _app_timer_list_t timers;                        ///< Active timers in this FIFO, next to expire at the head
+    app_timer_running_count_t period;                ///< Period (total_counts) of all timers in this FIFO
+    struct _app_timer_period_fifo_t *next;           ///< FIFO whose head timer expires after the head timer of this one
+    struct _app_timer_period_fifo_t *previous;       ///< FIFO whose head timer expires before the head timer of this one
+} _app_timer_period_fifo_t;
+
+
+/**
+ * Set of per-period FIFOs holding all active timers.
+ *
+ * A timer started later than another timer with the same period will also expire later,
+ * so timers are normally just appended to the tail of the FIFO for their period. Non-empty
+ * FIFOs are kept in a doubly-linked list (the index), in ascending order of the expiry time
+ * of their head timers, so the next timer to expire is always the head of the first FIFO.
+ *
+ * The last FIFO is an overflow FIFO, for timers whose period does not match any other FIFO
+ * when all other FIFOs are in use. Timers of any period can be mixed in the overflow FIFO,
+ * so inserting a timer there may require walking the whole FIFO, like the sorted list.
+ */
+typedef struct
+{
+    _app_timer_period_fifo_t fifos[APP_TIMER_PERIOD_FIFO_COUNT + 1u];  ///< Per-period FIFOs, followed by the overflow FIFO
+    _app_timer_period_fifo_t *head;                                   ///< FIFO containing the next timer to expire
+} _app_timer_active_set_t;
+
+#elif defined(APP_TIMER_ACTIVE_SET_DELTA_LIST)
+
+/**
+ * Delta-encoded list of active timers. Timers are kept in ascending order of expiry time,
+ * like the sorted list, but each timer stores the number of counts between the expiry of
+ * the timer before it and its own expiry (#delta_counts), and only the expiry time of the
+ * head timer is stored as an absolute timestamp. Inserting a timer just subtracts deltas
+ * while walking the list, and removing a timer only touches the timer after it.
+ */
+typedef struct
+{
+    _app_timer_list_t timers;              ///< Active timers, next to expire at the head
+    app_timer_running_count_t head_expiry; ///< Expiry time of the head timer, in timer counts
+} _app_timer_active_set_t;
+
+#else
+#error "Active timer set data structure is not defined"
+#endif // APP_TIMER_ACTIVE_SET_*
+
+
+#ifdef APP_TIMER_DEFERRED_DISPATCH
+
+#if (0u == APP_TIMER_DISPATCH_RING_SIZE) || (0u != (APP_TIMER_DISPATCH_RING_SIZE & (APP_TIMER_DISPATCH_RING_SIZE - 1u)))
+#error "APP_TIMER_DISPATCH_RING_SIZE must be a power of 2"
+#endif // APP_TIMER_DISPATCH_RING_SIZE
+
+/**
+ * Single-producer, single-consumer ring of expired timers waiting for their handlers to be
+ * run. Only app_timer_target_count_reached writes to #head, and only app_timer_dispatch_pending
+ * writes to #tail; both are free-running, and wrapped with a mask when indexing #timers.
+ */
+typedef struct
+{
+    app_timer_t *timers[APP_TIMER_DISPATCH_RING_SIZE];  ///< Expired timers, oldest at #tail
+    _Atomic uint32_t head;                              ///< Number of timers pushed
+    _Atomic uint32_t tail;                              ///< Number of timers popped
+} _app_timer_dispatch_ring_t;
+#endif // APP_TIMER_DEFERRED_DISPATCH
+
+
+/**
+ * Holds all state for one set of timers driven by one hardware timer/counter (a timer
+ * context). Each context has its own hardware model, its own set of active timers and its
+ * own critical section (via the 'set_interrupts_enabled' function of its hardware model), so
+ * separate contexts can be driven by separate timer/counters, or run on separate cores,
+ * without sharing anything. A timer instance must only be used with one context at a time.
+ *
+ * All fields are for internal use only; use the app_timer_ctx_* functions to access a context.
+ */
+typedef struct
+{
+    volatile _app_timer_active_set_t active_timers;         ///< Set of timers that have been started but not yet expired
+    volatile app_timer_running_count_t running_timer_count; ///< Total elapsed timer counts, regardless of overflows, while there are active timers
+    volatile app_timer_count_t last_timer_period;           ///< The last value that was passed to set_timer_period_counts
+    volatile app_timer_count_t counts_after_last_start;     ///< Hardware timer/counter value after it was last started (some timer/counters do not start counting from 0)
+    volatile bool inside_target_count_reached;              ///< True when app_timer_ctx_target_count_reached is executing
+    bool initialized;                                       ///< True when app_timer_ctx_init has completed successfully
+    app_timer_hw_model_t *hw_model;                         ///< Pointer to the hardware model in use
+#ifdef APP_TIMER_DEFERRED_DISPATCH
+    _app_timer_dispatch_ring_t dispatch_ring;               ///< Expired timers waiting for app_timer_ctx_dispatch_pending
+#endif // APP_TIMER_DEFERRED_DISPATCH
+#ifdef APP_TIMER_STATS_ENABLE
+    app_timer_stats_t stats;                                ///< Runtime info for app_timer_ctx_stats
+#endif // APP_TIMER_STATS_ENABLE
+} app_timer_ctx_t;
+
+
 /**
  * This function must be called whenever the timer/counter period set by the
  * last call to set_timer_period_counts (in the hardware model) has elapsed. For example,
  * If you are implementing an interrupt-driven app_timer layer, you probably want to
  * call this function inside the interrupt handler for expiration of the timer/counter
  * peripheral you are using.
+ *
+ * If APP_TIMER_MAX_EXPIRIES_PER_INTERRUPT or APP_TIMER_MAX_COUNTS_PER_INTERRUPT is defined,
+ * then at most that many expired timers are handled (or, handling stops once that many
+ * timer counts have elapsed since this function was called), and the timer/counter is
+ * configured to expire again after 1 count to handle the remaining expired timers.
  */
 void app_timer_target_count_reached(void);
 
 
+#ifdef APP_TIMER_DEFERRED_DISPATCH
+/**
+ * Run the handlers of all timers that have expired since the last call. Only available
+ * when APP_TIMER_DEFERRED_DISPATCH is defined, in which case #app_timer_target_count_reached
+ * does not run any handlers; it only removes expired timers from the set of active timers
+ * (and re-starts repeating timers), and queues the expired timers on a ring buffer of
+ * APP_TIMER_DISPATCH_RING_SIZE entries. This function should be called from the main loop,
+ * or from a thread, to empty the ring buffer and run the handlers.
+ *
+ * The ring buffer has a single producer (#app_timer_target_count_reached) and a single
+ * consumer (this function), so interrupts are not disabled here, and this function must not
+ * be called from more than one context at once. It may run on a different CPU core than
+ * #app_timer_target_count_reached (see APP_TIMER_DISPATCH_RING_SIZE). Handlers are never run
+ * by #app_timer_target_count_reached; if the ring buffer is full when a timer expires, then
+ * that timer stays active, and the counter is re-configured for 1 tick so that it is queued
+ * in a later interrupt, once this function has made space.
+ *
+ * If a timer is stopped by #app_timer_stop after it has expired, but before its handler has
+ * been run by this function, then the handler is not run. A timer that is started again in
+ * that time still has its handler run for the earlier expiration.
+ *
+ * @return #APP_TIMER_OK if successful
+ */
+app_timer_error_e app_timer_dispatch_pending(void);
+#endif // APP_TIMER_DEFERRED_DISPATCH
+
+
 /**
  * Initialize a timer instance. Must be called at least once before a timer can be
  * started with #app_timer_start.
@@ -327,6 +702,8 @@ app_timer_error_e app_timer_create(app_timer_t *timer, app_timer_handler_t handl
  * @param time_from_now  Timer expiration time, relative to now, in units determined by the
  *                       hardware model in use (the units_to_timer_ticks function in the hardware
  *                       model is responsible for converting this value to timer/counter ticks).
+ *                       Must be less than half the range of app_timer_running_count_t, once
+ *                       converted to timer/counter ticks.
 
  * @param context        Optional pointer to pass to handler function when it is called.
  *
@@ -335,6 +712,60 @@ app_timer_error_e app_timer_create(app_timer_t *timer, app_timer_handler_t handl
 app_timer_error_e app_timer_start(app_timer_t *timer, app_timer_period_t time_from_now, void *context);
 
 
+#ifdef APP_TIMER_SLACK_ENABLE
+/**
+ * Start a timer instance, allowing it to expire up to 'slack' later than requested.
+ *
+ * Instead of expiring exactly at 'time_from_now', the timer expires at the time within
+ * ['time_from_now', 'time_from_now' + 'slack'] that is most aligned (has the most trailing
+ * zero bits in timer counts). Timers whose windows overlap are likely to be aligned to the
+ * same time, and expire in the same interrupt, which reduces the number of wakeups.
+ *
+ * The slack is stored in the timer, and also applies to later expirations of a repeating
+ * timer, and when the timer is started again by #app_timer_start, #app_timer_start_many or
+ * #app_timer_restart. Pass 0 for 'slack' to make the timer exact again. Note that the period
+ * of a repeating timer is measured from when it actually expired, so each expiration may
+ * drift by up to 'slack' from the previous one.
+ *
+ * @param timer          Pointer to timer instance to start. Must have already been
+ *                       initialized by #app_timer_create.
+ * @param time_from_now  Timer expiration time, relative to now (see 'time_from_now'
+ *                       parameter of #app_timer_start)
+ * @param slack          Max. time the timer may expire late by, in the same units as
+ *                       'time_from_now'
+ * @param context        Optional pointer to pass to handler function
+ *
+ * @return #APP_TIMER_OK if successful
+ */
+app_timer_error_e app_timer_start_slack(app_timer_t *timer, app_timer_period_t time_from_now,
+                                        app_timer_period_t slack, void *context);
+#endif // APP_TIMER_SLACK_ENABLE
+
+
+/**
+ * Start many timers at once. Equivalent to calling #app_timer_start for each timer, except that
+ * interrupts are only disabled once for the whole batch, all timers in the batch are started at
+ * the same time, and the hardware timer/counter is re-configured at most once. All timer periods
+ * are converted to timer counts before interrupts are disabled.
+ *
+ * Timers in the batch that have already been started are not affected. If any timer period is
+ * zero or too long, then no timers are started and #APP_TIMER_INVALID_PARAM is returned. If there
+ * is no space for another active timer (APP_TIMER_ACTIVE_SET_HEAP only), then that timer is
+ * skipped, the remaining timers are still started, and #APP_TIMER_FULL is returned.
+ *
+ * @param timers    Array of pointers to timer instances to start. Each must have already been
+ *                  initialized by #app_timer_create.
+ * @param periods   Array of timer expiration times, relative to now, one for each timer (see
+ *                  'time_from_now' parameter of #app_timer_start)
+ * @param contexts  Array of optional pointers to pass to handler functions, one for each timer.
+ *                  May be NULL, in which case all handlers are passed NULL.
+ * @param n         Number of timers in the batch
+ *
+ * @return #APP_TIMER_OK if successful
+ */
+app_timer_error_e app_timer_start_many(app_timer_t **timers, const app_timer_period_t *periods, void **contexts, size_t n);
+
+
 /**
  * Stop a running timer instance.
  *
@@ -345,6 +776,82 @@ app_timer_error_e app_timer_start(app_timer_t *timer, app_timer_period_t time_fr
 app_timer_error_e app_timer_stop(app_timer_t *timer);
 
 
+/**
+ * Restart a timer instance with a new expiration time, whether it is running or not.
+ *
+ * Unlike calling #app_timer_stop followed by #app_timer_start, the timer is moved to its
+ * new position in the set of active timers inside a single critical section, and the
+ * hardware timer/counter is only re-configured if the timer was, or becomes, the next
+ * timer to expire. If the timer is not running, this behaves like #app_timer_start.
+ *
+ * @param timer          Pointer to timer instance to restart. Must have already been
+ *                       initialized by #app_timer_create.
+ * @param time_from_now  New timer expiration time, relative to now (see 'time_from_now'
+ *                       parameter of #app_timer_start)
+ * @param context        Optional pointer to pass to the handler function, replacing the
+ *                       context passed when the timer was started
+ *
+ * @return #APP_TIMER_OK if successful
+ */
+app_timer_error_e app_timer_restart(app_timer_t *timer, app_timer_period_t time_from_now, void *context);
+
+
+#ifdef APP_TIMER_TOUCH_ENABLE
+/**
+ * Extend the expiration time of a running timer instance, e.g. for a watchdog or keep-alive
+ * timer that is pushed out every time a message is received.
+ *
+ * If the new expiration time is later than the current one, then it is only recorded in the
+ * timer, in constant time, and the timer is not moved within the set of active timers. When
+ * the timer reaches its old expiration time, it is re-inserted at the new expiration time
+ * instead of running the handler. If the new expiration time is earlier than the current
+ * one, then the timer is moved, in the same way as #app_timer_restart. Either way, a
+ * repeating timer will use the new expiration time as its period from then on, and the
+ * context pointer passed to the handler is not changed. A timer that is not running (stopped,
+ * or expired and not re-started) is not started; use #app_timer_start for that.
+ *
+ * @param timer          Pointer to timer instance to extend. Must have already been
+ *                       initialized by #app_timer_create.
+ * @param time_from_now  New timer expiration time, relative to now (see 'time_from_now'
+ *                       parameter of #app_timer_start)
+ *
+ * @return #APP_TIMER_OK if successful, #APP_TIMER_INVALID_STATE if the timer is not running
+ */
+app_timer_error_e app_timer_touch(app_timer_t *timer, app_timer_period_t time_from_now);
+#endif // APP_TIMER_TOUCH_ENABLE
+
+
+/**
+ * Stop a batch of running timer instances.
+ *
+ * All timers are removed from the set of active timers while interrupts are disabled,
+ * and the hardware timer/counter is re-configured at most once, after the whole batch has
+ * been stopped (instead of once per timer, as with repeated calls to #app_timer_stop).
+ * Timers in the batch that are already stopped are ignored. If any timer pointer is NULL,
+ * no timers are stopped.
+ *
+ * @param timers  Array of pointers to timer instances to stop
+ * @param n       Number of timers in the batch
+ *
+ * @return #APP_TIMER_OK if successful
+ */
+app_timer_error_e app_timer_stop_many(app_timer_t **timers, size_t n);
+
+
+/**
+ * Stop all running timer instances.
+ *
+ * All active timers are removed while interrupts are disabled, and the hardware
+ * timer/counter is stopped once at the end. Note that if this is called from a timer
+ * handler, the timer whose handler is running is not affected (a repeating timer will
+ * still be restarted when its handler returns, unless the handler calls #app_timer_stop
+ * on it).
+ *
+ * @return #APP_TIMER_OK if successful
+ */
+app_timer_error_e app_timer_stop_all(void);
+
+
 /**
  * Checks whether a timer instance is active. This has different meanings depending
  * on the timer type;
@@ -364,6 +871,35 @@ app_timer_error_e app_timer_stop(app_timer_t *timer);
 app_timer_error_e app_timer_is_active(app_timer_t *timer, bool *is_active);
 
 
+/**
+ * Fetch the number of timer counts until the next active timer expires. This is intended
+ * for tickless idle; a polling loop or RTOS idle hook can sleep for this long, and then call
+ * app_timer_target_count_reached (or poll the counter) when it wakes up.
+ *
+ * The result is measured from the time of this call, and is 0 if the next timer has already
+ * expired but has not been handled yet. If the next timer expires further away than
+ * hw_model.max_count, then the result is also larger than hw_model.max_count; the counter
+ * will still interrupt (or be polled as expired) at least every max_count counts before then.
+ *
+ * @param ticks  Pointer to location to store number of timer counts until next expiry
+ *
+ * @return #APP_TIMER_OK if successful, #APP_TIMER_NO_ACTIVE_TIMERS if no timers are active
+ */
+app_timer_error_e app_timer_ticks_until_next_expiry(app_timer_running_count_t *ticks);
+
+
+/**
+ * Same as #app_timer_ticks_until_next_expiry, but the result is converted to units with
+ * hw_model.timer_counts_to_units (rounded down).
+ *
+ * @param units  Pointer to location to store number of units until next expiry
+ *
+ * @return #APP_TIMER_OK if successful, #APP_TIMER_NO_ACTIVE_TIMERS if no timers are active,
+ *         #APP_TIMER_INVALID_STATE if hw_model.timer_counts_to_units is NULL
+ */
+app_timer_error_e app_timer_units_until_next_expiry(app_timer_period_t *units);
+
+
 /**
  * Initialize the app_timer module.
  *
@@ -385,6 +921,190 @@ app_timer_error_e app_timer_init(app_timer_hw_model_t *model);
 app_timer_error_e app_timer_stats(app_timer_stats_t *stats);
 #endif // APP_TIMER_STATS_ENABLE
 
+
+/*
+ * The functions below work the same way as the functions above, except that they act on a
+ * specific timer context, instead of the default timer context used by the functions above.
+ * Each context must be initialized by #app_timer_ctx_init, with its own hardware model, and
+ * #app_timer_ctx_target_count_reached must be called for a context whenever the timer/counter
+ * period set by its hardware model has elapsed. A timer instance must only be passed to
+ * functions for the context it was created with.
+ */
+
+/**
+ * Initialize a timer context. The context must be zero-initialized before the first call
+ * (e.g. by declaring it static). If the context has already been initialized, then nothing
+ * is done and #APP_TIMER_OK is returned, so any active timers are kept.
+ *
+ * @param ctx    Pointer to timer context to initialize
+ * @param model  Pointer to timer hardware model to use for this context
+ *
+ * @return #APP_TIMER_OK if successful
+ */
+app_timer_error_e app_timer_ctx_init(app_timer_ctx_t *ctx, app_timer_hw_model_t *model);
+
+
+/**
+ * Same as #app_timer_target_count_reached, for a specific timer context
+ *
+ * @param ctx  Pointer to timer context whose timer/counter period has elapsed
+ */
+void app_timer_ctx_target_count_reached(app_timer_ctx_t *ctx);
+
+
+#ifdef APP_TIMER_DEFERRED_DISPATCH
+/**
+ * Same as #app_timer_dispatch_pending, for a specific timer context
+ *
+ * @param ctx  Pointer to timer context
+ *
+ * @return #APP_TIMER_OK if successful
+ */
+app_timer_error_e app_timer_ctx_dispatch_pending(app_timer_ctx_t *ctx);
+#endif // APP_TIMER_DEFERRED_DISPATCH
+
+
+/**
+ * Same as #app_timer_create, for a specific timer context
+ *
+ * @param ctx  Pointer to timer context
+ *
+ * @return #APP_TIMER_OK if successful
+ */
+app_timer_error_e app_timer_ctx_create(app_timer_ctx_t *ctx, app_timer_t *timer, app_timer_handler_t handler,
+                                       app_timer_type_e type);
+
+
+/**
+ * Same as #app_timer_start, for a specific timer context
+ *
+ * @param ctx  Pointer to timer context
+ *
+ * @return #APP_TIMER_OK if successful
+ */
+app_timer_error_e app_timer_ctx_start(app_timer_ctx_t *ctx, app_timer_t *timer, app_timer_period_t time_from_now,
+                                      void *context);
+
+
+#ifdef APP_TIMER_SLACK_ENABLE
+/**
+ * Same as #app_timer_start_slack, for a specific timer context
+ *
+ * @param ctx  Pointer to timer context
+ *
+ * @return #APP_TIMER_OK if successful
+ */
+app_timer_error_e app_timer_ctx_start_slack(app_timer_ctx_t *ctx, app_timer_t *timer, app_timer_period_t time_from_now,
+                                            app_timer_period_t slack, void *context);
+#endif // APP_TIMER_SLACK_ENABLE
+
+
+/**
+ * Same as #app_timer_start_many, for a specific timer context
+ *
+ * @param ctx  Pointer to timer context
+ *
+ * @return #APP_TIMER_OK if successful
+ */
+app_timer_error_e app_timer_ctx_start_many(app_timer_ctx_t *ctx, app_timer_t **timers, const app_timer_period_t *periods,
+                                           void **contexts, size_t n);
+
+
+/**
+ * Same as #app_timer_stop, for a specific timer context
+ *
+ * @param ctx  Pointer to timer context
+ *
+ * @return #APP_TIMER_OK if successful
+ */
+app_timer_error_e app_timer_ctx_stop(app_timer_ctx_t *ctx, app_timer_t *timer);
+
+
+/**
+ * Same as #app_timer_restart, for a specific timer context
+ *
+ * @param ctx  Pointer to timer context
+ *
+ * @return #APP_TIMER_OK if successful
+ */
+app_timer_error_e app_timer_ctx_restart(app_timer_ctx_t *ctx, app_timer_t *timer, app_timer_period_t time_from_now,
+                                        void *context);
+
+
+#ifdef APP_TIMER_TOUCH_ENABLE
+/**
+ * Same as #app_timer_touch, for a specific timer context
+ *
+ * @param ctx  Pointer to timer context
+ *
+ * @return #APP_TIMER_OK if successful
+ */
+app_timer_error_e app_timer_ctx_touch(app_timer_ctx_t *ctx, app_timer_t *timer, app_timer_period_t time_from_now);
+#endif // APP_TIMER_TOUCH_ENABLE
+
+
+/**
+ * Same as #app_timer_stop_many, for a specific timer context
+ *
+ * @param ctx  Pointer to timer context
+ *
+ * @return #APP_TIMER_OK if successful
+ */
+app_timer_error_e app_timer_ctx_stop_many(app_timer_ctx_t *ctx, app_timer_t **timers, size_t n);
+
+
+/**
+ * Same as #app_timer_stop_all, for a specific timer context. Timers in other contexts are
+ * not affected.
+ *
+ * @param ctx  Pointer to timer context
+ *
+ * @return #APP_TIMER_OK if successful
+ */
+app_timer_error_e app_timer_ctx_stop_all(app_timer_ctx_t *ctx);
+
+
+/**
+ * Same as #app_timer_is_active, for a specific timer context
+ *
+ * @param ctx  Pointer to timer context
+ *
+ * @return #APP_TIMER_OK if successful
+ */
+app_timer_error_e app_timer_ctx_is_active(app_timer_ctx_t *ctx, app_timer_t *timer, bool *is_active);
+
+
+/**
+ * Same as #app_timer_ticks_until_next_expiry, for a specific timer context
+ *
+ * @param ctx  Pointer to timer context
+ *
+ * @return #APP_TIMER_OK if successful
+ */
+app_timer_error_e app_timer_ctx_ticks_until_next_expiry(app_timer_ctx_t *ctx, app_timer_running_count_t *ticks);
+
+
+/**
+ * Same as #app_timer_units_until_next_expiry, for a specific timer context
+ *
+ * @param ctx  Pointer to timer context
+ *
+ * @return #APP_TIMER_OK if successful
+ */
+app_timer_error_e app_timer_ctx_units_until_next_expiry(app_timer_ctx_t *ctx, app_timer_period_t *units);
+
+
+#ifdef APP_TIMER_STATS_ENABLE
+/**
+ * Same as #app_timer_stats, for a specific timer context
+ *
+ * @param ctx  Pointer to timer context
+ *
+ * @return #APP_TIMER_OK if successful
+ */
+app_timer_error_e app_timer_ctx_stats(app_timer_ctx_t *ctx, app_timer_stats_t *stats);
+#endif // APP_TIMER_STATS_ENABLE
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,484 @@
+/**
+ * Measures how the cost of app_timer_start, app_timer_stop and app_timer_target_count_reached
+ * scales with the number of active timers.
+ *
+ * For each number of timers N (1, 10, 100 ... BENCH_MAX_TIMERS) and each pattern of timer
+ * periods (random, ascending and descending in the order the timers are started), the
+ * following operations are measured, each one individually with clock_gettime:
+ *
+ * - start:  app_timer_start, for N single-shot timers, starting with no active timers
+ * - stop:   app_timer_stop, for all N active timers, in random order
+ * - expire: app_timer_target_count_reached, called at the end of each counter period until
+ *           all N timers have expired (ascending and descending periods are all different, so
+ *           each call handles one expired timer; random periods can be the same, so some calls
+ *           handle more than one)
+ *
+ * The hardware model uses a software variable as the counter, so no time is spent waiting for
+ * timers to expire, and counts how many times each hardware model function is called.
+ *
+ * Results are written as CSV, to the file named by the first argument (or stdout), one row per
+ * variant, pattern, N and operation, so that runs from different commits can be compared.
+ * Per-operation times have the measured overhead of clock_gettime subtracted.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <time.h>
+
+#include "app_timer_api.h"
+
+
+#ifndef BENCH_VARIANT
+#define BENCH_VARIANT "default"      ///< Name of this build, written to every row of the output
+#endif // BENCH_VARIANT
+
+#ifndef BENCH_MAX_TIMERS
+#define BENCH_MAX_TIMERS (1000000u)  ///< Largest number of timers to measure
+#endif // BENCH_MAX_TIMERS
+
+#ifndef BENCH_MIN_OPS
+#define BENCH_MIN_OPS (10000u)       ///< Repeat each measurement until at least this many operations are timed
+#endif // BENCH_MIN_OPS
+
+#ifndef BENCH_TIME_LIMIT_MS
+#define BENCH_TIME_LIMIT_MS (10000u) ///< Skip the next N if it might take longer than this (assuming O(N^2) cost)
+#endif // BENCH_TIME_LIMIT_MS
+
+#define PERIOD_BASE_COUNTS (1000u)   ///< Shortest timer period, in timer counts
+#define PERIOD_STEP_COUNTS (16u)     ///< Difference between adjacent timer periods, in timer counts
+
+
+/**
+ * Patterns of timer periods, in the order that timers are started
+ */
+typedef enum
+{
+    PATTERN_RANDOM,
+    PATTERN_ASCENDING,
+    PATTERN_DESCENDING,
+    PATTERN_COUNT
+} pattern_e;
+
+
+/**
+ * Operations that are measured
+ */
+typedef enum
+{
+    OP_START,
+    OP_STOP,
+    OP_EXPIRE,
+    OP_COUNT
+} op_e;
+
+
+/**
+ * Number of calls to each hardware model function
+ */
+typedef struct
+{
+    uint64_t read_timer_counts;
+    uint64_t set_timer_period_counts;
+    uint64_t set_timer_running;
+    uint64_t set_interrupts_enabled;
+} hw_calls_t;
+
+
+/**
+ * Results collected for one operation
+ */
+typedef struct
+{
+    uint32_t *samples_ns;    ///< Time taken by each operation, nanoseconds
+    uint64_t capacity;       ///< Number of samples that fit in samples_ns
+    uint64_t count;          ///< Number of operations timed
+    hw_calls_t hw_calls;     ///< Hardware model calls made by all operations
+} op_results_t;
+
+
+static const char *_pattern_names[PATTERN_COUNT] = {"random", "ascending", "descending"};
+static const char *_op_names[OP_COUNT] = {"start", "stop", "expire"};
+
+
+static uint64_t _now_counts = 0u;
+static uint64_t _period_start_counts = 0u;
+static app_timer_count_t _period_counts = 0u;
+static bool _running = false;
+static hw_calls_t _hw_calls;
+
+static uint64_t _clock_overhead_ns = 0u;
+static uint64_t _expirations = 0u;
+
+
+static bool _init(void)
+{
+    return true;
+}
+
+
+static app_timer_running_count_t _units_to_timer_counts(app_timer_period_t units)
+{
+    return (app_timer_running_count_t) units;
+}
+
+
+static app_timer_count_t _read_timer_counts(void)
+{
+    _hw_calls.read_timer_counts += 1u;
+    return (app_timer_count_t) (_now_counts - _period_start_counts);
+}
+
+
+static void _set_timer_period_counts(app_timer_count_t counts)
+{
+    _hw_calls.set_timer_period_counts += 1u;
+    _period_counts = counts;
+    _period_start_counts = _now_counts;
+}
+
+
+static void _set_timer_running(bool enabled)
+{
+    _hw_calls.set_timer_running += 1u;
+    _running = enabled;
+}
+
+
+static void _set_interrupts_enabled(bool enabled, app_timer_int_status_t *int_status)
+{
+    _hw_calls.set_interrupts_enabled += 1u;
+}
+
+
+// Hardware model definition
+static app_timer_hw_model_t _bench_hw_model = {
+    .init = _init,
+    .units_to_timer_counts = _units_to_timer_counts,
+    .read_timer_counts = _read_timer_counts,
+    .set_timer_period_counts = _set_timer_period_counts,
+    .set_timer_running = _set_timer_running,
+    .set_interrupts_enabled = _set_interrupts_enabled,
+    .max_count = (app_timer_count_t) 0xffffffffu
+};
+
+
+static void _expiry_handler(void *context)
+{
+    _expirations += 1u;
+}
+
+
+static inline uint64_t _nsecs_now(void)
+{
+    struct timespec ts = {.tv_sec=0, .tv_nsec=0};
+    (void) clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (((uint64_t) ts.tv_sec) * 1000000000ULL) + ((uint64_t) ts.tv_nsec);
+}
+
+
+// xorshift64, so that random periods and stop order are the same on every run
+static uint64_t _next_random(void)
+{
+    static uint64_t state = 88172645463325252ULL;
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+
+static int _compare_uint32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *) a;
+    uint32_t y = *(const uint32_t *) b;
+    return (x > y) - (x < y);
+}
+
+
+// Smallest difference between two consecutive clock_gettime calls, nanoseconds
+static uint64_t _measure_clock_overhead(void)
+{
+    uint64_t lowest = UINT64_MAX;
+
+    for (uint32_t i = 0u; i < 100000u; i++)
+    {
+        uint64_t before = _nsecs_now();
+        uint64_t diff = _nsecs_now() - before;
+
+        if (diff < lowest)
+        {
+            lowest = diff;
+        }
+    }
+
+    return lowest;
+}
+
+
+// Records the time taken by one operation
+static inline void _add_sample(op_results_t *results, uint64_t before_ns, uint64_t after_ns)
+{
+    if (results->count >= results->capacity)
+    {
+        return;
+    }
+
+    uint64_t ns = after_ns - before_ns;
+    ns = (ns > _clock_overhead_ns) ? (ns - _clock_overhead_ns) : 0u;
+    results->samples_ns[results->count] = (ns > UINT32_MAX) ? UINT32_MAX : (uint32_t) ns;
+    results->count += 1u;
+}
+
+
+static void _add_hw_calls(hw_calls_t *total, const hw_calls_t *before)
+{
+    total->read_timer_counts += _hw_calls.read_timer_counts - before->read_timer_counts;
+    total->set_timer_period_counts += _hw_calls.set_timer_period_counts - before->set_timer_period_counts;
+    total->set_timer_running += _hw_calls.set_timer_running - before->set_timer_running;
+    total->set_interrupts_enabled += _hw_calls.set_interrupts_enabled - before->set_interrupts_enabled;
+}
+
+
+static void _start_all(app_timer_t *timers, const app_timer_period_t *periods, uint32_t n, op_results_t *results)
+{
+    hw_calls_t before = _hw_calls;
+
+    for (uint32_t i = 0u; i < n; i++)
+    {
+        uint64_t before_ns = (NULL == results) ? 0u : _nsecs_now();
+        (void) app_timer_start(&timers[i], periods[i], NULL);
+
+        if (NULL != results)
+        {
+            _add_sample(results, before_ns, _nsecs_now());
+        }
+    }
+
+    if (NULL != results)
+    {
+        _add_hw_calls(&results->hw_calls, &before);
+    }
+}
+
+
+static void _stop_all(app_timer_t *timers, const uint32_t *order, uint32_t n, op_results_t *results)
+{
+    hw_calls_t before = _hw_calls;
+
+    for (uint32_t i = 0u; i < n; i++)
+    {
+        uint64_t before_ns = _nsecs_now();
+        (void) app_timer_stop(&timers[order[i]]);
+        _add_sample(results, before_ns, _nsecs_now());
+    }
+
+    _add_hw_calls(&results->hw_calls, &before);
+}
+
+
+static void _expire_all(op_results_t *results)
+{
+    hw_calls_t before = _hw_calls;
+
+    while (_running)
+    {
+        // Jump straight to the end of the counter period
+        _now_counts = _period_start_counts + (uint64_t) _period_counts;
+
+        uint64_t before_ns = _nsecs_now();
+        app_timer_target_count_reached();
+        _add_sample(results, before_ns, _nsecs_now());
+    }
+
+    _add_hw_calls(&results->hw_calls, &before);
+}
+
+
+static void _write_results(FILE *out, pattern_e pattern, uint32_t n, op_e op, op_results_t *results)
+{
+    if (0u == results->count)
+    {
+        return;
+    }
+
+    uint64_t sum_ns = 0u;
+    for (uint64_t i = 0u; i < results->count; i++)
+    {
+        sum_ns += results->samples_ns[i];
+    }
+
+    qsort(results->samples_ns, results->count, sizeof(uint32_t), _compare_uint32);
+
+    double count = (double) results->count;
+
+    fprintf(out, "%s,%s,%u,%s,%"PRIu64",%.1f,%u,%u,%u,%.3f,%.3f,%.3f,%.3f\n",
+            BENCH_VARIANT, _pattern_names[pattern], n, _op_names[op], results->count,
+            ((double) sum_ns) / count,
+            results->samples_ns[(results->count - 1u) / 2u],
+            results->samples_ns[((results->count - 1u) * 99u) / 100u],
+            results->samples_ns[results->count - 1u],
+            ((double) results->hw_calls.read_timer_counts) / count,
+            ((double) results->hw_calls.set_timer_period_counts) / count,
+            ((double) results->hw_calls.set_timer_running) / count,
+            ((double) results->hw_calls.set_interrupts_enabled) / count);
+    fflush(out);
+
+    fprintf(stderr, "%-10s %8u %-6s %9.1f ns/op  p50 %6u  p99 %7u  max %8u\n",
+            _pattern_names[pattern], n, _op_names[op], ((double) sum_ns) / count,
+            results->samples_ns[(results->count - 1u) / 2u],
+            results->samples_ns[((results->count - 1u) * 99u) / 100u],
+            results->samples_ns[results->count - 1u]);
+}
+
+
+/**
+ * Runs all measurements for one pattern and one number of timers
+ *
+ * @return Host time taken, in milliseconds
+ */
+static uint64_t _run_one(FILE *out, pattern_e pattern, uint32_t n, app_timer_t *timers,
+                         app_timer_period_t *periods, uint32_t *order, uint32_t *samples[OP_COUNT],
+                         uint32_t max_samples)
+{
+    uint32_t reps = (n >= BENCH_MIN_OPS) ? 1u : (BENCH_MIN_OPS / n);
+    op_results_t results[OP_COUNT];
+    uint64_t start_ns = _nsecs_now();
+
+    for (uint32_t op = 0u; op < OP_COUNT; op++)
+    {
+        results[op].samples_ns = samples[op];
+        results[op].capacity = max_samples;
+        results[op].count = 0u;
+        results[op].hw_calls = (hw_calls_t) {0u, 0u, 0u, 0u};
+    }
+
+    for (uint32_t i = 0u; i < n; i++)
+    {
+        switch (pattern)
+        {
+            case PATTERN_RANDOM:
+                periods[i] = (app_timer_period_t) (PERIOD_BASE_COUNTS + ((_next_random() % n) * PERIOD_STEP_COUNTS));
+                break;
+            case PATTERN_ASCENDING:
+                periods[i] = (app_timer_period_t) (PERIOD_BASE_COUNTS + (i * PERIOD_STEP_COUNTS));
+                break;
+            default:
+                periods[i] = (app_timer_period_t) (PERIOD_BASE_COUNTS + ((n - 1u - i) * PERIOD_STEP_COUNTS));
+                break;
+        }
+
+        order[i] = i;
+    }
+
+    // Random order for stopping timers
+    for (uint32_t i = n - 1u; i > 0u; i--)
+    {
+        uint32_t j = (uint32_t) (_next_random() % (i + 1u));
+        uint32_t tmp = order[i];
+        order[i] = order[j];
+        order[j] = tmp;
+    }
+
+    for (uint32_t rep = 0u; rep < reps; rep++)
+    {
+        _start_all(timers, periods, n, &results[OP_START]);
+        _stop_all(timers, order, n, &results[OP_STOP]);
+        _start_all(timers, periods, n, NULL);
+        _expire_all(&results[OP_EXPIRE]);
+    }
+
+    for (uint32_t op = 0u; op < OP_COUNT; op++)
+    {
+        _write_results(out, pattern, n, (op_e) op, &results[op]);
+    }
+
+    return (_nsecs_now() - start_ns) / 1000000ULL;
+}
+
+
+int main(int argc, char *argv[])
+{
+    FILE *out = stdout;
+
+    if (argc > 1)
+    {
+        out = fopen(argv[1], "w");
+        if (NULL == out)
+        {
+            fprintf(stderr, "failed to open %s\n", argv[1]);
+            return 1;
+        }
+    }
+
+    app_timer_error_e err = app_timer_init(&_bench_hw_model);
+    if (APP_TIMER_OK != err)
+    {
+        fprintf(stderr, "app_timer_init failed, err: 0x%x\n", err);
+        return err;
+    }
+
+    // Room for the samples of every repetition, for each operation
+    uint32_t max_samples = (BENCH_MAX_TIMERS > BENCH_MIN_OPS) ? BENCH_MAX_TIMERS : BENCH_MIN_OPS;
+    app_timer_t *timers = calloc(BENCH_MAX_TIMERS, sizeof(app_timer_t));
+    app_timer_period_t *periods = calloc(BENCH_MAX_TIMERS, sizeof(app_timer_period_t));
+    uint32_t *order = calloc(BENCH_MAX_TIMERS, sizeof(uint32_t));
+    uint32_t *samples[OP_COUNT];
+
+    for (uint32_t op = 0u; op < OP_COUNT; op++)
+    {
+        samples[op] = calloc(max_samples, sizeof(uint32_t));
+        if (NULL == samples[op])
+        {
+            fprintf(stderr, "out of memory\n");
+            return 1;
+        }
+    }
+
+    if ((NULL == timers) || (NULL == periods) || (NULL == order))
+    {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    for (uint32_t i = 0u; i < BENCH_MAX_TIMERS; i++)
+    {
+        (void) app_timer_create(&timers[i], _expiry_handler, APP_TIMER_TYPE_SINGLE_SHOT);
+    }
+
+    _clock_overhead_ns = _measure_clock_overhead();
+
+    fprintf(out, "# variant=%s clock_overhead_ns=%"PRIu64" timer_size=%u\n",
+            BENCH_VARIANT, _clock_overhead_ns, (unsigned) sizeof(app_timer_t));
+    fprintf(out, "variant,pattern,n,op,ops,ns_per_op,p50_ns,p99_ns,max_ns,"
+                 "read_timer_counts_per_op,set_timer_period_counts_per_op,"
+                 "set_timer_running_per_op,set_interrupts_enabled_per_op\n");
+
+    fprintf(stderr, "%s (clock_gettime overhead %"PRIu64" ns, subtracted)\n", BENCH_VARIANT, _clock_overhead_ns);
+
+    for (uint32_t pattern = 0u; pattern < PATTERN_COUNT; pattern++)
+    {
+        for (uint32_t n = 1u; n <= BENCH_MAX_TIMERS; n *= 10u)
+        {
+            uint64_t elapsed_ms = _run_one(out, (pattern_e) pattern, n, timers, periods, order, samples, max_samples);
+
+            // Next N is 10 times larger, so it may take 100 times longer if costs grow with N
+            if (((elapsed_ms * 100u) > BENCH_TIME_LIMIT_MS) && ((n * 10u) <= BENCH_MAX_TIMERS))
+            {
+                fprintf(stderr, "%-10s skipping N >= %u, N=%u took %"PRIu64" ms\n",
+                        _pattern_names[pattern], n * 10u, n, elapsed_ms);
+                break;
+            }
+        }
+    }
+
+    if (stdout != out)
+    {
+        fclose(out);
+    }
+
+    return 0;
+}
@@ -0,0 +1,224 @@
+/**
+ * Measures the CPU cycles taken by app_timer_start, app_timer_stop and
+ * app_timer_target_count_reached with a small number of active timers, to compare data
+ * structures for the set of active timers (e.g. the sorted list and the delta-encoded list)
+ * at the sizes that are typical for small targets.
+ *
+ * Each run starts BENCH_NUM_TIMERS single-shot timers with random periods, stops them all in
+ * random order, starts them all again, and then calls app_timer_target_count_reached at the
+ * end of each counter period until all timers have expired. Every run uses the same periods
+ * and stop order. The cost per call of each operation is averaged over one run, and the lowest
+ * average out of BENCH_RUNS runs is reported, to leave out runs that were interrupted by the
+ * host OS.
+ *
+ * Cycles are read with rdtsc on x86 hosts, so results are only comparable between builds run
+ * on the same machine; on other hosts, nanoseconds from clock_gettime are reported instead.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "app_timer_api.h"
+
+
+#ifndef BENCH_VARIANT
+#define BENCH_VARIANT "default"      ///< Name of this build, written to the output
+#endif // BENCH_VARIANT
+
+#ifndef BENCH_NUM_TIMERS
+#define BENCH_NUM_TIMERS (64u)       ///< Number of timers started in each run
+#endif // BENCH_NUM_TIMERS
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS (20000u)          ///< Number of runs, the lowest average of all runs is reported
+#endif // BENCH_RUNS
+
+#define PERIOD_BASE_COUNTS (1000u)   ///< Shortest timer period, in timer counts
+#define PERIOD_STEP_COUNTS (16u)     ///< Difference between possible timer periods, in timer counts
+
+
+#if defined(__x86_64__) || defined(__i386__)
+#define BENCH_UNITS "cycles"
+#else
+#define BENCH_UNITS "ns"
+#endif
+
+
+static uint64_t _now_counts = 0u;
+static uint64_t _period_start_counts = 0u;
+static app_timer_count_t _period_counts = 0u;
+static bool _running = false;
+
+static app_timer_t _timers[BENCH_NUM_TIMERS];
+static app_timer_period_t _periods[BENCH_NUM_TIMERS];
+static uint32_t _stop_order[BENCH_NUM_TIMERS];
+
+
+static bool _init(void)
+{
+    return true;
+}
+
+
+static app_timer_running_count_t _units_to_timer_counts(app_timer_period_t units)
+{
+    return (app_timer_running_count_t) units;
+}
+
+
+static app_timer_count_t _read_timer_counts(void)
+{
+    return (app_timer_count_t) (_now_counts - _period_start_counts);
+}
+
+
+static void _set_timer_period_counts(app_timer_count_t counts)
+{
+    _period_counts = counts;
+    _period_start_counts = _now_counts;
+}
+
+
+static void _set_timer_running(bool enabled)
+{
+    _running = enabled;
+}
+
+
+static void _set_interrupts_enabled(bool enabled, app_timer_int_status_t *int_status)
+{
+    (void) enabled;
+    (void) int_status;
+}
+
+
+// Hardware model definition
+static app_timer_hw_model_t _bench_hw_model = {
+    .init = _init,
+    .units_to_timer_counts = _units_to_timer_counts,
+    .read_timer_counts = _read_timer_counts,
+    .set_timer_period_counts = _set_timer_period_counts,
+    .set_timer_running = _set_timer_running,
+    .set_interrupts_enabled = _set_interrupts_enabled,
+    .max_count = (app_timer_count_t) 0xffffu
+};
+
+
+static void _expiry_handler(void *context)
+{
+    (void) context;
+}
+
+
+static inline uint64_t _ticks_now(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return (uint64_t) __rdtsc();
+#else
+    struct timespec ts = {.tv_sec=0, .tv_nsec=0};
+    (void) clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (((uint64_t) ts.tv_sec) * 1000000000ULL) + ((uint64_t) ts.tv_nsec);
+#endif
+}
+
+
+// xorshift64, so that random periods and stop order are the same on every run
+static uint64_t _next_random(void)
+{
+    static uint64_t state = 88172645463325252ULL;
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+
+static void _lowest(double *lowest, uint64_t ticks, uint32_t calls)
+{
+    double per_call = ((double) ticks) / ((double) calls);
+
+    if (per_call < *lowest)
+    {
+        *lowest = per_call;
+    }
+}
+
+
+int main(void)
+{
+    app_timer_error_e err = app_timer_init(&_bench_hw_model);
+    if (APP_TIMER_OK != err)
+    {
+        fprintf(stderr, "app_timer_init failed, err: 0x%x\n", err);
+        return err;
+    }
+
+    for (uint32_t i = 0u; i < BENCH_NUM_TIMERS; i++)
+    {
+        (void) app_timer_create(&_timers[i], _expiry_handler, APP_TIMER_TYPE_SINGLE_SHOT);
+        _periods[i] = (app_timer_period_t) (PERIOD_BASE_COUNTS + ((_next_random() % BENCH_NUM_TIMERS) * PERIOD_STEP_COUNTS));
+        _stop_order[i] = i;
+    }
+
+    for (uint32_t i = BENCH_NUM_TIMERS - 1u; i > 0u; i--)
+    {
+        uint32_t j = (uint32_t) (_next_random() % (i + 1u));
+        uint32_t tmp = _stop_order[i];
+        _stop_order[i] = _stop_order[j];
+        _stop_order[j] = tmp;
+    }
+
+    double lowest_start = 1e30;
+    double lowest_stop = 1e30;
+    double lowest_expire = 1e30;
+
+    for (uint32_t run = 0u; run < BENCH_RUNS; run++)
+    {
+        uint64_t before = _ticks_now();
+        for (uint32_t i = 0u; i < BENCH_NUM_TIMERS; i++)
+        {
+            (void) app_timer_start(&_timers[i], _periods[i], NULL);
+        }
+        _lowest(&lowest_start, _ticks_now() - before, BENCH_NUM_TIMERS);
+
+        before = _ticks_now();
+        for (uint32_t i = 0u; i < BENCH_NUM_TIMERS; i++)
+        {
+            (void) app_timer_stop(&_timers[_stop_order[i]]);
+        }
+        _lowest(&lowest_stop, _ticks_now() - before, BENCH_NUM_TIMERS);
+
+        for (uint32_t i = 0u; i < BENCH_NUM_TIMERS; i++)
+        {
+            (void) app_timer_start(&_timers[i], _periods[i], NULL);
+        }
+
+        uint64_t expire_ticks = 0u;
+        uint32_t expire_calls = 0u;
+
+        while (_running)
+        {
+            // Jump straight to the end of the counter period
+            _now_counts = _period_start_counts + (uint64_t) _period_counts;
+
+            before = _ticks_now();
+            app_timer_target_count_reached();
+            expire_ticks += _ticks_now() - before;
+            expire_calls += 1u;
+        }
+
+        _lowest(&lowest_expire, expire_ticks, expire_calls);
+    }
+
+    printf("%-24s start %7.1f  stop %7.1f  expire %7.1f  %s per call, %u timers\n",
+           BENCH_VARIANT, lowest_start, lowest_stop, lowest_expire, BENCH_UNITS, BENCH_NUM_TIMERS);
+
+    return 0;
+}
@@ -0,0 +1,278 @@
+/**
+ * Stress test program for the POSIX timer HW model. Runs a set of repeating timers whose
+ * handlers run in signal handler context, while the main thread continuously starts and
+ * stops a set of single-shot timers, so that app_timer functions called from the main thread
+ * are constantly being interrupted by app_timer_target_count_reached. This exercises the
+ * interrupt-safety paths of app_timer, which the polling HW model cannot test.
+ *
+ * When the configured runtime has elapsed, all timers are stopped, and the measured cost of
+ * disabling/enabling "interrupts" (blocking/unblocking the timer signal), the throughput of
+ * the main loop, and the accuracy of all repeating timers are printed. The program exits
+ * with a non-zero status if any app_timer function failed, if any repeating timer expired
+ * early, or if the number of expirations of any repeating timer is wrong.
+ *
+ * app_timer loses a little time whenever the counter is re-configured, so repeating timers
+ * slowly fall behind CLOCK_MONOTONIC; a repeating timer is only considered to have the wrong
+ * number of expirations if it expired more often than possible, or if it is missing more than
+ * MAX_MISSING_PERCENT of its expirations (e.g. because it was lost from the active set).
+ *
+ * Usage: stress_main [runtime in seconds]
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <signal.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "app_timer_api.h"
+#include "posix_app_timer.h"
+
+
+#define DEFAULT_RUNTIME_SECS (10u)       ///< Default total runtime for all timers, seconds
+#define NUM_REPEAT_TIMERS (64u)          ///< Number of repeating timers to create
+#define NUM_SINGLE_TIMERS (64u)          ///< Number of single-shot timers started/stopped by the main thread
+#define REPEAT_PERIOD_START_MS (1u)      ///< Period of first repeating timer, in millisecs
+#define REPEAT_PERIOD_INCREMENT_MS (3u)  ///< Increment period for each subsequent repeating timer by this much
+#define MAX_SINGLE_PERIOD_MS (50u)       ///< Single-shot timers are started with random periods up to this
+#define OVERHEAD_ITERATIONS (1000000u)   ///< Number of iterations for measuring overhead
+#define MAX_MISSING_PERCENT (10u)        ///< Max. percentage of expirations a repeating timer may miss
+
+
+/**
+ * Represents a single repeating timer instance and all data needed to test it
+ */
+typedef struct
+{
+    app_timer_t timer;            ///< Timer instance
+    uint32_t ms;                  ///< Timer period in milliseconds
+    uint64_t expected_us;         ///< Expected time of next expiration
+    uint64_t max_late_us;         ///< Highest lateness seen for this timer
+    uint64_t early;               ///< Number of times this timer expired before its expected time
+    volatile uint64_t expirations;  ///< Total number of times this timer has expired
+} repeat_timer_t;
+
+
+static repeat_timer_t _repeat_timers[NUM_REPEAT_TIMERS];
+static app_timer_t _single_timers[NUM_SINGLE_TIMERS];
+static volatile uint64_t _single_expirations = 0u;
+
+
+static uint64_t _nsecs_now(void)
+{
+    struct timespec ts = {.tv_sec=0, .tv_nsec=0};
+    (void) clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (((uint64_t) ts.tv_sec) * 1000000000ULL) + ((uint64_t) ts.tv_nsec);
+}
+
+
+static uint64_t _usecs_now(void)
+{
+    return _nsecs_now() / 1000ULL;
+}
+
+
+static uint32_t _rand(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+
+// Timer callback for all repeating timers, runs in signal handler context
+static void _repeat_timer_callback(void *context)
+{
+    repeat_timer_t *t = (repeat_timer_t *) context;
+    uint64_t now_us = _usecs_now();
+
+    if (now_us < t->expected_us)
+    {
+        t->early += 1u;
+    }
+    else
+    {
+        uint64_t late_us = now_us - t->expected_us;
+        if (late_us > t->max_late_us)
+        {
+            t->max_late_us = late_us;
+        }
+    }
+
+    t->expected_us += ((uint64_t) t->ms) * 1000ULL;
+    t->expirations += 1u;
+}
+
+
+// Timer callback for all single-shot timers, runs in signal handler context
+static void _single_timer_callback(void *context)
+{
+    (void) context;
+    _single_expirations += 1u;
+}
+
+
+// Measures the cost of blocking and then unblocking the timer signal, in nanoseconds
+static double _measure_sigmask_ns(void)
+{
+    sigset_t set;
+    (void) sigemptyset(&set);
+    (void) sigaddset(&set, POSIX_APP_TIMER_SIGNAL);
+
+    uint64_t start_ns = _nsecs_now();
+    for (uint32_t i = 0u; i < OVERHEAD_ITERATIONS; i++)
+    {
+        (void) pthread_sigmask(SIG_BLOCK, &set, NULL);
+        (void) pthread_sigmask(SIG_UNBLOCK, &set, NULL);
+    }
+
+    return ((double) (_nsecs_now() - start_ns)) / OVERHEAD_ITERATIONS;
+}
+
+
+// Measures the cost of starting and then stopping a timer, when no other timers are active, in nanoseconds
+static double _measure_start_stop_ns(void)
+{
+    app_timer_t timer;
+    (void) app_timer_create(&timer, _single_timer_callback, APP_TIMER_TYPE_SINGLE_SHOT);
+
+    uint64_t start_ns = _nsecs_now();
+    for (uint32_t i = 0u; i < OVERHEAD_ITERATIONS; i++)
+    {
+        (void) app_timer_start(&timer, 1000u, NULL);
+        (void) app_timer_stop(&timer);
+    }
+
+    return ((double) (_nsecs_now() - start_ns)) / OVERHEAD_ITERATIONS;
+}
+
+
+int main(int argc, char *argv[])
+{
+    uint32_t runtime_secs = (argc > 1) ? (uint32_t) strtoul(argv[1], NULL, 0) : DEFAULT_RUNTIME_SECS;
+    uint32_t rand_state = 0x12345678u;
+    uint64_t errors = 0u;
+    uint64_t ops = 0u;
+
+    app_timer_error_e err = posix_app_timer_init();
+    if (APP_TIMER_OK != err)
+    {
+        printf("posix_app_timer_init failed, err: 0x%x\n", err);
+        return err;
+    }
+
+    double sigmask_ns = _measure_sigmask_ns();
+    double start_stop_ns = _measure_start_stop_ns();
+
+    for (uint32_t i = 0u; i < NUM_SINGLE_TIMERS; i++)
+    {
+        (void) app_timer_create(&_single_timers[i], _single_timer_callback, APP_TIMER_TYPE_SINGLE_SHOT);
+    }
+
+    uint64_t start_us = _usecs_now();
+
+    for (uint32_t i = 0u; i < NUM_REPEAT_TIMERS; i++)
+    {
+        repeat_timer_t *t = &_repeat_timers[i];
+        t->ms = REPEAT_PERIOD_START_MS + (i * REPEAT_PERIOD_INCREMENT_MS);
+        t->expected_us = _usecs_now() + (((uint64_t) t->ms) * 1000ULL);
+        t->max_late_us = 0u;
+        t->early = 0u;
+        t->expirations = 0u;
+
+        (void) app_timer_create(&t->timer, _repeat_timer_callback, APP_TIMER_TYPE_REPEATING);
+        err = app_timer_start(&t->timer, t->ms, t);
+        if (APP_TIMER_OK != err)
+        {
+            printf("app_timer_start failed, err: 0x%x\n", err);
+            return err;
+        }
+    }
+
+    printf("running for %u seconds...\n", runtime_secs);
+    uint64_t end_us = start_us + (((uint64_t) runtime_secs) * 1000000ULL);
+    uint64_t start_signals = posix_app_timer_signal_count();
+
+    // Start and stop single-shot timers as fast as possible, while being interrupted by timer signals
+    while (_usecs_now() < end_us)
+    {
+        uint32_t r = _rand(&rand_state);
+        app_timer_t *timer = &_single_timers[r % NUM_SINGLE_TIMERS];
+
+        if (0u != (r & 0x80000000u))
+        {
+            err = app_timer_start(timer, 1u + ((r >> 8) % MAX_SINGLE_PERIOD_MS), NULL);
+        }
+        else
+        {
+            err = app_timer_stop(timer);
+        }
+
+        if (APP_TIMER_OK != err)
+        {
+            errors += 1u;
+        }
+
+        ops += 1u;
+    }
+
+    (void) app_timer_stop_all();
+
+    uint64_t elapsed_us = _usecs_now() - start_us;
+    uint64_t signals = posix_app_timer_signal_count() - start_signals;
+    uint64_t max_late_us = 0u;
+
+    for (uint32_t i = 0u; i < NUM_REPEAT_TIMERS; i++)
+    {
+        repeat_timer_t *t = &_repeat_timers[i];
+        uint64_t expected = elapsed_us / (((uint64_t) t->ms) * 1000ULL);
+        uint64_t min_expected = (expected * (100u - MAX_MISSING_PERCENT)) / 100u;
+
+        if ((t->expirations > expected) || (t->expirations < min_expected))
+        {
+            printf("timer %u (%ums): expected %" PRIu64 " expirations, got %" PRIu64 "\n",
+                   i, t->ms, expected, t->expirations);
+            errors += 1u;
+        }
+
+        if (0u != t->early)
+        {
+            printf("timer %u (%ums): expired early %" PRIu64 " times\n", i, t->ms, t->early);
+            errors += 1u;
+        }
+
+        if (t->max_late_us > max_late_us)
+        {
+            max_late_us = t->max_late_us;
+        }
+    }
+
+#ifdef APP_TIMER_STATS_ENABLE
+    app_timer_stats_t stats;
+    (void) app_timer_stats(&stats);
+    if (0u != stats.num_timers)
+    {
+        printf("%u timers still active after app_timer_stop_all\n", stats.num_timers);
+        errors += 1u;
+    }
+#endif // APP_TIMER_STATS_ENABLE
+
+    printf("\n");
+    printf("block+unblock timer signal            : %.1fns\n", sigmask_ns);
+    printf("app_timer_start+app_timer_stop (idle) : %.1fns\n", start_stop_ns);
+    printf("main loop start/stop operations       : %" PRIu64 " (%.0f/s)\n", ops, ((double) ops) / (elapsed_us / 1000000.0));
+    printf("timer signals handled                 : %" PRIu64 " (%.0f/s)\n", signals, ((double) signals) / (elapsed_us / 1000000.0));
+    printf("single-shot timer expirations         : %" PRIu64 "\n", _single_expirations);
+    printf("max. repeating timer lateness         : %" PRIu64 "us\n", max_late_us);
+    printf("errors                                : %" PRIu64 "\n", errors);
+
+    return (0u == errors) ? 0 : 1;
+}
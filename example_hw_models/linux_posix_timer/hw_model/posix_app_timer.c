@@ -0,0 +1,224 @@
+/**
+ * @file posix_app_timer.c
+ * @author Erik Nyquist
+ *
+ * @brief Implements an app_timer HW model for Linux, using a POSIX per-process timer that
+ *        sends a signal to the initializing thread, so that app_timer_target_count_reached
+ *        runs in asynchronous (signal handler) context, like an interrupt handler on an MCU
+ */
+
+#define _GNU_SOURCE
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include "posix_app_timer.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+// Older versions of glibc do not provide a name for the thread ID field of struct sigevent
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif // sigev_notify_thread_id
+
+
+/**
+ * 60 minutes in microseconds-- the counter is a 64-bit monotonic clock, so this only limits
+ * how long a single POSIX timer period can be (longer timer periods are handled by app_timer)
+ */
+#define MAX_COUNT (60u * 60 * 1000u * 1000u)
+
+
+static timer_t _posix_timer;
+static bool _posix_timer_created = false;
+static volatile uint64_t _period_start_usecs = 0u;
+static volatile app_timer_count_t _period_counts = 0u;
+static volatile bool _running = false;
+static volatile uint64_t _signal_count = 0u;
+
+
+static uint64_t _usecs_now(void)
+{
+    struct timespec ts = {.tv_sec=0, .tv_nsec=0};
+    (void) clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (((uint64_t) ts.tv_sec) * 1000000ULL) + (((uint64_t) ts.tv_nsec) / 1000ULL);
+}
+
+
+/**
+ * Arms the POSIX timer to expire at the end of the current period, or disarms it
+ *
+ * @param enabled  True to arm the timer, false to disarm it
+ */
+static void _arm_timer(bool enabled)
+{
+    struct itimerspec spec = {.it_interval={.tv_sec=0, .tv_nsec=0}, .it_value={.tv_sec=0, .tv_nsec=0}};
+
+    if (enabled)
+    {
+        uint64_t end_usecs = _period_start_usecs + (uint64_t) _period_counts;
+
+        // Absolute expiry time, so time spent between setting the period and arming does not add up
+        spec.it_value.tv_sec = (time_t) (end_usecs / 1000000ULL);
+        spec.it_value.tv_nsec = (long) ((end_usecs % 1000000ULL) * 1000ULL);
+
+        if ((0 == spec.it_value.tv_sec) && (0 == spec.it_value.tv_nsec))
+        {
+            // All-zero it_value would disarm the timer
+            spec.it_value.tv_nsec = 1;
+        }
+    }
+
+    (void) timer_settime(_posix_timer, TIMER_ABSTIME, &spec, NULL);
+}
+
+
+static app_timer_running_count_t _units_to_timer_counts(app_timer_period_t ms)
+{
+    return ((app_timer_running_count_t) ms) * 1000ULL;
+}
+
+
+static app_timer_count_t _read_timer_counts(void)
+{
+    return (app_timer_count_t) (_usecs_now() - _period_start_usecs);
+}
+
+
+static void _set_timer_period_counts(app_timer_count_t counts)
+{
+    _period_counts = counts;
+    _period_start_usecs = _usecs_now();
+
+    if (_running)
+    {
+        _arm_timer(true);
+    }
+}
+
+
+static void _set_timer_running(bool enabled)
+{
+    _running = enabled;
+    _arm_timer(enabled);
+}
+
+
+/**
+ * Blocks or unblocks the timer signal for the calling thread. When blocking, *int_status is
+ * set to 1 if the signal was already blocked (e.g. when called from the signal handler, or
+ * from a nested critical section), and then unblocking does nothing unless *int_status is 0.
+ */
+static void _set_interrupts_enabled(bool enabled, app_timer_int_status_t *int_status)
+{
+    sigset_t set;
+    (void) sigemptyset(&set);
+    (void) sigaddset(&set, POSIX_APP_TIMER_SIGNAL);
+
+    if (enabled)
+    {
+        if (0u == *int_status)
+        {
+            (void) pthread_sigmask(SIG_UNBLOCK, &set, NULL);
+        }
+    }
+    else
+    {
+        sigset_t old_set;
+        (void) pthread_sigmask(SIG_BLOCK, &set, &old_set);
+        *int_status = (1 == sigismember(&old_set, POSIX_APP_TIMER_SIGNAL)) ? 1u : 0u;
+    }
+}
+
+
+// Signal handler for timer expiry; the equivalent of a timer interrupt handler
+static void _signal_handler(int signum)
+{
+    (void) signum;
+
+    _signal_count += 1u;
+
+    if (_running && (_read_timer_counts() >= _period_counts))
+    {
+        app_timer_target_count_reached();
+    }
+}
+
+
+// Initialize hardware model
+static bool _init(void)
+{
+    if (_posix_timer_created)
+    {
+        return true;
+    }
+
+    struct sigaction action;
+    (void) memset(&action, 0, sizeof(action));
+    action.sa_handler = _signal_handler;
+    action.sa_flags = SA_RESTART;
+    (void) sigemptyset(&action.sa_mask);
+
+    if (0 != sigaction(POSIX_APP_TIMER_SIGNAL, &action, NULL))
+    {
+        return false;
+    }
+
+    // Deliver the timer signal only to this thread, so blocking it here works like disabling interrupts
+    struct sigevent event;
+    (void) memset(&event, 0, sizeof(event));
+    event.sigev_notify = SIGEV_THREAD_ID;
+    event.sigev_signo = POSIX_APP_TIMER_SIGNAL;
+    event.sigev_notify_thread_id = (pid_t) syscall(SYS_gettid);
+
+    if (0 != timer_create(CLOCK_MONOTONIC, &event, &_posix_timer))
+    {
+        return false;
+    }
+
+    _posix_timer_created = true;
+    return true;
+}
+
+
+// Hardware model definition
+static app_timer_hw_model_t _posix_hw_model = {
+    .init = _init,
+    .units_to_timer_counts = _units_to_timer_counts,
+    .read_timer_counts = _read_timer_counts,
+    .set_timer_period_counts = _set_timer_period_counts,
+    .set_timer_running = _set_timer_running,
+    .set_interrupts_enabled = _set_interrupts_enabled,
+    .max_count = MAX_COUNT
+};
+
+
+/**
+ * @see posix_app_timer.h
+ */
+app_timer_error_e posix_app_timer_init(void)
+{
+    return app_timer_init(&_posix_hw_model);
+}
+
+
+/**
+ * @see posix_app_timer.h
+ */
+uint64_t posix_app_timer_signal_count(void)
+{
+    return _signal_count;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,53 @@
+/**
+ * @file posix_app_timer.h
+ * @author Erik Nyquist
+ *
+ * @brief Implements an app_timer HW model for Linux, using a POSIX per-process timer that
+ *        sends a signal to the initializing thread, so that app_timer_target_count_reached
+ *        runs in asynchronous (signal handler) context, like an interrupt handler on an MCU
+ */
+
+
+#ifndef POSIX_APP_TIMER_H
+#define POSIX_APP_TIMER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <signal.h>
+#include "app_timer_api.h"
+
+
+/**
+ * Signal sent by the POSIX timer when the period set by app_timer has elapsed. Blocking this
+ * signal on the initializing thread is the equivalent of disabling interrupts.
+ */
+#ifndef POSIX_APP_TIMER_SIGNAL
+#define POSIX_APP_TIMER_SIGNAL (SIGRTMIN)
+#endif // POSIX_APP_TIMER_SIGNAL
+
+
+/**
+ * Intitializes the app_timer module with the 'posix' hardware model. The timer signal is
+ * delivered only to the calling thread (via SIGEV_THREAD_ID), so all timer handlers will run
+ * in signal handler context on the calling thread, interrupting whatever it is doing.
+ *
+ * @return #APP_TIMER_OK if initialized successfully, #APP_TIMER_ERROR if the signal handler
+ *         or POSIX timer could not be created
+ */
+app_timer_error_e posix_app_timer_init(void);
+
+/**
+ * Returns the number of times the timer signal has been handled
+ *
+ * @return Number of timer signals handled
+ */
+uint64_t posix_app_timer_signal_count(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // POSIX_APP_TIMER_H
@@ -0,0 +1,366 @@
+/**
+ * Scaling benchmark for the sharded Linux HW model. Runs a mix of app_timer start and stop
+ * operations from 1 up to N threads, first with all threads sharing the default app_timer
+ * context behind a single mutex (which is what happens when many threads use the polling
+ * HW model), and then with one shard per thread. A configurable percentage of operations
+ * target timers owned by another thread's shard, and go through the inbox of that shard.
+ *
+ * Prints the total number of operations per second for each mode and thread count.
+ *
+ * Usage: bench_main [max. number of threads] [seconds per run]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "app_timer_api.h"
+#include "sharded_app_timer.h"
+
+
+#define MAX_THREADS (64u)              ///< Max. number of threads to run
+#define TIMERS_PER_THREAD (256u)       ///< Number of timers owned by each thread
+#define CROSS_SHARD_PERCENT (10u)      ///< Percentage of operations on timers owned by the next thread
+#define MAX_PERIOD_MS (20u)            ///< Timers are started with random periods of 1 to this many milliseconds
+#define DEFAULT_RUN_SECS (1u)          ///< Default runtime for each mode and thread count, seconds
+
+
+/**
+ * Represents a single benchmark thread and all data collected by it
+ */
+typedef struct
+{
+    pthread_t thread;        ///< Thread handle
+    uint32_t index;          ///< Index of this thread, and of the shard/timers it owns
+    uint32_t num_threads;    ///< Total number of threads in this run
+    uint32_t rand_state;     ///< State for xorshift random number generator
+    uint64_t ops;            ///< Number of start/stop operations done
+    uint64_t full;           ///< Number of operations rejected because the target inbox was full
+    uint64_t expirations;    ///< Number of expirations of timers owned by this thread
+} bench_thread_t;
+
+
+static sharded_app_timer_shard_t _shards[MAX_THREADS];
+static app_timer_t _timers[MAX_THREADS][TIMERS_PER_THREAD];
+static bench_thread_t _threads[MAX_THREADS];
+
+static pthread_barrier_t _barrier;
+static bool _stop = false;
+
+static pthread_mutex_t _global_lock = PTHREAD_MUTEX_INITIALIZER;
+static uint64_t _global_period_start_usecs = 0u;
+static app_timer_count_t _global_period_counts = 0u;
+static bool _global_running = false;
+
+
+static uint64_t _usecs_now(void)
+{
+    struct timespec ts = {.tv_sec=0, .tv_nsec=0};
+    (void) clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (((uint64_t) ts.tv_sec) * 1000000ULL) + (((uint64_t) ts.tv_nsec) / 1000ULL);
+}
+
+
+static uint32_t _rand(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+
+// HW model for the default context, shared by all threads (only accessed with _global_lock held)
+
+static app_timer_running_count_t _global_units_to_timer_counts(app_timer_period_t ms)
+{
+    return ((app_timer_running_count_t) ms) * 1000ULL;
+}
+
+static app_timer_count_t _global_read_timer_counts(void)
+{
+    return (app_timer_count_t) (_usecs_now() - _global_period_start_usecs);
+}
+
+static void _global_set_timer_period_counts(app_timer_count_t counts)
+{
+    _global_period_counts = counts;
+    _global_period_start_usecs = _usecs_now();
+}
+
+static void _global_set_timer_running(bool enabled)
+{
+    _global_running = enabled;
+}
+
+static void _global_set_interrupts_enabled(bool enabled, app_timer_int_status_t *int_status)
+{
+    ; // Nothing needed here, caller holds _global_lock
+}
+
+static bool _global_init(void)
+{
+    return true;
+}
+
+static app_timer_hw_model_t _global_hw_model = {
+    .init = _global_init,
+    .units_to_timer_counts = _global_units_to_timer_counts,
+    .read_timer_counts = _global_read_timer_counts,
+    .set_timer_period_counts = _global_set_timer_period_counts,
+    .set_timer_running = _global_set_timer_running,
+    .set_interrupts_enabled = _global_set_interrupts_enabled,
+    .max_count = 60u * 60 * 1000u * 1000u
+};
+
+
+// Timer callback for all timers, context is the thread that owns the timer
+static void _timer_callback(void *context)
+{
+    bench_thread_t *t = (bench_thread_t *) context;
+    t->expirations += 1u;
+}
+
+
+// Picks the timer for the next operation, and the thread that owns it
+static app_timer_t *_pick_timer(bench_thread_t *t, uint32_t r, uint32_t *owner)
+{
+    *owner = t->index;
+
+    if ((r % 100u) < CROSS_SHARD_PERCENT)
+    {
+        *owner = (t->index + 1u) % t->num_threads;
+    }
+
+    return &_timers[*owner][(r >> 8) % TIMERS_PER_THREAD];
+}
+
+
+// Thread body for runs where all threads share the default context behind a mutex
+static void *_global_thread(void *arg)
+{
+    bench_thread_t *t = (bench_thread_t *) arg;
+
+    pthread_mutex_lock(&_global_lock);
+    for (uint32_t i = 0u; i < TIMERS_PER_THREAD; i++)
+    {
+        (void) app_timer_create(&_timers[t->index][i], _timer_callback, APP_TIMER_TYPE_REPEATING);
+    }
+    pthread_mutex_unlock(&_global_lock);
+
+    pthread_barrier_wait(&_barrier);
+
+    while (!__atomic_load_n(&_stop, __ATOMIC_RELAXED))
+    {
+        uint32_t r = _rand(&t->rand_state);
+        uint32_t owner;
+        app_timer_t *timer = _pick_timer(t, r, &owner);
+
+        pthread_mutex_lock(&_global_lock);
+
+        if (0u != (r & 0x80000000u))
+        {
+            (void) app_timer_start(timer, 1u + ((r >> 16) % MAX_PERIOD_MS), &_threads[owner]);
+        }
+        else
+        {
+            (void) app_timer_stop(timer);
+        }
+
+        if (_global_running && (_global_read_timer_counts() >= _global_period_counts))
+        {
+            app_timer_target_count_reached();
+        }
+
+        pthread_mutex_unlock(&_global_lock);
+        t->ops += 1u;
+    }
+
+    return NULL;
+}
+
+
+// Thread body for runs where each thread owns one shard
+static void *_sharded_thread(void *arg)
+{
+    bench_thread_t *t = (bench_thread_t *) arg;
+    sharded_app_timer_shard_t *shard = &_shards[t->index];
+
+    (void) sharded_app_timer_shard_init(shard);
+    for (uint32_t i = 0u; i < TIMERS_PER_THREAD; i++)
+    {
+        (void) sharded_app_timer_create(shard, &_timers[t->index][i], _timer_callback, APP_TIMER_TYPE_REPEATING);
+    }
+
+    pthread_barrier_wait(&_barrier);
+
+    while (!__atomic_load_n(&_stop, __ATOMIC_RELAXED))
+    {
+        uint32_t r = _rand(&t->rand_state);
+        uint32_t owner;
+        app_timer_t *timer = _pick_timer(t, r, &owner);
+        app_timer_error_e err;
+
+        if (0u != (r & 0x80000000u))
+        {
+            err = sharded_app_timer_start(&_shards[owner], timer, 1u + ((r >> 16) % MAX_PERIOD_MS), &_threads[owner]);
+        }
+        else
+        {
+            err = sharded_app_timer_stop(&_shards[owner], timer);
+        }
+
+        if (APP_TIMER_FULL == err)
+        {
+            t->full += 1u;
+        }
+
+        sharded_app_timer_poll();
+        t->ops += 1u;
+    }
+
+    // Wait until nobody is posting any more commands, then run the last ones and stop everything
+    pthread_barrier_wait(&_barrier);
+    sharded_app_timer_poll();
+    (void) app_timer_ctx_stop_all(&shard->ctx);
+
+    return NULL;
+}
+
+
+/**
+ * Runs one benchmark with the given number of threads
+ *
+ * @param num_threads  Number of threads to run
+ * @param secs         Runtime in seconds
+ * @param sharded      If true, each thread owns a shard; otherwise all threads share the default context
+ * @param full         Total number of operations rejected because an inbox was full
+ *
+ * @return Total number of operations per second
+ */
+static double _run(uint32_t num_threads, uint32_t secs, bool sharded, uint64_t *full)
+{
+    __atomic_store_n(&_stop, false, __ATOMIC_RELAXED);
+    pthread_barrier_init(&_barrier, NULL, num_threads + 1u);
+
+    for (uint32_t i = 0u; i < num_threads; i++)
+    {
+        bench_thread_t *t = &_threads[i];
+        t->index = i;
+        t->num_threads = num_threads;
+        t->rand_state = 0x9e3779b9u * (i + 1u);
+        t->ops = 0u;
+        t->full = 0u;
+        t->expirations = 0u;
+        pthread_create(&t->thread, NULL, sharded ? _sharded_thread : _global_thread, t);
+    }
+
+    pthread_barrier_wait(&_barrier);
+    uint64_t start_us = _usecs_now();
+
+    struct timespec duration = {.tv_sec=(time_t) secs, .tv_nsec=0};
+    (void) nanosleep(&duration, NULL);
+
+    __atomic_store_n(&_stop, true, __ATOMIC_RELAXED);
+    uint64_t end_us = _usecs_now();
+
+    if (sharded)
+    {
+        pthread_barrier_wait(&_barrier);
+    }
+
+    uint64_t total_ops = 0u;
+    *full = 0u;
+
+    for (uint32_t i = 0u; i < num_threads; i++)
+    {
+        pthread_join(_threads[i].thread, NULL);
+        total_ops += _threads[i].ops;
+        *full += _threads[i].full;
+    }
+
+    if (!sharded)
+    {
+        (void) app_timer_stop_all();
+    }
+
+    pthread_barrier_destroy(&_barrier);
+
+    return ((double) total_ops) / (((double) (end_us - start_us)) / 1000000.0);
+}
+
+
+int main(int argc, char *argv[])
+{
+    long nprocs = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t max_threads = (nprocs > 0) ? (uint32_t) nprocs : 1u;
+    uint32_t secs = DEFAULT_RUN_SECS;
+
+    if (argc > 1)
+    {
+        max_threads = (uint32_t) strtoul(argv[1], NULL, 0);
+    }
+
+    if (argc > 2)
+    {
+        secs = (uint32_t) strtoul(argv[2], NULL, 0);
+    }
+
+    if ((0u == max_threads) || (max_threads > MAX_THREADS))
+    {
+        printf("number of threads must be between 1 and %u\n", MAX_THREADS);
+        return 1;
+    }
+
+    app_timer_error_e err = app_timer_init(&_global_hw_model);
+    if (APP_TIMER_OK != err)
+    {
+        printf("app_timer_init failed, err: 0x%x\n", err);
+        return err;
+    }
+
+    printf("%u timers per thread, %u%% of operations on timers owned by another thread, %us per run\n\n",
+           TIMERS_PER_THREAD, CROSS_SHARD_PERCENT, secs);
+    printf("threads  global Mops/s  sharded Mops/s  speedup  inbox full\n");
+
+    uint32_t num_threads = 1u;
+
+    while (true)
+    {
+        uint64_t full;
+        double global_ops = _run(num_threads, secs, false, &full);
+        double sharded_ops = _run(num_threads, secs, true, &full);
+
+        uint64_t errors = 0u;
+        for (uint32_t i = 0u; i < num_threads; i++)
+        {
+            errors += sharded_app_timer_inbox_errors(&_shards[i]);
+        }
+
+        printf("%7u  %13.2f  %14.2f  %6.2fx  %10" PRIu64 "\n", num_threads, global_ops / 1000000.0,
+               sharded_ops / 1000000.0, sharded_ops / global_ops, full);
+
+        if (0u != errors)
+        {
+            printf("%" PRIu64 " posted commands failed\n", errors);
+        }
+
+        if (num_threads == max_threads)
+        {
+            break;
+        }
+
+        num_threads = ((num_threads * 2u) > max_threads) ? max_threads : (num_threads * 2u);
+    }
+
+    return 0;
+}
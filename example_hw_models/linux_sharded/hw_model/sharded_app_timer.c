@@ -0,0 +1,325 @@
+/**
+ * @file sharded_app_timer.c
+ * @author Erik Nyquist
+ *
+ * @brief Implements an app_timer HW model for multi-threaded Linux programs, with one
+ *        independent timer context (shard) per thread, using a polling approach
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include "sharded_app_timer.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * 60 minutes in microseconds-- leaves a good 11 minutes of slack to ensure we don't overflow
+ * a uint32 before the polling loop makes it around
+ */
+#define MAX_COUNT (60u * 60 * 1000u * 1000u)
+
+#define INBOX_MASK (SHARDED_APP_TIMER_INBOX_SIZE - 1u)
+
+
+/**
+ * Operations that can be posted to the inbox of a shard
+ */
+typedef enum
+{
+    CMD_OP_START,
+    CMD_OP_STOP
+} _cmd_op_e;
+
+
+/**
+ * Shard owned by the calling thread. The hardware model functions have no arguments, and
+ * are only ever called by the owner thread of a shard, so they use this to find the
+ * counter state for the shard.
+ */
+static __thread sharded_app_timer_shard_t *_current_shard = NULL;
+
+
+static uint64_t _usecs_now(void)
+{
+    struct timespec ts = {.tv_sec=0, .tv_nsec=0};
+    (void) clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (((uint64_t) ts.tv_sec) * 1000000ULL) + (((uint64_t) ts.tv_nsec) / 1000ULL);
+}
+
+
+static app_timer_running_count_t _units_to_timer_counts(app_timer_period_t ms)
+{
+    return ((app_timer_running_count_t) ms) * 1000ULL;
+}
+
+
+static app_timer_count_t _read_timer_counts(void)
+{
+    return (app_timer_count_t) (_usecs_now() - _current_shard->period_start_usecs);
+}
+
+
+static void _set_timer_period_counts(app_timer_count_t counts)
+{
+    _current_shard->period_counts = counts;
+    _current_shard->period_start_usecs = _usecs_now();
+}
+
+
+static void _set_timer_running(bool enabled)
+{
+    _current_shard->running = enabled;
+}
+
+
+static void _set_interrupts_enabled(bool enabled, app_timer_int_status_t *int_status)
+{
+    ; // Nothing needed here, each shard is only accessed by its owner thread
+}
+
+
+// Initialize hardware model
+static bool _init(void)
+{
+    return true;
+}
+
+
+// Hardware model definition, shared by all shards
+static app_timer_hw_model_t _sharded_hw_model = {
+    .init = _init,
+    .units_to_timer_counts = _units_to_timer_counts,
+    .read_timer_counts = _read_timer_counts,
+    .set_timer_period_counts = _set_timer_period_counts,
+    .set_timer_running = _set_timer_running,
+    .set_interrupts_enabled = _set_interrupts_enabled,
+    .max_count = MAX_COUNT
+};
+
+
+/**
+ * Posts a command to the inbox of a shard. Any number of threads can post to the same
+ * inbox at once; each producer claims a slot by advancing the head with a CAS, and then
+ * hands the filled slot to the owner thread by updating the slot sequence number.
+ *
+ * @param shard    Pointer to shard to post command to
+ * @param op       Operation to post
+ * @param timer    Pointer to timer instance to operate on
+ * @param time_ms  Timer period, for start commands
+ * @param context  Context pointer for timer handler, for start commands
+ *
+ * @return #APP_TIMER_OK if posted, #APP_TIMER_FULL if the inbox is full
+ */
+static app_timer_error_e _inbox_post(sharded_app_timer_shard_t *shard, _cmd_op_e op, app_timer_t *timer,
+                                     app_timer_period_t time_ms, void *context)
+{
+    uint64_t pos = __atomic_load_n(&shard->inbox_head, __ATOMIC_RELAXED);
+    _sharded_app_timer_cmd_t *cmd;
+
+    while (true)
+    {
+        cmd = &shard->inbox[pos & INBOX_MASK];
+        uint64_t sequence = __atomic_load_n(&cmd->sequence, __ATOMIC_ACQUIRE);
+        int64_t diff = (int64_t) (sequence - pos);
+
+        if (0 == diff)
+        {
+            // Slot is free, try to claim it
+            if (__atomic_compare_exchange_n(&shard->inbox_head, &pos, pos + 1u, true,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            // Slot still holds a command from one lap ago, which the owner has not read yet
+            return APP_TIMER_FULL;
+        }
+        else
+        {
+            // Another producer claimed this slot first
+            pos = __atomic_load_n(&shard->inbox_head, __ATOMIC_RELAXED);
+        }
+    }
+
+    cmd->op = (uint8_t) op;
+    cmd->timer = timer;
+    cmd->time_ms = time_ms;
+    cmd->context = context;
+
+    __atomic_store_n(&cmd->sequence, pos + 1u, __ATOMIC_RELEASE);
+    return APP_TIMER_OK;
+}
+
+
+/**
+ * Runs all commands posted to the inbox of a shard. Must only be called by the owner thread.
+ *
+ * @param shard  Pointer to shard
+ */
+static void _inbox_drain(sharded_app_timer_shard_t *shard)
+{
+    while (true)
+    {
+        uint64_t pos = shard->inbox_tail;
+        _sharded_app_timer_cmd_t *cmd = &shard->inbox[pos & INBOX_MASK];
+
+        if (__atomic_load_n(&cmd->sequence, __ATOMIC_ACQUIRE) != (pos + 1u))
+        {
+            // No more commands
+            break;
+        }
+
+        app_timer_error_e err;
+
+        if (CMD_OP_START == cmd->op)
+        {
+            err = app_timer_ctx_start(&shard->ctx, cmd->timer, cmd->time_ms, cmd->context);
+        }
+        else
+        {
+            err = app_timer_ctx_stop(&shard->ctx, cmd->timer);
+        }
+
+        if (APP_TIMER_OK != err)
+        {
+            __atomic_fetch_add(&shard->inbox_errors, 1u, __ATOMIC_RELAXED);
+        }
+
+        // Free the slot for producers on the next lap
+        __atomic_store_n(&cmd->sequence, pos + SHARDED_APP_TIMER_INBOX_SIZE, __ATOMIC_RELEASE);
+        shard->inbox_tail = pos + 1u;
+    }
+}
+
+
+/**
+ * @see sharded_app_timer.h
+ */
+app_timer_error_e sharded_app_timer_shard_init(sharded_app_timer_shard_t *shard)
+{
+    if (NULL == shard)
+    {
+        return APP_TIMER_NULL_PARAM;
+    }
+
+    if (NULL != _current_shard)
+    {
+        // Calling thread already owns a shard
+        return APP_TIMER_INVALID_STATE;
+    }
+
+    (void) memset(shard, 0, sizeof(sharded_app_timer_shard_t));
+
+    for (uint32_t i = 0u; i < SHARDED_APP_TIMER_INBOX_SIZE; i++)
+    {
+        shard->inbox[i].sequence = i;
+    }
+
+    _current_shard = shard;
+
+    app_timer_error_e err = app_timer_ctx_init(&shard->ctx, &_sharded_hw_model);
+    if (APP_TIMER_OK != err)
+    {
+        _current_shard = NULL;
+    }
+
+    return err;
+}
+
+
+/**
+ * @see sharded_app_timer.h
+ */
+void sharded_app_timer_poll(void)
+{
+    sharded_app_timer_shard_t *shard = _current_shard;
+
+    if (NULL == shard)
+    {
+        return;
+    }
+
+    _inbox_drain(shard);
+
+    if (shard->running && (_read_timer_counts() >= shard->period_counts))
+    {
+        app_timer_ctx_target_count_reached(&shard->ctx);
+    }
+}
+
+
+/**
+ * @see sharded_app_timer.h
+ */
+app_timer_error_e sharded_app_timer_create(sharded_app_timer_shard_t *shard, app_timer_t *timer,
+                                           app_timer_handler_t handler, app_timer_type_e type)
+{
+    if (NULL == shard)
+    {
+        return APP_TIMER_NULL_PARAM;
+    }
+
+    return app_timer_ctx_create(&shard->ctx, timer, handler, type);
+}
+
+
+/**
+ * @see sharded_app_timer.h
+ */
+app_timer_error_e sharded_app_timer_start(sharded_app_timer_shard_t *shard, app_timer_t *timer,
+                                          app_timer_period_t time_ms, void *context)
+{
+    if (NULL == shard)
+    {
+        return APP_TIMER_NULL_PARAM;
+    }
+
+    if (_current_shard == shard)
+    {
+        return app_timer_ctx_start(&shard->ctx, timer, time_ms, context);
+    }
+
+    return _inbox_post(shard, CMD_OP_START, timer, time_ms, context);
+}
+
+
+/**
+ * @see sharded_app_timer.h
+ */
+app_timer_error_e sharded_app_timer_stop(sharded_app_timer_shard_t *shard, app_timer_t *timer)
+{
+    if (NULL == shard)
+    {
+        return APP_TIMER_NULL_PARAM;
+    }
+
+    if (_current_shard == shard)
+    {
+        return app_timer_ctx_stop(&shard->ctx, timer);
+    }
+
+    return _inbox_post(shard, CMD_OP_STOP, timer, 0u, NULL);
+}
+
+
+/**
+ * @see sharded_app_timer.h
+ */
+uint64_t sharded_app_timer_inbox_errors(sharded_app_timer_shard_t *shard)
+{
+    return __atomic_load_n(&shard->inbox_errors, __ATOMIC_RELAXED);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,142 @@
+/**
+ * @file sharded_app_timer.h
+ * @author Erik Nyquist
+ *
+ * @brief Implements an app_timer HW model for multi-threaded Linux programs, with one
+ *        independent timer context (shard) per thread, using a polling approach
+ */
+
+
+#ifndef SHARDED_APP_TIMER_H
+#define SHARDED_APP_TIMER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "app_timer_api.h"
+
+
+/**
+ * Max. number of commands that can be waiting in the inbox of a single shard. Must be a power of 2.
+ */
+#ifndef SHARDED_APP_TIMER_INBOX_SIZE
+#define SHARDED_APP_TIMER_INBOX_SIZE (256u)
+#endif // SHARDED_APP_TIMER_INBOX_SIZE
+
+#if (SHARDED_APP_TIMER_INBOX_SIZE < 2u) || \
+    (0u != (SHARDED_APP_TIMER_INBOX_SIZE & (SHARDED_APP_TIMER_INBOX_SIZE - 1u)))
+#error "SHARDED_APP_TIMER_INBOX_SIZE must be a power of 2"
+#endif // SHARDED_APP_TIMER_INBOX_SIZE
+
+
+/**
+ * One start/stop command posted to a shard by another thread (internal use only)
+ */
+typedef struct
+{
+    uint64_t sequence;              ///< Slot sequence number, used to hand the slot between producers and the consumer
+    uint8_t op;                     ///< Operation to run on the timer
+    app_timer_t *timer;             ///< Timer instance to operate on
+    app_timer_period_t time_ms;     ///< Timer period, for start commands
+    void *context;                  ///< Context pointer to pass to timer handler, for start commands
+} _sharded_app_timer_cmd_t;
+
+
+/**
+ * Holds all state for one shard; one timer context driven by one thread. All fields are for
+ * internal use only.
+ */
+typedef struct
+{
+    app_timer_ctx_t ctx;                                            ///< Timer context owned by this shard
+    _sharded_app_timer_cmd_t inbox[SHARDED_APP_TIMER_INBOX_SIZE];   ///< Commands posted by other threads
+    uint64_t inbox_head;                                            ///< Next inbox slot to be claimed by a producer
+    uint64_t inbox_tail;                                            ///< Next inbox slot to be read by the owner thread
+    uint64_t inbox_errors;                                          ///< Number of posted commands that failed when they were run
+    uint64_t period_start_usecs;                                    ///< Time when the counter period was last set, microseconds
+    app_timer_count_t period_counts;                                ///< Counter period that was last set
+    bool running;                                                   ///< True if the counter is running
+} sharded_app_timer_shard_t;
+
+
+/**
+ * Initializes a shard, and makes the calling thread its owner. All expired timers in the
+ * shard will be handled by the owner thread, when it calls #sharded_app_timer_poll.
+ * Each thread can own at most one shard, and other threads must not start or stop timers
+ * in the shard until this function has returned (e.g. wait on a barrier after calling it).
+ *
+ * @param shard  Pointer to shard to initialize
+ *
+ * @return #APP_TIMER_OK if initialized successfully
+ */
+app_timer_error_e sharded_app_timer_shard_init(sharded_app_timer_shard_t *shard);
+
+/**
+ * Runs any commands posted to the shard owned by the calling thread, then checks the
+ * current time and handles any expired timers. The owner thread of each shard should call
+ * this as often as possible in its main loop.
+ */
+void sharded_app_timer_poll(void);
+
+/**
+ * Same as #app_timer_create, for a timer in a specific shard. Must be called before the timer
+ * is first started, and a timer must only ever be used with the shard it was created in.
+ *
+ * @param shard    Pointer to shard that will own the timer
+ * @param timer    Pointer to timer instance to initialize
+ * @param handler  Handler function to run when timer expires
+ * @param type     Timer type
+ *
+ * @return #APP_TIMER_OK if successful
+ */
+app_timer_error_e sharded_app_timer_create(sharded_app_timer_shard_t *shard, app_timer_t *timer,
+                                           app_timer_handler_t handler, app_timer_type_e type);
+
+/**
+ * Starts a timer in a specific shard. If the calling thread owns the shard, then this is
+ * the same as #app_timer_start. Otherwise, a start command is posted to the inbox of the
+ * shard, and the timer is started the next time the owner thread calls #sharded_app_timer_poll.
+ * The timer period is measured from that point.
+ *
+ * @param shard    Pointer to shard that owns the timer
+ * @param timer    Pointer to timer instance to start
+ * @param time_ms  Timer period in milliseconds
+ * @param context  Context pointer to pass to timer handler
+ *
+ * @return #APP_TIMER_OK if successful (or if the command was posted), #APP_TIMER_FULL if the
+ *         inbox of the shard is full. Errors from posted commands are only counted, see
+ *         #sharded_app_timer_inbox_errors.
+ */
+app_timer_error_e sharded_app_timer_start(sharded_app_timer_shard_t *shard, app_timer_t *timer,
+                                          app_timer_period_t time_ms, void *context);
+
+/**
+ * Stops a timer in a specific shard. If the calling thread owns the shard, then this is the
+ * same as #app_timer_stop. Otherwise, a stop command is posted to the inbox of the shard.
+ *
+ * @param shard  Pointer to shard that owns the timer
+ * @param timer  Pointer to timer instance to stop
+ *
+ * @return #APP_TIMER_OK if successful (or if the command was posted), #APP_TIMER_FULL if the
+ *         inbox of the shard is full.
+ */
+app_timer_error_e sharded_app_timer_stop(sharded_app_timer_shard_t *shard, app_timer_t *timer);
+
+/**
+ * Returns the number of commands posted to a shard by other threads that returned an
+ * error when they were run by the owner thread
+ *
+ * @param shard  Pointer to shard
+ *
+ * @return Number of failed commands
+ */
+uint64_t sharded_app_timer_inbox_errors(sharded_app_timer_shard_t *shard);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SHARDED_APP_TIMER_H
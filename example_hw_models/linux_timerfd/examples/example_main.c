@@ -0,0 +1,100 @@
+/**
+ * Example program for the timerfd HW model. Creates a repeating timer that expires once every
+ * second, and then sleeps in epoll_wait until the timerfd is readable. Each time the timer
+ * expires, the number of microseconds between the expected and actual expiry time is printed.
+ * The process uses no CPU time while waiting for the timer to expire.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <time.h>
+#include <sys/epoll.h>
+
+#include "app_timer_api.h"
+#include "timerfd_app_timer.h"
+
+
+#define TIMER_PERIOD_MS (1000u)
+
+
+static uint64_t _expected_usecs = 0u;
+
+
+static uint64_t _usecs_now(void)
+{
+    struct timespec ts = {.tv_sec=0, .tv_nsec=0};
+    (void) clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (((uint64_t) ts.tv_sec) * 1000000ULL) + (((uint64_t) ts.tv_nsec) / 1000ULL);
+}
+
+
+// Timer callback, will be invoked by timerfd_app_timer_handle when the timer expires
+static void print_timer_callback(void *context)
+{
+    (void) context;
+
+    uint64_t now = _usecs_now();
+    printf("timer expired, %" PRId64 "us late\n", (int64_t) (now - _expected_usecs));
+    _expected_usecs += TIMER_PERIOD_MS * 1000ULL;
+}
+
+int main(int argc, char *argv[])
+{
+    app_timer_t print_timer;
+    app_timer_error_e err = APP_TIMER_OK;
+
+    // Initialize timerfd_app_timer
+    err = timerfd_app_timer_init();
+    if (APP_TIMER_OK != err)
+    {
+        printf("timerfd_app_timer_init failed, err: 0x%x\n", err);
+        return err;
+    }
+
+    int epoll_fd = epoll_create1(0);
+    if (epoll_fd < 0)
+    {
+        perror("epoll_create1");
+        return 1;
+    }
+
+    struct epoll_event event = {.events=EPOLLIN, .data={.fd=timerfd_app_timer_fd()}};
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, timerfd_app_timer_fd(), &event) < 0)
+    {
+        perror("epoll_ctl");
+        return 1;
+    }
+
+    // Create a new timer instance
+    err = app_timer_create(&print_timer, &print_timer_callback, APP_TIMER_TYPE_REPEATING);
+    if (APP_TIMER_OK != err)
+    {
+        printf("app_timer_create failed, err: 0x%x\n", err);
+        return err;
+    }
+
+    // Start timer instance
+    _expected_usecs = _usecs_now() + (TIMER_PERIOD_MS * 1000ULL);
+    err = app_timer_start(&print_timer, TIMER_PERIOD_MS, NULL);
+    if (APP_TIMER_OK != err)
+    {
+        printf("app_timer_start failed, err: 0x%x\n", err);
+        return err;
+    }
+
+    // Sleep until the timerfd is readable, then handle expired timers
+    while (true)
+    {
+        struct epoll_event ready;
+        int num_ready = epoll_wait(epoll_fd, &ready, 1, -1);
+
+        if ((1 == num_ready) && (ready.data.fd == timerfd_app_timer_fd()))
+        {
+            timerfd_app_timer_handle();
+        }
+    }
+}
@@ -0,0 +1,170 @@
+/**
+ * @file timerfd_app_timer.c
+ * @author Erik Nyquist
+ *
+ * @brief Implements an app_timer HW model for Linux, using a timerfd on CLOCK_MONOTONIC, so
+ *        that the calling thread can sleep in epoll/poll/select until the next timer expires
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/timerfd.h>
+#include "timerfd_app_timer.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * 60 minutes in microseconds-- the counter is a 64-bit monotonic clock, so this only limits
+ * how long a single timerfd period can be (longer timer periods are handled by app_timer)
+ */
+#define MAX_COUNT (60u * 60 * 1000u * 1000u)
+
+
+static int _timer_fd = -1;
+static uint64_t _period_start_usecs = 0u;
+static app_timer_count_t _period_counts = 0u;
+static bool _running = false;
+
+
+static uint64_t _usecs_now(void)
+{
+    struct timespec ts = {.tv_sec=0, .tv_nsec=0};
+    (void) clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (((uint64_t) ts.tv_sec) * 1000000ULL) + (((uint64_t) ts.tv_nsec) / 1000ULL);
+}
+
+
+/**
+ * Arms the timerfd to expire at the end of the current period, or disarms it
+ *
+ * @param enabled  True to arm the timerfd, false to disarm it
+ */
+static void _arm_timerfd(bool enabled)
+{
+    struct itimerspec spec = {.it_interval={.tv_sec=0, .tv_nsec=0}, .it_value={.tv_sec=0, .tv_nsec=0}};
+
+    if (enabled)
+    {
+        uint64_t end_usecs = _period_start_usecs + (uint64_t) _period_counts;
+
+        // Absolute expiry time, so time spent between setting the period and arming does not add up
+        spec.it_value.tv_sec = (time_t) (end_usecs / 1000000ULL);
+        spec.it_value.tv_nsec = (long) ((end_usecs % 1000000ULL) * 1000ULL);
+
+        if ((0 == spec.it_value.tv_sec) && (0 == spec.it_value.tv_nsec))
+        {
+            // All-zero it_value would disarm the timerfd
+            spec.it_value.tv_nsec = 1;
+        }
+    }
+
+    (void) timerfd_settime(_timer_fd, TFD_TIMER_ABSTIME, &spec, NULL);
+}
+
+
+static app_timer_running_count_t _units_to_timer_counts(app_timer_period_t ms)
+{
+    return ((app_timer_running_count_t) ms) * 1000ULL;
+}
+
+
+static app_timer_count_t _read_timer_counts(void)
+{
+    return (app_timer_count_t) (_usecs_now() - _period_start_usecs);
+}
+
+
+static void _set_timer_period_counts(app_timer_count_t counts)
+{
+    _period_counts = counts;
+    _period_start_usecs = _usecs_now();
+
+    if (_running)
+    {
+        _arm_timerfd(true);
+    }
+}
+
+
+static void _set_timer_running(bool enabled)
+{
+    _running = enabled;
+    _arm_timerfd(enabled);
+}
+
+
+static void _set_interrupts_enabled(bool enabled, app_timer_int_status_t *int_status)
+{
+    ; // Nothing needed here, timer handlers run on the same thread as all other app_timer calls
+}
+
+
+// Initialize hardware model
+static bool _init(void)
+{
+    if (_timer_fd < 0)
+    {
+        _timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    }
+
+    return (_timer_fd >= 0);
+}
+
+
+// Hardware model definition
+static app_timer_hw_model_t _timerfd_hw_model = {
+    .init = _init,
+    .units_to_timer_counts = _units_to_timer_counts,
+    .read_timer_counts = _read_timer_counts,
+    .set_timer_period_counts = _set_timer_period_counts,
+    .set_timer_running = _set_timer_running,
+    .set_interrupts_enabled = _set_interrupts_enabled,
+    .max_count = MAX_COUNT
+};
+
+
+/**
+ * @see timerfd_app_timer.h
+ */
+app_timer_error_e timerfd_app_timer_init(void)
+{
+    return app_timer_init(&_timerfd_hw_model);
+}
+
+
+/**
+ * @see timerfd_app_timer.h
+ */
+int timerfd_app_timer_fd(void)
+{
+    return _timer_fd;
+}
+
+
+/**
+ * @see timerfd_app_timer.h
+ */
+void timerfd_app_timer_handle(void)
+{
+    uint64_t expirations = 0u;
+
+    // Acknowledge expiration, so the fd is no longer readable (fails with EAGAIN if not expired)
+    (void) read(_timer_fd, &expirations, sizeof(expirations));
+
+    if (_running && (_read_timer_counts() >= _period_counts))
+    {
+        app_timer_target_count_reached();
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,49 @@
+/**
+ * @file timerfd_app_timer.h
+ * @author Erik Nyquist
+ *
+ * @brief Implements an app_timer HW model for Linux, using a timerfd on CLOCK_MONOTONIC, so
+ *        that the calling thread can sleep in epoll/poll/select until the next timer expires
+ */
+
+
+#ifndef TIMERFD_APP_TIMER_H
+#define TIMERFD_APP_TIMER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "app_timer_api.h"
+
+/**
+ * Intitializes the app_timer module with the 'timerfd' hardware model
+ *
+ * @return #APP_TIMER_OK if initialized successfully, #APP_TIMER_ERROR if the timerfd
+ *         could not be created
+ */
+app_timer_error_e timerfd_app_timer_init(void);
+
+/**
+ * Returns the timerfd used by the hardware model. The fd becomes readable when the period
+ * set by app_timer has elapsed; add it to your epoll set (or poll/select) with EPOLLIN, and
+ * call #timerfd_app_timer_handle whenever it is readable.
+ *
+ * @return timerfd, or -1 if #timerfd_app_timer_init has not been called successfully
+ */
+int timerfd_app_timer_fd(void);
+
+/**
+ * Handles readiness of the timerfd; acknowledges the timerfd expiration, and handles any
+ * expired timers. Call this whenever the fd returned by #timerfd_app_timer_fd is readable.
+ * Timer handlers are run by this function, on the calling thread.
+ *
+ * All app_timer functions must be called from the same thread that calls this function.
+ */
+void timerfd_app_timer_handle(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TIMERFD_APP_TIMER_H
@@ -10,13 +10,22 @@
  * system. The only thing we can't really test here is interrupt safefty (app_timer_target_count_reached
  * and other app_timer functions are not being called in interrupt contexts, as they may
  * be on an embedded system).
+ *
+ * On Linux, run with the 'sleep' argument to call polling_app_timer_run (which sleeps until
+ * the next timer expires) instead of calling polling_app_timer_poll continuously. The CPU time
+ * used by the test is reported in both modes, so the two can be compared.
  */
 
 
 #include <stdio.h>
 #include <stdarg.h>
+#include <string.h>
 #include <inttypes.h>
 
+#ifdef __linux__
+#include <sys/resource.h>
+#endif // __linux__
+
 #include "app_timer_api.h"
 #include "polling_app_timer.h"
 #include "timing.h"
@@ -28,7 +37,9 @@
 #endif // VERBOSE
 
 
+#ifndef TOTAL_TEST_TIME_SECONDS
 #define TOTAL_TEST_TIME_SECONDS (10 * 60u)   ///< Total runtime for all timers, seconds
+#endif // TOTAL_TEST_TIME_SECONDS
 #define TIME_LOG_INTERVAL_SECS  (60u)        ///< How often to log runtime remaining, seconds
 
 #define NUM_SINGLE_TIMERS (128u)             ///< Number of single-shot timers to create (re-started in timer callback)
@@ -44,6 +55,8 @@
 
 #define MAX_LOG_MSG_SIZE (256u)              ///< Log messages printed to stdout can't be larger than this
 
+#define SLEEP_MODE_RUN_TIMEOUT_MS (1000u)    ///< Timeout for each polling_app_timer_run call in 'sleep' mode
+
 
 /**
  * Represents a single timer instance and all data needed to test it
@@ -359,8 +372,35 @@ static void _dump_test_results(test_results_summary_t *results)
 }
 
 
+#ifdef __linux__
+// Returns CPU time (user + system) used by this process so far, in microseconds
+static uint64_t _cpu_usecs_used(void)
+{
+    struct rusage usage;
+    if (0 != getrusage(RUSAGE_SELF, &usage))
+    {
+        return 0u;
+    }
+
+    uint64_t user_us = (((uint64_t) usage.ru_utime.tv_sec) * 1000000ULL) + ((uint64_t) usage.ru_utime.tv_usec);
+    uint64_t sys_us = (((uint64_t) usage.ru_stime.tv_sec) * 1000000ULL) + ((uint64_t) usage.ru_stime.tv_usec);
+    return user_us + sys_us;
+}
+#endif // __linux__
+
+
 int main(int argc, char *argv[])
 {
+    bool sleep_mode = (argc > 1) && (0 == strcmp(argv[1], "sleep"));
+
+#ifndef __linux__
+    if (sleep_mode)
+    {
+        printf("'sleep' mode is only supported on Linux\n");
+        return 1;
+    }
+#endif // __linux__
+
     // Initialize polling_app_timer
     polling_app_timer_init();
 
@@ -457,8 +497,12 @@ int main(int argc, char *argv[])
     char sizestrbuf[32];
     (void) sizesprint(sizeof(_test_timers), sizestrbuf, sizeof(sizestrbuf));
     _log("%s of memory used\n", sizestrbuf);
-    _log("running %u timers for %u seconds...\n", NUM_TEST_TIMERS, TOTAL_TEST_TIME_SECONDS);
+    _log("running %u timers for %u seconds (%s)...\n", NUM_TEST_TIMERS, TOTAL_TEST_TIME_SECONDS,
+         sleep_mode ? "sleeping until next expiry" : "polling continuously");
 
+#ifdef __linux__
+    uint64_t start_cpu_us = _cpu_usecs_used();
+#endif // __linux__
     uint64_t start_us = timing_usecs_elapsed();
     uint64_t total_test_time_us = TOTAL_TEST_TIME_SECONDS * 1000000ULL;
 
@@ -470,13 +514,25 @@ int main(int argc, char *argv[])
     // Enter polling loop-- polling_app_timer_poll must be called regularly
     while (usecs_elapsed <= total_test_time_us)
     {
-        uint64_t before_poll = timing_usecs_elapsed();
-        polling_app_timer_poll();
-        uint64_t poll_time = timing_usecs_elapsed() - before_poll;
-
-        if (poll_time > highest_poll_time_us)
+#ifdef __linux__
+        if (sleep_mode)
+        {
+            // Don't sleep past the end of the test
+            uint64_t remaining_ms = ((total_test_time_us - usecs_elapsed) / 1000ULL) + 1u;
+            (void) polling_app_timer_run((remaining_ms < SLEEP_MODE_RUN_TIMEOUT_MS) ?
+                                         (uint32_t) remaining_ms : SLEEP_MODE_RUN_TIMEOUT_MS);
+        }
+        else
+#endif // __linux__
         {
-            highest_poll_time_us = poll_time;
+            uint64_t before_poll = timing_usecs_elapsed();
+            polling_app_timer_poll();
+            uint64_t poll_time = timing_usecs_elapsed() - before_poll;
+
+            if (poll_time > highest_poll_time_us)
+            {
+                highest_poll_time_us = poll_time;
+            }
         }
 
         usecs_elapsed = timing_usecs_elapsed() - start_us;
@@ -489,6 +545,11 @@ int main(int argc, char *argv[])
         }
     }
 
+#ifdef __linux__
+    uint64_t cpu_us = _cpu_usecs_used() - start_cpu_us;
+    uint64_t wall_us = timing_usecs_elapsed() - start_us;
+#endif // __linux__
+
     _log("test complete, stopping all timers...\n");
 
     // Stop all the timers
@@ -535,8 +596,17 @@ int main(int argc, char *argv[])
     printf("Absolute highest deviation seen from expected expiration counts:\n");
     printf("- %"PRIu64"\n\n", results.highest_expiration_diff);
 
-    printf("Highest app_timer_target_count_reached execution time:\n");
-    printf("- %.4f milliseconds\n\n", ((float) (highest_poll_time_us)) / 1000.0f);
+    if (!sleep_mode)
+    {
+        printf("Highest app_timer_target_count_reached execution time:\n");
+        printf("- %.4f milliseconds\n\n", ((float) (highest_poll_time_us)) / 1000.0f);
+    }
+
+#ifdef __linux__
+    printf("CPU time used while running timers (%s):\n", sleep_mode ? "sleeping until next expiry" : "polling continuously");
+    printf("- %.3f seconds, %.2f%% of %.3f seconds elapsed\n\n", ((double) cpu_us) / 1000000.0,
+           (((double) cpu_us) * 100.0) / ((double) wall_us), ((double) wall_us) / 1000000.0);
+#endif // __linux__
 
     int64_t total_expected_exp = results.total_expected_expirations;
     int64_t total_actual_exp = results.total_actual_expirations;
@@ -0,0 +1,99 @@
+/**
+ * Micro-benchmark for the clock source used by timing.c. Measures the cost of a single
+ * timing_usecs_elapsed call, the smallest step between two consecutive readings that
+ * differ (the effective resolution), and how many times per second polling_app_timer_poll
+ * can run with one active timer, so that clock sources can be compared on a given system.
+ *
+ * Build with TIMING_CLOCK_MONOTONIC_COARSE or TIMING_CLOCK_TSC defined to measure those
+ * clock sources (see the 'timing_bench' target in the Makefile, which builds all of them).
+ */
+
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "app_timer_api.h"
+#include "polling_app_timer.h"
+#include "timing.h"
+
+
+#define MEASUREMENT_USECS (1000000u)   ///< How long to run each measurement for, microseconds
+
+
+// Timer callback, never expected to run
+static void _timer_callback(void *context)
+{
+    (void) context;
+}
+
+
+int main(int argc, char *argv[])
+{
+    app_timer_t timer;
+    app_timer_error_e err = polling_app_timer_init();
+    if (APP_TIMER_OK != err)
+    {
+        printf("polling_app_timer_init failed, err: 0x%x\n", err);
+        return err;
+    }
+
+    // Count clock reads in a fixed time, keeping track of the smallest non-zero step
+    uint64_t reads = 0u;
+    uint64_t steps = 0u;
+    uint64_t min_step = UINT64_MAX;
+    uint64_t start = timing_usecs_elapsed();
+    uint64_t last = start;
+
+    while ((last - start) < MEASUREMENT_USECS)
+    {
+        uint64_t now = timing_usecs_elapsed();
+        reads += 1u;
+
+        if (now != last)
+        {
+            steps += 1u;
+            if ((now - last) < min_step)
+            {
+                min_step = now - last;
+            }
+
+            last = now;
+        }
+    }
+
+    double ns_per_read = (((double) (last - start)) * 1000.0) / ((double) reads);
+    double avg_step = ((double) (last - start)) / ((double) ((0u == steps) ? 1u : steps));
+
+    // Count polls with one active timer, which will not expire during the measurement
+    err = app_timer_create(&timer, _timer_callback, APP_TIMER_TYPE_SINGLE_SHOT);
+    if (APP_TIMER_OK == err)
+    {
+        err = app_timer_start(&timer, 60u * 1000u, NULL);
+    }
+
+    if (APP_TIMER_OK != err)
+    {
+        printf("failed to start timer, err: 0x%x\n", err);
+        return err;
+    }
+
+    uint64_t polls = 0u;
+    start = timing_usecs_elapsed();
+
+    while ((timing_usecs_elapsed() - start) < MEASUREMENT_USECS)
+    {
+        polling_app_timer_poll();
+        polls += 1u;
+    }
+
+    uint64_t elapsed = timing_usecs_elapsed() - start;
+    (void) app_timer_stop(&timer);
+
+    printf("clock source          : %s\n", timing_clock_name());
+    printf("cost per read         : %.1fns\n", ns_per_read);
+    printf("smallest step         : %" PRIu64 "us\n", min_step);
+    printf("average step          : %.1fus\n", avg_step);
+    printf("polls per second      : %.0f\n", ((double) polls) / (((double) elapsed) / 1000000.0));
+
+    return 0;
+}
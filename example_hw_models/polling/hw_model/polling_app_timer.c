@@ -6,8 +6,24 @@
  *        using a polling approach
  */
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // For clock_nanosleep and ppoll
+#endif // __linux__
+
 #include <stdint.h>
 #include <stdbool.h>
+
+#ifdef __linux__
+#include <time.h>
+#include <errno.h>
+#ifdef POLLING_APP_TIMER_THREADSAFE
+#include <poll.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/eventfd.h>
+#endif // POLLING_APP_TIMER_THREADSAFE
+#endif // __linux__
+
 #include "polling_app_timer.h"
 #include "timing.h"
 
@@ -24,16 +40,39 @@ extern "C" {
 #define MAX_COUNT (60u * 60 * 1000u * 1000u)
 
 
+/**
+ * polling_app_timer_run stops sleeping this many microseconds before the next expiry,
+ * and polls the clock for the rest of the time
+ */
+#ifndef POLLING_APP_TIMER_SPIN_USECS
+#define POLLING_APP_TIMER_SPIN_USECS (0u)
+#endif // POLLING_APP_TIMER_SPIN_USECS
+
+
 static app_timer_count_t _last_timer_counts = 0u;
 static app_timer_running_count_t _last_timer_usecs = 0u;
 
 
+#if defined(__linux__) && defined(POLLING_APP_TIMER_THREADSAFE)
+static pthread_mutex_t _lock;          ///< Protects app_timer state, recursive since timer handlers can call app_timer_start
+static int _wakeup_fd = -1;            ///< eventfd written when another thread changes the next expiry time
+static pthread_t _run_thread;          ///< Thread currently inside polling_app_timer_run
+static bool _run_thread_valid = false; ///< True if _run_thread is valid
+#endif // __linux__ && POLLING_APP_TIMER_THREADSAFE
+
+
 static app_timer_running_count_t _units_to_timer_counts(app_timer_period_t ms)
 {
     return ((app_timer_running_count_t) ms) * 1000ULL;
 }
 
 
+static app_timer_period_t _timer_counts_to_units(app_timer_running_count_t counts)
+{
+    return (app_timer_period_t) (counts / 1000ULL);
+}
+
+
 static app_timer_count_t _read_timer_counts(void)
 {
     return (app_timer_count_t) (((app_timer_running_count_t) timing_usecs_elapsed()) - _last_timer_usecs);
@@ -44,6 +83,15 @@ static void _set_timer_period_counts(app_timer_count_t counts)
 {
     _last_timer_counts = counts;
     _last_timer_usecs = (app_timer_running_count_t) timing_usecs_elapsed();
+
+#if defined(__linux__) && defined(POLLING_APP_TIMER_THREADSAFE)
+    // Next expiry changed, wake up polling_app_timer_run if it is sleeping on another thread
+    if (_run_thread_valid && !pthread_equal(pthread_self(), _run_thread))
+    {
+        uint64_t value = 1u;
+        (void) write(_wakeup_fd, &value, sizeof(value));
+    }
+#endif // __linux__ && POLLING_APP_TIMER_THREADSAFE
 }
 
 
@@ -55,7 +103,18 @@ static void _set_timer_running(bool enabled)
 
 static void _set_interrupts_enabled(bool enabled, app_timer_int_status_t *int_status)
 {
+#if defined(__linux__) && defined(POLLING_APP_TIMER_THREADSAFE)
+    if (enabled)
+    {
+        (void) pthread_mutex_unlock(&_lock);
+    }
+    else
+    {
+        (void) pthread_mutex_lock(&_lock);
+    }
+#else
     ; // Nothing needed here
+#endif // __linux__ && POLLING_APP_TIMER_THREADSAFE
 }
 
 
@@ -63,6 +122,21 @@ static void _set_interrupts_enabled(bool enabled, app_timer_int_status_t *int_st
 static bool _init(void)
 {
     timing_init();
+
+#if defined(__linux__) && defined(POLLING_APP_TIMER_THREADSAFE)
+    pthread_mutexattr_t attr;
+    (void) pthread_mutexattr_init(&attr);
+    (void) pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    (void) pthread_mutex_init(&_lock, &attr);
+    (void) pthread_mutexattr_destroy(&attr);
+
+    _wakeup_fd = eventfd(0u, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (_wakeup_fd < 0)
+    {
+        return false;
+    }
+#endif // __linux__ && POLLING_APP_TIMER_THREADSAFE
+
     return true;
 }
 
@@ -75,7 +149,8 @@ static app_timer_hw_model_t _polling_hw_model = {
     .set_timer_period_counts = _set_timer_period_counts,
     .set_timer_running = _set_timer_running,
     .set_interrupts_enabled = _set_interrupts_enabled,
-    .max_count = MAX_COUNT
+    .max_count = MAX_COUNT,
+    .timer_counts_to_units = _timer_counts_to_units
 };
 
 
@@ -92,13 +167,139 @@ app_timer_error_e polling_app_timer_init(void)
  */
 void polling_app_timer_poll(void)
 {
-    app_timer_count_t now = _read_timer_counts();
-    if (now >= _last_timer_counts)
+    app_timer_int_status_t int_status = 0u;
+    _set_interrupts_enabled(false, &int_status);
+    bool expired = (_read_timer_counts() >= _last_timer_counts);
+    _set_interrupts_enabled(true, &int_status);
+
+    if (expired)
     {
         app_timer_target_count_reached();
     }
 }
 
+
+#ifdef __linux__
+/**
+ * Sleeps until the given time, or until woken up by another thread.
+ *
+ * timing_usecs_elapsed may not read CLOCK_MONOTONIC (e.g. with TIMING_CLOCK_MONOTONIC_COARSE
+ * or TIMING_CLOCK_TSC), so the time left to sleep is measured with timing_usecs_elapsed, and
+ * the deadline for the sleep is then taken from CLOCK_MONOTONIC itself.
+ *
+ * @param wake_us  Time to wake up, in microseconds, as returned by timing_usecs_elapsed
+ *
+ * @return True if woken up by another thread
+ */
+static bool _sleep_until(uint64_t wake_us)
+{
+    uint64_t now_us = timing_usecs_elapsed();
+    if (wake_us <= now_us)
+    {
+        return false;
+    }
+
+    uint64_t sleep_us = wake_us - now_us;
+
+#ifdef POLLING_APP_TIMER_THREADSAFE
+    // Wait on the eventfd, so that another thread can wake this one up before the timeout
+    struct timespec timeout = {.tv_sec=(time_t) (sleep_us / 1000000ULL), .tv_nsec=(long) ((sleep_us % 1000000ULL) * 1000ULL)};
+
+    struct pollfd pfd = {.fd=_wakeup_fd, .events=POLLIN, .revents=0};
+    if ((0 < ppoll(&pfd, 1u, &timeout, NULL)) && (0 != (pfd.revents & POLLIN)))
+    {
+        uint64_t value = 0u;
+        (void) read(_wakeup_fd, &value, sizeof(value));
+        return true;
+    }
+#else
+    // Absolute deadline, so that sleeping again after a signal handler does not add to the total time
+    struct timespec wake = {.tv_sec=0, .tv_nsec=0};
+    (void) clock_gettime(CLOCK_MONOTONIC, &wake);
+    wake.tv_sec += (time_t) (sleep_us / 1000000ULL);
+    wake.tv_nsec += (long) ((sleep_us % 1000000ULL) * 1000ULL);
+    if (wake.tv_nsec >= 1000000000L)
+    {
+        wake.tv_sec += 1;
+        wake.tv_nsec -= 1000000000L;
+    }
+
+    while (EINTR == clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, NULL))
+    {
+        ; // Interrupted by a signal handler, keep sleeping
+    }
+#endif // POLLING_APP_TIMER_THREADSAFE
+
+    return false;
+}
+
+
+/**
+ * @see polling_app_timer.h
+ */
+bool polling_app_timer_run(uint32_t timeout_ms)
+{
+    uint64_t end_us = timing_usecs_elapsed() + (((uint64_t) timeout_ms) * 1000ULL);
+    bool woken = false;
+
+#ifdef POLLING_APP_TIMER_THREADSAFE
+    (void) pthread_mutex_lock(&_lock);
+    _run_thread = pthread_self();
+    _run_thread_valid = true;
+    (void) pthread_mutex_unlock(&_lock);
+#endif // POLLING_APP_TIMER_THREADSAFE
+
+    while (!woken)
+    {
+        polling_app_timer_poll();
+
+        uint64_t now_us = timing_usecs_elapsed();
+        if (now_us >= end_us)
+        {
+            break;
+        }
+
+        uint64_t wake_us = end_us;
+        app_timer_running_count_t ticks = 0u;
+
+        if (APP_TIMER_OK == app_timer_ticks_until_next_expiry(&ticks))
+        {
+            // Counter period is never longer than MAX_COUNT, so poll at least that often
+            if (ticks > MAX_COUNT)
+            {
+                ticks = MAX_COUNT;
+            }
+
+            if ((now_us + ticks) < wake_us)
+            {
+                wake_us = now_us + ticks;
+            }
+        }
+
+        if ((wake_us - now_us) > POLLING_APP_TIMER_SPIN_USECS)
+        {
+            woken = _sleep_until(wake_us - POLLING_APP_TIMER_SPIN_USECS);
+        }
+
+        if ((!woken) && (0u < POLLING_APP_TIMER_SPIN_USECS))
+        {
+            while (timing_usecs_elapsed() < wake_us)
+            {
+                ; // Spin for the last few microseconds
+            }
+        }
+    }
+
+#ifdef POLLING_APP_TIMER_THREADSAFE
+    (void) pthread_mutex_lock(&_lock);
+    _run_thread_valid = false;
+    (void) pthread_mutex_unlock(&_lock);
+#endif // POLLING_APP_TIMER_THREADSAFE
+
+    return woken;
+}
+#endif // __linux__
+
 #ifdef __cplusplus
 }
 #endif
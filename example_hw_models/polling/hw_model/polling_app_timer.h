@@ -29,6 +29,27 @@ app_timer_error_e polling_app_timer_init(void);
  */
 void polling_app_timer_poll(void);
 
+#ifdef __linux__
+/**
+ * Handles expired timers until 'timeout_ms' milliseconds have elapsed, sleeping in between
+ * until the next timer is due to expire, instead of polling continuously. Use this instead of
+ * calling #polling_app_timer_poll in a loop, if you want the CPU to be idle while waiting.
+ *
+ * The sleep ends POLLING_APP_TIMER_SPIN_USECS microseconds early (0 by default), and the
+ * remaining time is spent polling the clock, which reduces wakeup jitter at the cost of CPU time.
+ *
+ * If POLLING_APP_TIMER_THREADSAFE is defined, then other threads may also call app_timer
+ * functions, and this function will return early if another thread starts a timer that
+ * expires before the current sleep would have ended.
+ *
+ * @param timeout_ms  Maximum time to run for, in milliseconds
+ *
+ * @return True if this function returned early because another thread changed the next
+ *         expiry time, false if the timeout elapsed
+ */
+bool polling_app_timer_run(uint32_t timeout_ms);
+#endif // __linux__
+
 #ifdef __cplusplus
 }
 #endif
@@ -5,6 +5,10 @@
  * @brief Implements platform-specific time measurement function
  */
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // For clock_gettime and CLOCK_MONOTONIC_COARSE
+#endif // __linux__
+
 
 #ifdef __cplusplus
 extern "C" {
@@ -17,7 +21,32 @@ extern "C" {
 #include <Windows.h>
 static uint64_t _perf_freq;
 #elif defined(__linux__)
-#include <sys/time.h>
+#include <time.h>
+#if defined(TIMING_CLOCK_MONOTONIC_COARSE) && defined(TIMING_CLOCK_TSC)
+#error "Only one of TIMING_CLOCK_MONOTONIC_COARSE and TIMING_CLOCK_TSC can be defined"
+#endif // TIMING_CLOCK_MONOTONIC_COARSE && TIMING_CLOCK_TSC
+#if defined(TIMING_CLOCK_TSC)
+#if !defined(__x86_64__)
+#error "TIMING_CLOCK_TSC is only supported on x86_64"
+#endif // __x86_64__
+#include <stdbool.h>
+#include <cpuid.h>
+#include <x86intrin.h>
+
+#define TSC_CALIBRATION_NSECS (20000000L)   ///< How long to count TSC ticks for at timing_init, nanoseconds
+#define TSC_SCALE_SHIFT (32u)               ///< Fractional bits in _tsc_usecs_per_tick
+
+static bool _tsc_usable = false;            ///< True if the TSC is invariant, and has been calibrated
+static uint64_t _tsc_base_ticks;            ///< TSC value at the end of calibration
+static uint64_t _tsc_base_usecs;            ///< CLOCK_MONOTONIC time at the end of calibration, microseconds
+static uint64_t _tsc_usecs_per_tick;        ///< Microseconds per TSC tick, fixed-point with TSC_SCALE_SHIFT fractional bits
+#endif // TIMING_CLOCK_TSC
+
+#if defined(TIMING_CLOCK_MONOTONIC_COARSE)
+#define TIMING_CLOCK_ID CLOCK_MONOTONIC_COARSE
+#else
+#define TIMING_CLOCK_ID CLOCK_MONOTONIC
+#endif // TIMING_CLOCK_MONOTONIC_COARSE
 #elif defined(ARDUINO)
 #include <Arduino.h>
 #else
@@ -40,9 +69,17 @@ uint64_t timing_usecs_elapsed(void)
 
     return (uint64_t) (tick_value / (_perf_freq / 1000000ULL));
 #elif defined(__linux__)
-    struct timeval timer = {.tv_sec=0LL, .tv_usec=0LL};
-    (void) gettimeofday(&timer, NULL);
-    return (uint64_t) ((timer.tv_sec * 1000000LL) + timer.tv_usec);
+#if defined(TIMING_CLOCK_TSC)
+    if (_tsc_usable)
+    {
+        // 128-bit product, so that the conversion does not overflow however long the program runs
+        unsigned __int128 ticks = (unsigned __int128) (__rdtsc() - _tsc_base_ticks);
+        return _tsc_base_usecs + (uint64_t) ((ticks * _tsc_usecs_per_tick) >> TSC_SCALE_SHIFT);
+    }
+#endif // TIMING_CLOCK_TSC
+    struct timespec ts = {.tv_sec=0, .tv_nsec=0};
+    (void) clock_gettime(TIMING_CLOCK_ID, &ts);
+    return (((uint64_t) ts.tv_sec) * 1000000ULL) + (((uint64_t) ts.tv_nsec) / 1000ULL);
 #elif defined(ARDUINO)
     // This will actually wrap at (2^32)-1, since micros() returns a 32-bit
     // value. Make sure to use APP_TIMER_COUNT_UINT32 when using this polling
@@ -66,7 +103,41 @@ void timing_init(void)
         _perf_freq = tcounter.QuadPart;
     }
 #elif defined(__linux__)
-    // Nothing to do
+#if defined(TIMING_CLOCK_TSC)
+    _tsc_usable = false;
+
+    // Only use the TSC if it ticks at a constant rate regardless of CPU frequency/power states
+    unsigned int eax = 0u, ebx = 0u, ecx = 0u, edx = 0u;
+    if ((0 == __get_cpuid(0x80000007u, &eax, &ebx, &ecx, &edx)) || (0u == (edx & (1u << 8))))
+    {
+        return;
+    }
+
+    // Count TSC ticks against CLOCK_MONOTONIC for a short time
+    struct timespec start = {.tv_sec=0, .tv_nsec=0};
+    struct timespec end = {.tv_sec=0, .tv_nsec=0};
+    struct timespec delay = {.tv_sec=0, .tv_nsec=TSC_CALIBRATION_NSECS};
+
+    (void) clock_gettime(CLOCK_MONOTONIC, &start);
+    uint64_t start_ticks = __rdtsc();
+    (void) nanosleep(&delay, NULL);
+    (void) clock_gettime(CLOCK_MONOTONIC, &end);
+    uint64_t end_ticks = __rdtsc();
+
+    uint64_t start_nsecs = (((uint64_t) start.tv_sec) * 1000000000ULL) + ((uint64_t) start.tv_nsec);
+    uint64_t end_nsecs = (((uint64_t) end.tv_sec) * 1000000000ULL) + ((uint64_t) end.tv_nsec);
+
+    if (end_ticks <= start_ticks)
+    {
+        return;
+    }
+
+    unsigned __int128 scaled_usecs = ((unsigned __int128) (end_nsecs - start_nsecs)) << TSC_SCALE_SHIFT;
+    _tsc_usecs_per_tick = (uint64_t) ((scaled_usecs / 1000u) / (end_ticks - start_ticks));
+    _tsc_base_ticks = end_ticks;
+    _tsc_base_usecs = end_nsecs / 1000ULL;
+    _tsc_usable = true;
+#endif // TIMING_CLOCK_TSC
 #elif defined(ARDUINO)
     // Nothing to do
 #else
@@ -74,6 +145,32 @@ void timing_init(void)
 #endif // _WIN32
 }
 
+/**
+ * @see timing.h
+ */
+const char *timing_clock_name(void)
+{
+#if defined(_WIN32)
+    return "QueryPerformanceCounter";
+#elif defined(__linux__)
+#if defined(TIMING_CLOCK_TSC)
+    if (_tsc_usable)
+    {
+        return "TSC";
+    }
+#endif // TIMING_CLOCK_TSC
+#if defined(TIMING_CLOCK_MONOTONIC_COARSE)
+    return "CLOCK_MONOTONIC_COARSE";
+#else
+    return "CLOCK_MONOTONIC";
+#endif // TIMING_CLOCK_MONOTONIC_COARSE
+#elif defined(ARDUINO)
+    return "micros";
+#else
+#error "Platform not supported"
+#endif // _WIN32
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -14,13 +14,28 @@ extern "C" {
 #define TIMING_H
 
 /**
- * Get current time in microseconds
+ * Get current time in microseconds. On Linux, the clock source is selected at build time:
+ *
+ * - CLOCK_MONOTONIC by default
+ * - CLOCK_MONOTONIC_COARSE if TIMING_CLOCK_MONOTONIC_COARSE is defined (cheaper to read, but
+ *   only advances once per kernel tick, typically every 1-4 milliseconds)
+ * - The x86 TSC if TIMING_CLOCK_TSC is defined (cheapest to read, calibrated against
+ *   CLOCK_MONOTONIC by timing_init; falls back to CLOCK_MONOTONIC if the CPU does not have
+ *   an invariant TSC)
  *
  * @return Current time in microseconds
  */
 uint64_t timing_usecs_elapsed(void);
 
 
+/**
+ * Get the name of the clock source used by timing_usecs_elapsed. Only valid after timing_init.
+ *
+ * @return Clock source name
+ */
+const char *timing_clock_name(void);
+
+
 /**
  * Initialize timing
  */
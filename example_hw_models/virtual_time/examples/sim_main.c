@@ -0,0 +1,287 @@
+/**
+ * Runs the same scenario as test_main.c in the polling example (128 single-shot timers that
+ * re-start themselves, and 128 repeating timers, all with different periods) in virtual time,
+ * using the virtual_time app_timer HW model. Virtual time jumps straight from one timer
+ * interrupt to the next, so 10 minutes of timers run in a fraction of a second, and every run
+ * produces exactly the same expiries at exactly the same virtual times.
+ *
+ * Run with the 'million' argument to run 1,000,000 repeating timers with pseudo-random periods
+ * for 60 virtual seconds instead (use a build with the timing wheel for this, see README.rst).
+ *
+ * At the end, the number of expirations and the lateness of each expiry (virtual time at
+ * which the handler ran, minus the virtual time at which it was due) are checked, and a digest
+ * of every (timer, virtual time) expiry pair is printed, which can be compared across runs and
+ * builds to check that the behaviour is bit-for-bit identical.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <time.h>
+
+#include "app_timer_api.h"
+#include "virtual_time_app_timer.h"
+
+
+#ifndef TOTAL_TEST_TIME_SECONDS
+#define TOTAL_TEST_TIME_SECONDS (10 * 60u)   ///< Total virtual runtime for all timers, seconds
+#endif // TOTAL_TEST_TIME_SECONDS
+
+#ifndef SIM_HANDLER_COST_USECS
+#define SIM_HANDLER_COST_USECS (0u)          ///< Virtual time consumed by each timer handler, microseconds
+#endif // SIM_HANDLER_COST_USECS
+
+#define NUM_SINGLE_TIMERS (128u)             ///< Number of single-shot timers to create (re-started in timer callback)
+#define NUM_REPEAT_TIMERS (128u)             ///< Number of repeating timers to create
+
+#define SINGLE_PERIOD_START_MS (200u)        ///< Period of first single-shot timer, in millisecs
+#define SINGLE_PERIOD_INCREMENT_MS (50u)     ///< Increment period for each subsequent single-shot timer by this much
+
+#define REPEAT_PERIOD_START_MS (225u)        ///< Period of first repeating timer, in millisecs
+#define REPEAT_PERIOD_INCREMENT_MS (50u)     ///< Increment period for each subsequent repeating timer by this much
+
+#define MILLION_NUM_TIMERS (1000000u)        ///< Number of repeating timers in 'million' mode
+#define MILLION_MIN_PERIOD_MS (1000u)        ///< Shortest timer period in 'million' mode, in millisecs
+#define MILLION_MAX_PERIOD_MS (60000u)       ///< Longest timer period in 'million' mode, in millisecs
+
+#ifndef MILLION_TOTAL_TIME_SECONDS
+#define MILLION_TOTAL_TIME_SECONDS (60u)     ///< Total virtual runtime for all timers in 'million' mode, seconds
+#endif // MILLION_TOTAL_TIME_SECONDS
+
+#define FNV_OFFSET_BASIS (0xcbf29ce484222325ULL)
+#define FNV_PRIME (0x100000001b3ULL)
+
+
+/**
+ * Represents a single timer instance and all data needed to test it
+ */
+typedef struct
+{
+    app_timer_t timer;       ///< Timer instance
+    uint64_t expected_us;    ///< Virtual time at which the next expiry is due
+    uint32_t ms;             ///< Timer period in milliseconds
+    uint32_t expirations;    ///< Total number of times this timer has expired
+    uint32_t index;          ///< Index of this timer in the table
+    bool restart;            ///< True if the handler re-starts the timer
+} sim_timer_t;
+
+
+static sim_timer_t *_sim_timers = NULL;
+
+static uint64_t _digest = FNV_OFFSET_BASIS;   ///< FNV-1a hash of all (timer index, virtual time) expiry pairs
+static uint64_t _total_late_us = 0u;          ///< Sum of lateness of all expiries
+static uint64_t _highest_late_us = 0u;        ///< Highest lateness of any expiry
+static uint64_t _late_expirations = 0u;       ///< Number of expiries that were late by at least 1 microsecond
+static uint64_t _early_expirations = 0u;      ///< Number of expiries that happened before they were due
+
+
+static void _digest_add(uint64_t value)
+{
+    for (uint32_t i = 0u; i < sizeof(value); i++)
+    {
+        _digest ^= (value >> (i * 8u)) & 0xffu;
+        _digest *= FNV_PRIME;
+    }
+}
+
+
+// Timer callback for all timers
+static void _timer_callback(void *context)
+{
+    sim_timer_t *t = (sim_timer_t *) context;
+    uint64_t now_us = virtual_time_app_timer_now();
+
+    t->expirations += 1u;
+    _digest_add(t->index);
+    _digest_add(now_us);
+
+    if (now_us < t->expected_us)
+    {
+        _early_expirations += 1u;
+    }
+    else
+    {
+        uint64_t late_us = now_us - t->expected_us;
+        _total_late_us += late_us;
+        _late_expirations += (0u < late_us) ? 1u : 0u;
+
+        if (late_us > _highest_late_us)
+        {
+            _highest_late_us = late_us;
+        }
+    }
+
+    if (t->restart)
+    {
+        // Re-start timer instance, next expiry is due one period from now
+        app_timer_error_e err = app_timer_start(&t->timer, t->ms, t);
+        if (APP_TIMER_OK != err)
+        {
+            printf("app_timer_start failed, err: 0x%x\n", err);
+        }
+
+        t->expected_us = now_us + (((uint64_t) t->ms) * 1000ULL);
+    }
+    else
+    {
+        // Repeating timer, next expiry is due one period after this one was due
+        t->expected_us += ((uint64_t) t->ms) * 1000ULL;
+    }
+
+    virtual_time_app_timer_consume(SIM_HANDLER_COST_USECS);
+}
+
+
+// xorshift64, so that 'million' mode periods are the same on every run and every platform
+static uint64_t _next_random(void)
+{
+    static uint64_t state = 88172645463325252ULL;
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+
+static int _create_timers(uint32_t num_timers, bool million_mode)
+{
+    uint32_t repeat_timers_half = NUM_SINGLE_TIMERS + (NUM_REPEAT_TIMERS / 2u);
+
+    for (uint32_t i = 0u; i < num_timers; i++)
+    {
+        sim_timer_t *t = &_sim_timers[i];
+        app_timer_type_e type = APP_TIMER_TYPE_REPEATING;
+
+        t->index = i;
+        t->restart = false;
+
+        if (million_mode)
+        {
+            t->ms = MILLION_MIN_PERIOD_MS + (uint32_t) (_next_random() % (MILLION_MAX_PERIOD_MS - MILLION_MIN_PERIOD_MS + 1u));
+        }
+        else if (i < NUM_SINGLE_TIMERS)
+        {
+            t->ms = SINGLE_PERIOD_START_MS + (i * SINGLE_PERIOD_INCREMENT_MS);
+            t->restart = true;
+            type = APP_TIMER_TYPE_SINGLE_SHOT;
+        }
+        else
+        {
+            /* Half of the repeating timers will have a callback that does not restart itself,
+             * and the other half will have a callback that does restart itself, as in test_main.c */
+            t->ms = REPEAT_PERIOD_START_MS + ((i - NUM_SINGLE_TIMERS) * REPEAT_PERIOD_INCREMENT_MS);
+            t->restart = (i < repeat_timers_half);
+        }
+
+        t->expected_us = ((uint64_t) t->ms) * 1000ULL;
+
+        app_timer_error_e err = app_timer_create(&t->timer, _timer_callback, type);
+        if (APP_TIMER_OK != err)
+        {
+            printf("app_timer_create failed, err: 0x%x\n", err);
+            return err;
+        }
+
+        err = app_timer_start(&t->timer, t->ms, t);
+        if (APP_TIMER_OK != err)
+        {
+            printf("app_timer_start failed, err: 0x%x\n", err);
+            return err;
+        }
+    }
+
+    return 0;
+}
+
+
+int main(int argc, char *argv[])
+{
+    bool million_mode = (argc > 1) && (0 == strcmp(argv[1], "million"));
+    uint32_t num_timers = million_mode ? MILLION_NUM_TIMERS : (NUM_SINGLE_TIMERS + NUM_REPEAT_TIMERS);
+    uint32_t total_test_time_secs = million_mode ? MILLION_TOTAL_TIME_SECONDS : TOTAL_TEST_TIME_SECONDS;
+    uint64_t total_test_time_us = total_test_time_secs * 1000000ULL;
+
+    _sim_timers = calloc(num_timers, sizeof(sim_timer_t));
+    if (NULL == _sim_timers)
+    {
+        printf("failed to allocate %u timers\n", num_timers);
+        return 1;
+    }
+
+    // Initialize virtual_time_app_timer
+    app_timer_error_e err = virtual_time_app_timer_init();
+    if (APP_TIMER_OK != err)
+    {
+        printf("virtual_time_app_timer_init failed, err: 0x%x\n", err);
+        return err;
+    }
+
+    clock_t start_clock = clock();
+
+    int ret = _create_timers(num_timers, million_mode);
+    if (0 != ret)
+    {
+        return ret;
+    }
+
+    clock_t run_clock = clock();
+
+    printf("running %u timers for %u virtual seconds...\n", num_timers, total_test_time_secs);
+    uint64_t interrupts = virtual_time_app_timer_run(total_test_time_us);
+
+    clock_t end_clock = clock();
+
+    // Count expirations, and check that each timer expired once for every period that fully elapsed
+    uint64_t total_expirations = 0u;
+    uint64_t total_expected_expirations = 0u;
+    uint32_t wrong_expiration_counts = 0u;
+
+    for (uint32_t i = 0u; i < num_timers; i++)
+    {
+        sim_timer_t *t = &_sim_timers[i];
+        uint64_t expected = total_test_time_us / (((uint64_t) t->ms) * 1000ULL);
+
+        total_expirations += t->expirations;
+        total_expected_expirations += expected;
+
+        if ((0u == SIM_HANDLER_COST_USECS) && (expected != t->expirations))
+        {
+            wrong_expiration_counts += 1u;
+        }
+
+        (void) app_timer_stop(&t->timer);
+    }
+
+    app_timer_running_count_t ticks = 0u;
+    bool all_stopped = (APP_TIMER_NO_ACTIVE_TIMERS == app_timer_ticks_until_next_expiry(&ticks));
+
+    printf("\n------------ Summary ------------\n\n");
+    printf("Timers                           : %u\n", num_timers);
+    printf("Virtual time                     : %u seconds\n", total_test_time_secs);
+    printf("Handler cost                     : %u virtual microseconds\n", SIM_HANDLER_COST_USECS);
+    printf("Timer interrupts                 : %"PRIu64"\n", interrupts);
+    printf("Expirations                      : %"PRIu64" (expected %"PRIu64")\n",
+           total_expirations, total_expected_expirations);
+    if (0u == SIM_HANDLER_COST_USECS)
+    {
+        printf("Timers with wrong expiry count   : %u\n", wrong_expiration_counts);
+    }
+    printf("Early expirations                : %"PRIu64"\n", _early_expirations);
+    printf("Late expirations                 : %"PRIu64"\n", _late_expirations);
+    printf("Highest lateness                 : %"PRIu64" microseconds\n", _highest_late_us);
+    printf("Average lateness                 : %.3f microseconds\n",
+           (0u == total_expirations) ? 0.0 : (((double) _total_late_us) / ((double) total_expirations)));
+    printf("Expiry digest                    : %016"PRIx64"\n", _digest);
+    printf("Host CPU time to start timers    : %.3f seconds\n", ((double) (run_clock - start_clock)) / CLOCKS_PER_SEC);
+    printf("Host CPU time to run timers      : %.3f seconds\n\n", ((double) (end_clock - run_clock)) / CLOCKS_PER_SEC);
+
+    bool failed = (0u != _early_expirations) || !all_stopped ||
+                  ((0u == SIM_HANDLER_COST_USECS) && ((0u != wrong_expiration_counts) || (0u != _late_expirations)));
+
+    printf("%s\n", failed ? "FAILED" : "PASSED");
+
+    free(_sim_timers);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,159 @@
+/**
+ * @file virtual_time_app_timer.c
+ * @author Erik Nyquist
+ *
+ * @brief Implements an app_timer HW model whose counter is a software variable, so that
+ *        timers can be fast-forwarded through virtual time, deterministically
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "virtual_time_app_timer.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * 60 minutes in microseconds-- virtual time is a 64-bit counter, so this only limits how
+ * long a single counter period can be (longer timer periods are handled by app_timer)
+ */
+#define MAX_COUNT (60u * 60 * 1000u * 1000u)
+
+
+static uint64_t _now_usecs = 0u;
+static uint64_t _period_start_usecs = 0u;
+static app_timer_count_t _period_counts = 0u;
+static bool _running = false;
+
+
+static app_timer_running_count_t _units_to_timer_counts(app_timer_period_t ms)
+{
+    return ((app_timer_running_count_t) ms) * 1000ULL;
+}
+
+
+static app_timer_period_t _timer_counts_to_units(app_timer_running_count_t counts)
+{
+    return (app_timer_period_t) (counts / 1000ULL);
+}
+
+
+static app_timer_count_t _read_timer_counts(void)
+{
+    return (app_timer_count_t) (_now_usecs - _period_start_usecs);
+}
+
+
+static void _set_timer_period_counts(app_timer_count_t counts)
+{
+    _period_counts = counts;
+    _period_start_usecs = _now_usecs;
+}
+
+
+static void _set_timer_running(bool enabled)
+{
+    _running = enabled;
+}
+
+
+static void _set_interrupts_enabled(bool enabled, app_timer_int_status_t *int_status)
+{
+    // Nothing needed here, there is only one thread of execution
+    (void) enabled;
+    (void) int_status;
+}
+
+
+// Initialize hardware model
+static bool _init(void)
+{
+    _now_usecs = 0u;
+    _period_start_usecs = 0u;
+    _period_counts = 0u;
+    _running = false;
+    return true;
+}
+
+
+// Hardware model definition
+static app_timer_hw_model_t _virtual_time_hw_model = {
+    .init = _init,
+    .units_to_timer_counts = _units_to_timer_counts,
+    .read_timer_counts = _read_timer_counts,
+    .set_timer_period_counts = _set_timer_period_counts,
+    .set_timer_running = _set_timer_running,
+    .set_interrupts_enabled = _set_interrupts_enabled,
+    .max_count = MAX_COUNT,
+    .timer_counts_to_units = _timer_counts_to_units
+};
+
+
+/**
+ * @see virtual_time_app_timer.h
+ */
+app_timer_error_e virtual_time_app_timer_init(void)
+{
+    return app_timer_init(&_virtual_time_hw_model);
+}
+
+
+/**
+ * @see virtual_time_app_timer.h
+ */
+uint64_t virtual_time_app_timer_now(void)
+{
+    return _now_usecs;
+}
+
+
+/**
+ * @see virtual_time_app_timer.h
+ */
+void virtual_time_app_timer_consume(uint64_t usecs)
+{
+    _now_usecs += usecs;
+}
+
+
+/**
+ * @see virtual_time_app_timer.h
+ */
+uint64_t virtual_time_app_timer_run(uint64_t usecs)
+{
+    uint64_t end_usecs = _now_usecs + usecs;
+    uint64_t interrupts = 0u;
+
+    while (_running)
+    {
+        uint64_t period_end_usecs = _period_start_usecs + (uint64_t) _period_counts;
+
+        if (period_end_usecs > end_usecs)
+        {
+            break;
+        }
+
+        // Handlers may have consumed time past the end of the period already
+        if (period_end_usecs > _now_usecs)
+        {
+            _now_usecs = period_end_usecs;
+        }
+
+        app_timer_target_count_reached();
+        interrupts += 1u;
+    }
+
+    if (end_usecs > _now_usecs)
+    {
+        _now_usecs = end_usecs;
+    }
+
+    return interrupts;
+}
+
+#ifdef __cplusplus
+}
+#endif
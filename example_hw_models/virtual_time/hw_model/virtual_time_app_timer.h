@@ -0,0 +1,61 @@
+/**
+ * @file virtual_time_app_timer.h
+ * @author Erik Nyquist
+ *
+ * @brief Implements an app_timer HW model whose counter is a software variable, so that
+ *        timers can be fast-forwarded through virtual time, deterministically
+ */
+
+
+#ifndef VIRTUAL_TIME_APP_TIMER_H
+#define VIRTUAL_TIME_APP_TIMER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "app_timer_api.h"
+
+/**
+ * Intitializes the app_timer module with the 'virtual time' hardware model. Virtual time
+ * starts at 0. Timer periods are in milliseconds, and timer counts are virtual microseconds.
+ *
+ * @return #APP_TIMER_OK if initialized successfully
+ */
+app_timer_error_e virtual_time_app_timer_init(void);
+
+/**
+ * Returns the current virtual time
+ *
+ * @return Virtual microseconds elapsed since #virtual_time_app_timer_init
+ */
+uint64_t virtual_time_app_timer_now(void);
+
+/**
+ * Moves virtual time forward by a number of microseconds, without handling any expired
+ * timers. Call this from a timer handler to simulate a handler that takes some time to run.
+ *
+ * @param usecs  Number of virtual microseconds to move forward by
+ */
+void virtual_time_app_timer_consume(uint64_t usecs);
+
+/**
+ * Jumps virtual time straight to the end of each counter period that app_timer sets with
+ * set_timer_period_counts, and calls app_timer_target_count_reached, until there are no more
+ * counter periods ending within 'usecs' microseconds from now. Virtual time is then moved
+ * forward to exactly 'usecs' microseconds from now. Timer handlers are run by this function.
+ *
+ * Nothing else affects virtual time, so running the same sequence of app_timer calls always
+ * produces the same sequence of expiries, at the same virtual times.
+ *
+ * @param usecs  Number of virtual microseconds to run for
+ *
+ * @return Number of times app_timer_target_count_reached was called
+ */
+uint64_t virtual_time_app_timer_run(uint64_t usecs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // VIRTUAL_TIME_APP_TIMER_H
@@ -0,0 +1,493 @@
+/**
+ * Randomized test for app_timer, run against a simulated hardware counter.
+ *
+ * FUZZ_NUM_TIMERS timers (alternating single-shot and repeating) are started with random
+ * periods, and then for each of FUZZ_STEPS steps, either:
+ *
+ * - time moves forward by a random amount, short of the end of the current counter period, and
+ *   a random timer is started, stopped or restarted (or touched, if APP_TIMER_TOUCH_ENABLE is
+ *   defined), or a few random timers are stopped with app_timer_ctx_stop_many, or (rarely) all
+ *   timers are stopped with app_timer_ctx_stop_all
+ * - time moves forward to the end of the current counter period, and
+ *   app_timer_ctx_target_count_reached is called (followed by app_timer_ctx_dispatch_pending,
+ *   if APP_TIMER_DEFERRED_DISPATCH is defined)
+ *
+ * Expiry handlers also start, stop and restart random timers, including their own.
+ *
+ * The expected expiry time of every timer is tracked independently of app_timer, and the test
+ * fails if any timer expires at the wrong time, expires while it should be stopped, or is
+ * still active (or not active) at the end when it should not be. A timer must expire exactly on
+ * time, unless APP_TIMER_SLACK_ENABLE is defined (it may expire up to its slack late), or
+ * APP_TIMER_MAX_EXPIRIES_PER_INTERRUPT or APP_TIMER_MAX_COUNTS_PER_INTERRUPT is defined (it may
+ * expire late, but never early).
+ *
+ * Build this file with app_timer.c and the same APP_TIMER_* options as the build under test;
+ * the program exits with 0 if no errors were found.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <inttypes.h>
+
+#include "app_timer_api.h"
+
+
+#ifndef FUZZ_NUM_TIMERS
+#define FUZZ_NUM_TIMERS (300u)          ///< Number of timers to create
+#endif // FUZZ_NUM_TIMERS
+
+#ifndef FUZZ_STEPS
+#define FUZZ_STEPS (200000u)            ///< Number of random steps to run, may be overridden by the first argument
+#endif // FUZZ_STEPS
+
+#ifndef FUZZ_START_COUNT
+#define FUZZ_START_COUNT (0u)           ///< Initial running count; only useful with APP_TIMER_ABSOLUTE_DEADLINE, e.g. just below the wrap point
+#endif // FUZZ_START_COUNT
+
+#define FUZZ_MAX_COUNT (0xffffu)        ///< Max. value of the simulated hardware counter
+#define FUZZ_MAX_PERIOD (200000u)       ///< Longest timer period, in timer counts
+#define FUZZ_STOP_MANY_COUNT (4u)       ///< Number of timers passed to each app_timer_ctx_stop_many call
+#define FUZZ_MAX_ERRORS_SHOWN (20u)     ///< Stop printing details of errors after this many
+
+
+#if defined(APP_TIMER_MAX_EXPIRIES_PER_INTERRUPT) || defined(APP_TIMER_MAX_COUNTS_PER_INTERRUPT)
+#define FUZZ_ALLOW_LATE_EXPIRY          // Expired timers can be left for the next interrupt
+#endif
+
+
+/**
+ * State of one timer, as expected by the test
+ */
+typedef struct
+{
+    app_timer_t timer;
+    uint32_t index;             ///< Position in _fuzz_timers
+    uint64_t expiry_counts;     ///< Time of the next expected expiry
+    uint64_t period_counts;     ///< Timer period, to work out the next expiry of a repeating timer
+    uint64_t slack_counts;      ///< Max. counts that the timer may expire late by
+    bool active;                ///< True if the timer should be active
+    bool repeating;             ///< True if the timer is a repeating timer
+} fuzz_timer_t;
+
+
+static app_timer_ctx_t _ctx;
+static fuzz_timer_t _fuzz_timers[FUZZ_NUM_TIMERS];
+
+static uint64_t _now_counts = 0u;
+static uint64_t _period_start_counts = 0u;
+static uint64_t _period_counts = 0u;
+static bool _running = false;
+
+static uint64_t _expirations = 0u;
+static uint64_t _errors = 0u;
+static uint64_t _max_late_counts = 0u;
+
+
+static bool _init(void)
+{
+    return true;
+}
+
+
+static app_timer_running_count_t _units_to_timer_counts(app_timer_period_t units)
+{
+    return (app_timer_running_count_t) units;
+}
+
+
+static app_timer_count_t _read_timer_counts(void)
+{
+    return (app_timer_count_t) (_now_counts - _period_start_counts);
+}
+
+
+static void _set_timer_period_counts(app_timer_count_t counts)
+{
+    _period_counts = counts;
+    _period_start_counts = _now_counts;
+}
+
+
+static void _set_timer_running(bool enabled)
+{
+    _running = enabled;
+}
+
+
+static void _set_interrupts_enabled(bool enabled, app_timer_int_status_t *int_status)
+{
+    (void) enabled;
+    (void) int_status;
+}
+
+
+// Hardware model definition
+static app_timer_hw_model_t _fuzz_hw_model = {
+    .init = _init,
+    .units_to_timer_counts = _units_to_timer_counts,
+    .read_timer_counts = _read_timer_counts,
+    .set_timer_period_counts = _set_timer_period_counts,
+    .set_timer_running = _set_timer_running,
+    .set_interrupts_enabled = _set_interrupts_enabled,
+    .max_count = (app_timer_count_t) FUZZ_MAX_COUNT
+};
+
+
+// xorshift64, so that every run with the same options does the same thing
+static uint32_t _next_random(void)
+{
+    static uint64_t state = 88172645463325252ULL;
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return (uint32_t) state;
+}
+
+
+// Mostly short periods, some longer than the hardware counter can count in one period
+static uint64_t _random_period(void)
+{
+    uint32_t r = _next_random() % 100u;
+
+    if (r < 60u)
+    {
+        return 1u + (_next_random() % 5000u);
+    }
+    else if (r < 90u)
+    {
+        return 1u + (_next_random() % 70000u);
+    }
+
+    return 1u + (_next_random() % FUZZ_MAX_PERIOD);
+}
+
+
+static fuzz_timer_t *_random_timer(void)
+{
+    return &_fuzz_timers[_next_random() % FUZZ_NUM_TIMERS];
+}
+
+
+static void _error(void)
+{
+    _errors += 1u;
+}
+
+
+/**
+ * Check the return value of an operation that makes a timer active; APP_TIMER_FULL is
+ * allowed, since a heap of active timers may not have room for every timer
+ */
+static void _check_started(fuzz_timer_t *t, app_timer_error_e err, const char *name)
+{
+    if (APP_TIMER_FULL == err)
+    {
+        t->active = false;
+    }
+    else if (APP_TIMER_OK != err)
+    {
+        printf("%s failed for timer %" PRIu32 ", err: 0x%x\n", name, t->index, err);
+        _error();
+    }
+}
+
+
+static void _set_expected(fuzz_timer_t *t, uint64_t period)
+{
+    t->period_counts = period;
+    t->expiry_counts = _now_counts + period;
+    t->active = true;
+}
+
+
+static void _start(fuzz_timer_t *t)
+{
+    if (t->active)
+    {
+        return;
+    }
+
+    uint64_t period = _random_period();
+    _set_expected(t, period);
+
+#ifdef APP_TIMER_SLACK_ENABLE
+    t->slack_counts = (_next_random() & 1u) ? (period / 4u) : 0u;
+    _check_started(t, app_timer_ctx_start_slack(&_ctx, &t->timer, (app_timer_period_t) period,
+                                                (app_timer_period_t) t->slack_counts, t), "start_slack");
+#else
+    _check_started(t, app_timer_ctx_start(&_ctx, &t->timer, (app_timer_period_t) period, t), "start");
+#endif // APP_TIMER_SLACK_ENABLE
+}
+
+
+static void _stop(fuzz_timer_t *t)
+{
+    (void) app_timer_ctx_stop(&_ctx, &t->timer);
+    t->active = false;
+}
+
+
+static void _restart(fuzz_timer_t *t)
+{
+    uint64_t period = _random_period();
+    _set_expected(t, period);
+    _check_started(t, app_timer_ctx_restart(&_ctx, &t->timer, (app_timer_period_t) period, t), "restart");
+}
+
+
+#ifdef APP_TIMER_TOUCH_ENABLE
+static void _touch(fuzz_timer_t *t)
+{
+    uint64_t period = _random_period();
+    bool active = false;
+
+    /* Timers that are not running are not started by app_timer_ctx_touch; that includes timers
+     * which have expired and are waiting for (or running) their handler, even repeating ones */
+    (void) app_timer_ctx_is_active(&_ctx, &t->timer, &active);
+    if (!active)
+    {
+        if (APP_TIMER_INVALID_STATE != app_timer_ctx_touch(&_ctx, &t->timer, (app_timer_period_t) period))
+        {
+            printf("touch did not fail for inactive timer %" PRIu32 "\n", t->index);
+            _error();
+        }
+
+        return;
+    }
+
+    _set_expected(t, period);
+    _check_started(t, app_timer_ctx_touch(&_ctx, &t->timer, (app_timer_period_t) period), "touch");
+}
+#endif // APP_TIMER_TOUCH_ENABLE
+
+
+// Start, stop, restart or touch a random timer
+static void _random_operation(fuzz_timer_t *t)
+{
+    uint32_t r = _next_random() % 6u;
+
+    if (r < 2u)
+    {
+        _start(t);
+    }
+    else if (r < 4u)
+    {
+        _stop(t);
+    }
+    else if (r < 5u)
+    {
+        _restart(t);
+    }
+    else
+    {
+#ifdef APP_TIMER_TOUCH_ENABLE
+        _touch(t);
+#else
+        _restart(t);
+#endif // APP_TIMER_TOUCH_ENABLE
+    }
+}
+
+
+static void _stop_many(void)
+{
+    app_timer_t *timers[FUZZ_STOP_MANY_COUNT];
+
+    for (uint32_t i = 0u; i < FUZZ_STOP_MANY_COUNT; i++)
+    {
+        fuzz_timer_t *t = _random_timer();
+        timers[i] = &t->timer;
+        t->active = false;
+    }
+
+    (void) app_timer_ctx_stop_many(&_ctx, timers, FUZZ_STOP_MANY_COUNT);
+}
+
+
+static void _stop_all(void)
+{
+    (void) app_timer_ctx_stop_all(&_ctx);
+
+    for (uint32_t i = 0u; i < FUZZ_NUM_TIMERS; i++)
+    {
+        _fuzz_timers[i].active = false;
+    }
+}
+
+
+static void _expiry_handler(void *context)
+{
+    fuzz_timer_t *t = (fuzz_timer_t *) context;
+    _expirations += 1u;
+
+    if (!t->active)
+    {
+        printf("timer %" PRIu32 " expired while stopped, at %" PRIu64 "\n", t->index, _now_counts);
+        _error();
+    }
+
+#if defined(FUZZ_ALLOW_LATE_EXPIRY)
+    bool on_time = (_now_counts >= t->expiry_counts);
+    if (on_time && ((_now_counts - t->expiry_counts) > _max_late_counts))
+    {
+        _max_late_counts = _now_counts - t->expiry_counts;
+    }
+#else
+    bool on_time = (_now_counts >= t->expiry_counts) &&
+                   (_now_counts <= (t->expiry_counts + t->slack_counts));
+#endif // FUZZ_ALLOW_LATE_EXPIRY
+
+    if (!on_time)
+    {
+        if (_errors < FUZZ_MAX_ERRORS_SHOWN)
+        {
+            printf("timer %" PRIu32 " expired at %" PRIu64 ", expected %" PRIu64 " (+%" PRIu64 " slack)\n",
+                   t->index, _now_counts, t->expiry_counts, t->slack_counts);
+        }
+
+        _error();
+    }
+
+    if (t->repeating)
+    {
+        // Slack is counted from each actual expiry, not from the first expected one
+        t->expiry_counts = ((t->slack_counts > 0u) ? _now_counts : t->expiry_counts) + t->period_counts;
+    }
+    else
+    {
+        t->active = false;
+    }
+
+    uint32_t r = _next_random() % 100u;
+
+    if (r < 10u)
+    {
+        _random_operation(_random_timer());
+    }
+    else if ((r < 20u) && t->repeating)
+    {
+        _stop(t);
+    }
+    else if ((r < 40u) && !t->repeating)
+    {
+        _start(t);
+    }
+}
+
+
+static void _step(void)
+{
+    uint64_t end_counts = _period_start_counts + _period_counts;
+
+    if ((end_counts > _now_counts) && ((_next_random() % 100u) < 30u))
+    {
+        _now_counts += _next_random() % (end_counts - _now_counts);
+
+        uint32_t r = _next_random() % 400u;
+
+        if (0u == r)
+        {
+            _stop_all();
+        }
+        else if (r < 100u)
+        {
+            _stop_many();
+        }
+        else
+        {
+            _random_operation(_random_timer());
+        }
+    }
+    else
+    {
+        _now_counts = end_counts;
+        app_timer_ctx_target_count_reached(&_ctx);
+#ifdef APP_TIMER_DEFERRED_DISPATCH
+        (void) app_timer_ctx_dispatch_pending(&_ctx);
+#endif // APP_TIMER_DEFERRED_DISPATCH
+    }
+}
+
+
+int main(int argc, char *argv[])
+{
+    uint64_t steps = (argc > 1) ? strtoull(argv[1], NULL, 0) : FUZZ_STEPS;
+
+    app_timer_error_e err = app_timer_ctx_init(&_ctx, &_fuzz_hw_model);
+    if (APP_TIMER_OK != err)
+    {
+        fprintf(stderr, "app_timer_ctx_init failed, err: 0x%x\n", err);
+        return err;
+    }
+
+    _ctx.running_timer_count = (app_timer_running_count_t) FUZZ_START_COUNT;
+
+    for (uint32_t i = 0u; i < FUZZ_NUM_TIMERS; i++)
+    {
+        fuzz_timer_t *t = &_fuzz_timers[i];
+        t->index = i;
+        t->repeating = (i & 1u);
+
+        err = app_timer_ctx_create(&_ctx, &t->timer, _expiry_handler,
+                                   t->repeating ? APP_TIMER_TYPE_REPEATING : APP_TIMER_TYPE_SINGLE_SHOT);
+        if (APP_TIMER_OK != err)
+        {
+            fprintf(stderr, "app_timer_ctx_create failed, err: 0x%x\n", err);
+            return err;
+        }
+    }
+
+    for (uint32_t i = 0u; i < FUZZ_NUM_TIMERS; i++)
+    {
+        // Move time forward, without going past the end of the current counter period
+        _now_counts += _next_random() % 50u;
+        if (_running && (_now_counts > (_period_start_counts + _period_counts)))
+        {
+            _now_counts = _period_start_counts + _period_counts;
+        }
+
+        _start(&_fuzz_timers[i]);
+    }
+
+    for (uint64_t i = 0u; i < steps; i++)
+    {
+        if (!_running)
+        {
+            // No active timers, start some more
+            for (uint32_t j = 0u; j < 5u; j++)
+            {
+                _start(_random_timer());
+            }
+
+            continue;
+        }
+
+        _step();
+    }
+
+    // Every timer should be in the expected state, and no active timer should be overdue
+    for (uint32_t i = 0u; i < FUZZ_NUM_TIMERS; i++)
+    {
+        fuzz_timer_t *t = &_fuzz_timers[i];
+        bool active = false;
+
+        (void) app_timer_ctx_is_active(&_ctx, &t->timer, &active);
+        if (active != t->active)
+        {
+            printf("timer %" PRIu32 " is %sactive, expected %sactive\n", i, active ? "" : "not ", t->active ? "" : "not ");
+            _error();
+        }
+
+        if (active && ((t->expiry_counts + t->slack_counts) < _now_counts))
+        {
+            printf("timer %" PRIu32 " is overdue, expected at %" PRIu64 "\n", i, t->expiry_counts);
+            _error();
+        }
+    }
+
+    printf("steps: %" PRIu64 ", expirations: %" PRIu64 ", max. late counts: %" PRIu64 ", errors: %" PRIu64 "\n",
+           steps, _expirations, _max_late_counts, _errors);
+
+    return (_errors > 0u) ? 1 : 0;
+}
@@ -1,8 +1,10 @@
 #include "unity.h"
 #include "app_timer_api.h"
 
+#include <stdio.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 
 
 static uint32_t _init_callcount = 0u;
@@ -249,6 +251,83 @@ static void _read_timer_counts_expect(void)
 }
 
 
+// Expect the extra read_timer_counts call made for each expired timer when lateness stats are enabled
+static void _lateness_read_timer_counts_expect(uint32_t num_expired)
+{
+#ifdef APP_TIMER_LATENESS_STATS_ENABLE
+    _read_timer_counts_stack.count += num_expired;
+#else
+    (void) num_expired;
+#endif // APP_TIMER_LATENESS_STATS_ENABLE
+}
+
+
+/* Same as _lateness_read_timer_counts_expect for a single expired timer, with a return value.
+ * Return values are popped from the end, so this must be added after the return values for
+ * any reads that happen after the expired timer is handled. */
+static void _lateness_read_timer_counts_add_retval(app_timer_count_t count)
+{
+#ifdef APP_TIMER_LATENESS_STATS_ENABLE
+    _read_timer_counts_add_retval(count);
+    _read_timer_counts_expect();
+#else
+    (void) count;
+#endif // APP_TIMER_LATENESS_STATS_ENABLE
+}
+
+
+// Expect the extra read_timer_counts calls made when duration stats are enabled
+static void _duration_read_timer_counts_expect(uint32_t num_reads)
+{
+#ifdef APP_TIMER_DURATION_STATS_ENABLE
+    _read_timer_counts_stack.count += num_reads;
+#else
+    (void) num_reads;
+#endif // APP_TIMER_DURATION_STATS_ENABLE
+}
+
+
+/* Same as _duration_read_timer_counts_expect for a single read, with a return value. Return
+ * values are popped from the end, so this must be added after the return values for any
+ * reads that happen after this one. */
+static void _duration_read_timer_counts_add_retval(app_timer_count_t count)
+{
+#ifdef APP_TIMER_DURATION_STATS_ENABLE
+    _read_timer_counts_add_retval(count);
+    _read_timer_counts_expect();
+#else
+    (void) count;
+#endif // APP_TIMER_DURATION_STATS_ENABLE
+}
+
+
+// Expect the extra read made by app_timer_start when the counter is running, and is not re-configured
+static void _duration_start_reads_expect(void)
+{
+    _duration_read_timer_counts_expect(1u);
+}
+
+
+/* Expect the extra reads made by app_timer_stop when the counter is running; one before the
+ * timer is stopped, and one after, unless the counter was re-configured or stopped */
+static void _duration_stop_reads_expect(bool reconfigured)
+{
+    _duration_read_timer_counts_expect(reconfigured ? 1u : 2u);
+}
+
+
+/* Expect the extra reads made by app_timer_target_count_reached; one after interrupts are
+ * disabled, one before the counter is stopped, one at the end, and two for each handler run */
+static void _duration_target_count_reached_reads_expect(uint32_t num_handlers)
+{
+#ifdef APP_TIMER_DEFERRED_DISPATCH
+    // Handlers are run later by app_timer_dispatch_pending
+    num_handlers = 0u;
+#endif // APP_TIMER_DEFERRED_DISPATCH
+    _duration_read_timer_counts_expect(3u + (2u * num_handlers));
+}
+
+
 // Mock units_to_timer_counts functions + stack for call arguments
 
 typedef struct
@@ -296,6 +375,17 @@ static void _units_to_timer_counts_expect(app_timer_period_t period)
 }
 
 
+// Helper function, handles a timer/counter expiry like an interrupt handler would, and then runs
+// any handlers that were deferred by app_timer_target_count_reached
+static void _target_count_reached(void)
+{
+    app_timer_target_count_reached();
+#ifdef APP_TIMER_DEFERRED_DISPATCH
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_dispatch_pending());
+#endif // APP_TIMER_DEFERRED_DISPATCH
+}
+
+
 // Helper function, populate mock HW model function ptrs and save old function ptrs
 static void _setup_mock_funcs(app_timer_hw_model_t *curr_model, app_timer_hw_model_t *saved_model)
 {
@@ -424,6 +514,30 @@ void test_app_timer_stop_not_init(void)
 }
 
 
+// Tests that app_timer_stop_many returns expected error code when module is not initialized
+void test_app_timer_stop_many_not_init(void)
+{
+    app_timer_t t;
+    app_timer_t *timers[1] = {&t};
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_INVALID_STATE, app_timer_stop_many(timers, 1u));
+}
+
+
+// Tests that app_timer_stop_all returns expected error code when module is not initialized
+void test_app_timer_stop_all_not_init(void)
+{
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_INVALID_STATE, app_timer_stop_all());
+}
+
+
+// Tests that app_timer_restart returns expected error code when module is not initialized
+void test_app_timer_restart_not_init(void)
+{
+    app_timer_t t;
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_INVALID_STATE, app_timer_restart(&t, 1000u, NULL));
+}
+
+
 // Tests that app_timer_is_active returns expected error code when module is not initialized
 void test_app_timer_is_active_not_init(void)
 {
@@ -433,6 +547,16 @@ void test_app_timer_is_active_not_init(void)
 }
 
 
+// Tests that app_timer_ticks_until_next_expiry returns expected error code when module is not initialized
+void test_app_timer_ticks_until_next_expiry_not_init(void)
+{
+    app_timer_running_count_t ticks;
+    app_timer_period_t units;
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_INVALID_STATE, app_timer_ticks_until_next_expiry(&ticks));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_INVALID_STATE, app_timer_units_until_next_expiry(&units));
+}
+
+
 // Tests that app_timer_init returns expected error when NULL HW model is passed
 void test_app_timer_init_null_hwmodel_ptr(void)
 {
@@ -567,7 +691,11 @@ void test_app_timer_create_success_repeating(void)
     TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&t, _dummy_handler, APP_TIMER_TYPE_REPEATING));
 
     TEST_ASSERT_EQUAL_PTR(_dummy_handler, t.handler);
+#ifdef APP_TIMER_ABSOLUTE_DEADLINE
+    TEST_ASSERT_EQUAL_INT(0, t.expiry_counts);
+#else
     TEST_ASSERT_EQUAL_INT(0, t.start_counts);
+#endif // APP_TIMER_ABSOLUTE_DEADLINE
     TEST_ASSERT_EQUAL_INT(0, t.total_counts);
     TEST_ASSERT_EQUAL_PTR(NULL, t.next);
     TEST_ASSERT_EQUAL_PTR(NULL, t.previous);
@@ -582,7 +710,11 @@ void test_app_timer_create_success_singleshot(void)
     TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&t, _dummy_handler, APP_TIMER_TYPE_SINGLE_SHOT));
 
     TEST_ASSERT_EQUAL_PTR(_dummy_handler, t.handler);
+#ifdef APP_TIMER_ABSOLUTE_DEADLINE
+    TEST_ASSERT_EQUAL_INT(0, t.expiry_counts);
+#else
     TEST_ASSERT_EQUAL_INT(0, t.start_counts);
+#endif // APP_TIMER_ABSOLUTE_DEADLINE
     TEST_ASSERT_EQUAL_INT(0, t.total_counts);
     TEST_ASSERT_EQUAL_PTR(NULL, t.next);
     TEST_ASSERT_EQUAL_PTR(NULL, t.previous);
@@ -725,6 +857,7 @@ void test_app_timer_start_repeating_already_started(void)
 
     // Stop timer; HW counter should also be stopped since this is the only timer
     _set_interrupts_enabled_expect(false);
+    _duration_stop_reads_expect(true);
     _set_timer_running_expect(false);
     _set_interrupts_enabled_expect(true);
     TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&t));
@@ -777,6 +910,7 @@ void test_app_timer_start_single_shot_already_started(void)
 
     // Stop timer; HW counter should also be stopped since this is the only timer
     _set_interrupts_enabled_expect(false);
+    _duration_stop_reads_expect(true);
     _set_timer_running_expect(false);
     _set_interrupts_enabled_expect(true);
     TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&t));
@@ -824,6 +958,7 @@ void test_app_timer_start_success_period_gt_maxcount(void)
 
     // Stop timer; HW counter should also be stopped since this is the only timer
     _set_interrupts_enabled_expect(false);
+    _duration_stop_reads_expect(true);
     _set_timer_running_expect(false);
     _set_interrupts_enabled_expect(true);
     TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&t));
@@ -879,6 +1014,7 @@ void test_app_timer_start_success_hwcounter_already_running(void)
     _set_interrupts_enabled_expect(false);
     _units_to_timer_counts_expect(2000u);
     _units_to_timer_counts_retval = 2000;
+    _duration_start_reads_expect();
     _set_interrupts_enabled_expect(true);
 
     // Starting timer2
@@ -892,6 +1028,7 @@ void test_app_timer_start_success_hwcounter_already_running(void)
 
     // Stop timer1; HW counter should not be stopped yet
     _set_interrupts_enabled_expect(false);
+    _duration_stop_reads_expect(true);
     _read_timer_counts_expect();
     _set_timer_running_expect(false);
     _set_timer_period_counts_expect(2000u);
@@ -902,6 +1039,7 @@ void test_app_timer_start_success_hwcounter_already_running(void)
 
     // Stop timer2; HW counter should be stopped now
     _set_interrupts_enabled_expect(false);
+    _duration_stop_reads_expect(true);
     _set_timer_running_expect(false);
     _set_interrupts_enabled_expect(true);
     TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&t2));
@@ -982,14 +1120,17 @@ void test_app_timer_start_new_head_timer_changes_counter(void)
 
     // Stop all timers
     _set_interrupts_enabled_expect(false);
+    _duration_stop_reads_expect(false);
     _set_interrupts_enabled_expect(true);
     TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&t1));
 
     _set_interrupts_enabled_expect(false);
+    _duration_stop_reads_expect(false);
     _set_interrupts_enabled_expect(true);
     TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&t2));
 
     _set_interrupts_enabled_expect(false);
+    _duration_stop_reads_expect(true);
     _set_timer_running_expect(false);
     _set_interrupts_enabled_expect(true);
     TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&t3));
@@ -1053,6 +1194,7 @@ void test_app_timer_target_count_reached_multi_singleshot_diff_expiries(void)
     _set_interrupts_enabled_expect(false);
     _units_to_timer_counts_expect(1200u);
     _units_to_timer_counts_retval = 1200;
+    _duration_start_reads_expect();
     _set_interrupts_enabled_expect(true);
 
     // Starting timer2
@@ -1062,6 +1204,7 @@ void test_app_timer_target_count_reached_multi_singleshot_diff_expiries(void)
     _set_interrupts_enabled_expect(false);
     _units_to_timer_counts_expect(1300u);
     _units_to_timer_counts_retval = 1300;
+    _duration_start_reads_expect();
     _set_interrupts_enabled_expect(true);
 
     // Starting timer3
@@ -1093,8 +1236,10 @@ void test_app_timer_target_count_reached_multi_singleshot_diff_expiries(void)
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
     _set_interrupts_enabled_expect(true);
+    _lateness_read_timer_counts_expect(1u);
+    _duration_target_count_reached_reads_expect(1u);
 
-    app_timer_target_count_reached();
+    _target_count_reached();
 
     // Verify only t1 callback was run
     TEST_ASSERT_TRUE(_t1_callback_called);
@@ -1122,8 +1267,10 @@ void test_app_timer_target_count_reached_multi_singleshot_diff_expiries(void)
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
     _set_interrupts_enabled_expect(true);
+    _lateness_read_timer_counts_expect(1u);
+    _duration_target_count_reached_reads_expect(1u);
 
-    app_timer_target_count_reached();
+    _target_count_reached();
 
     // Verify t1 and t2 callbacks have run
     TEST_ASSERT_TRUE(_t1_callback_called);
@@ -1145,11 +1292,12 @@ void test_app_timer_target_count_reached_multi_singleshot_diff_expiries(void)
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
 
-    _read_timer_counts_expect();
     _set_timer_running_expect(false);
     _set_interrupts_enabled_expect(true);
+    _lateness_read_timer_counts_expect(1u);
+    _duration_target_count_reached_reads_expect(1u);
 
-    app_timer_target_count_reached();
+    _target_count_reached();
 
     // Verify t1 and t2 callbacks have run
     TEST_ASSERT_TRUE(_t1_callback_called);
@@ -1203,6 +1351,7 @@ void test_app_timer_target_count_reached_multi_singleshot_same_expiry(void)
     _set_interrupts_enabled_expect(false);
     _units_to_timer_counts_expect(1000u);
     _units_to_timer_counts_retval = 1000;
+    _duration_start_reads_expect();
     _set_interrupts_enabled_expect(true);
 
     // Starting timer2
@@ -1212,6 +1361,7 @@ void test_app_timer_target_count_reached_multi_singleshot_same_expiry(void)
     _set_interrupts_enabled_expect(false);
     _units_to_timer_counts_expect(1000u);
     _units_to_timer_counts_retval = 1000;
+    _duration_start_reads_expect();
     _set_interrupts_enabled_expect(true);
 
     // Starting timer3
@@ -1237,11 +1387,12 @@ void test_app_timer_target_count_reached_multi_singleshot_same_expiry(void)
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
 
-    _read_timer_counts_expect();
     _set_timer_running_expect(false);
     _set_interrupts_enabled_expect(true);
+    _lateness_read_timer_counts_expect(3u);
+    _duration_target_count_reached_reads_expect(3u);
 
-    app_timer_target_count_reached();
+    _target_count_reached();
 
     // Verify all callbacks were run
     TEST_ASSERT_TRUE(_t1_callback_called);
@@ -1311,9 +1462,10 @@ void test_app_timer_target_count_reached_singleshot_period_gt_maxcount(void)
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
     _set_interrupts_enabled_expect(true);
+    _duration_target_count_reached_reads_expect(0u);
 
     // First simulated counter overflow/reset
-    app_timer_target_count_reached();
+    _target_count_reached();
 
     // Verify callback not run yet
     TEST_ASSERT_FALSE(_t1_callback_called);
@@ -1335,9 +1487,10 @@ void test_app_timer_target_count_reached_singleshot_period_gt_maxcount(void)
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
     _set_interrupts_enabled_expect(true);
+    _duration_target_count_reached_reads_expect(0u);
 
     // Second simulated counter overflow/reset
-    app_timer_target_count_reached();
+    _target_count_reached();
 
     // Verify callback not run yet
     TEST_ASSERT_FALSE(_t1_callback_called);
@@ -1353,12 +1506,13 @@ void test_app_timer_target_count_reached_singleshot_period_gt_maxcount(void)
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
 
-    _read_timer_counts_expect();
     _set_timer_running_expect(false);
     _set_interrupts_enabled_expect(true);
+    _lateness_read_timer_counts_expect(1u);
+    _duration_target_count_reached_reads_expect(1u);
 
     // Third and final simulated counter overflow/reset
-    app_timer_target_count_reached();
+    _target_count_reached();
 
     // Verify callback has now run
     TEST_ASSERT_TRUE(_t1_callback_called);
@@ -1424,7 +1578,8 @@ void test_app_timer_target_count_reached_repeating_period_gt_maxcount(void)
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
     _set_interrupts_enabled_expect(true);
-    app_timer_target_count_reached();
+    _duration_target_count_reached_reads_expect(0u);
+    _target_count_reached();
 
     // Verify callback not run yet
     TEST_ASSERT_FALSE(_t1_callback_called);
@@ -1446,9 +1601,10 @@ void test_app_timer_target_count_reached_repeating_period_gt_maxcount(void)
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
     _set_interrupts_enabled_expect(true);
+    _duration_target_count_reached_reads_expect(0u);
 
     // Second simulated counter overflow/reset
-    app_timer_target_count_reached();
+    _target_count_reached();
 
     checkExpectedCalls();
 
@@ -1466,15 +1622,18 @@ void test_app_timer_target_count_reached_repeating_period_gt_maxcount(void)
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
 
+    _read_timer_counts_expect();
     _read_timer_counts_expect();
     _set_timer_running_expect(false);
     _set_timer_period_counts_expect(0xffff);
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
     _set_interrupts_enabled_expect(true);
+    _lateness_read_timer_counts_expect(1u);
+    _duration_target_count_reached_reads_expect(1u);
 
     // Third and final simulated counter overflow/reset
-    app_timer_target_count_reached();
+    _target_count_reached();
 
     checkExpectedCalls();
 
@@ -1491,6 +1650,7 @@ void test_app_timer_target_count_reached_repeating_period_gt_maxcount(void)
 
     // Stop timers
     _set_interrupts_enabled_expect(false);
+    _duration_stop_reads_expect(true);
     _set_timer_running_expect(false);
     _set_interrupts_enabled_expect(true);
     TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&t1));
@@ -1548,6 +1708,7 @@ void test_app_timer_target_count_reached_singleshot_handler_restarted(void)
     _set_interrupts_enabled_expect(false);
     _read_timer_counts_expect();
     _units_to_timer_counts_expect(1000u);
+    _duration_start_reads_expect();
     _set_interrupts_enabled_expect(true);
 
     _read_timer_counts_expect();
@@ -1556,8 +1717,10 @@ void test_app_timer_target_count_reached_singleshot_handler_restarted(void)
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
     _set_interrupts_enabled_expect(true);
+    _lateness_read_timer_counts_expect(1u);
+    _duration_target_count_reached_reads_expect(1u);
 
-    app_timer_target_count_reached();
+    _target_count_reached();
 
     // Verify only t1 callback was run
     TEST_ASSERT_TRUE(_t1_restart_callback_called);
@@ -1576,6 +1739,7 @@ void test_app_timer_target_count_reached_singleshot_handler_restarted(void)
     _set_interrupts_enabled_expect(false);
     _read_timer_counts_expect();
     _units_to_timer_counts_expect(1000u);
+    _duration_start_reads_expect();
     _set_interrupts_enabled_expect(true);
 
     _read_timer_counts_expect();
@@ -1584,8 +1748,10 @@ void test_app_timer_target_count_reached_singleshot_handler_restarted(void)
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
     _set_interrupts_enabled_expect(true);
+    _lateness_read_timer_counts_expect(1u);
+    _duration_target_count_reached_reads_expect(1u);
 
-    app_timer_target_count_reached();
+    _target_count_reached();
 
     // Verify t1 and t2 callbacks have run
     TEST_ASSERT_TRUE(_t1_restart_callback_called);
@@ -1599,6 +1765,7 @@ void test_app_timer_target_count_reached_singleshot_handler_restarted(void)
 
     // Stop timer
     _set_interrupts_enabled_expect(false);
+    _duration_stop_reads_expect(true);
     _set_timer_running_expect(false);
     _set_interrupts_enabled_expect(true);
     TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&_t1_restart));
@@ -1646,6 +1813,7 @@ void test_app_timer_target_count_reached_multi_repeating_diff_expiries(void)
     _set_interrupts_enabled_expect(false);
     _units_to_timer_counts_expect(1200u);
     _units_to_timer_counts_retval = 1200;
+    _duration_start_reads_expect();
     _set_interrupts_enabled_expect(true);
 
     // Starting timer2
@@ -1655,6 +1823,7 @@ void test_app_timer_target_count_reached_multi_repeating_diff_expiries(void)
     _set_interrupts_enabled_expect(false);
     _units_to_timer_counts_expect(1300u);
     _units_to_timer_counts_retval = 1300;
+    _duration_start_reads_expect();
     _set_interrupts_enabled_expect(true);
 
     // Starting timer3
@@ -1672,14 +1841,17 @@ void test_app_timer_target_count_reached_multi_repeating_diff_expiries(void)
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
 
+    _read_timer_counts_expect();
     _read_timer_counts_expect();
     _set_timer_running_expect(false);
     _set_timer_period_counts_expect(200u);
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
     _set_interrupts_enabled_expect(true);
+    _lateness_read_timer_counts_expect(1u);
+    _duration_target_count_reached_reads_expect(1u);
 
-    app_timer_target_count_reached();
+    _target_count_reached();
 
     // Verify only t1 callback was run
     TEST_ASSERT_TRUE(_t1_callback_called);
@@ -1701,14 +1873,17 @@ void test_app_timer_target_count_reached_multi_repeating_diff_expiries(void)
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
 
+    _read_timer_counts_expect();
     _read_timer_counts_expect();
     _set_timer_running_expect(false);
     _set_timer_period_counts_expect(100u);
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
     _set_interrupts_enabled_expect(true);
+    _lateness_read_timer_counts_expect(1u);
+    _duration_target_count_reached_reads_expect(1u);
 
-    app_timer_target_count_reached();
+    _target_count_reached();
 
     // Verify t1 and t2 callbacks have run
     TEST_ASSERT_TRUE(_t1_callback_called);
@@ -1730,14 +1905,17 @@ void test_app_timer_target_count_reached_multi_repeating_diff_expiries(void)
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
 
+    _read_timer_counts_expect();
     _read_timer_counts_expect();
     _set_timer_running_expect(false);
     _set_timer_period_counts_expect(700u);
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
     _set_interrupts_enabled_expect(true);
+    _lateness_read_timer_counts_expect(1u);
+    _duration_target_count_reached_reads_expect(1u);
 
-    app_timer_target_count_reached();
+    _target_count_reached();
 
     // Verify t1 and t2 callbacks have run
     TEST_ASSERT_TRUE(_t1_callback_called);
@@ -1754,6 +1932,7 @@ void test_app_timer_target_count_reached_multi_repeating_diff_expiries(void)
 
     // Stop all timers
     _set_interrupts_enabled_expect(false);
+    _duration_stop_reads_expect(true);
     _read_timer_counts_expect();
     _set_timer_running_expect(false);
     _set_timer_period_counts_expect(1100u);
@@ -1763,6 +1942,7 @@ void test_app_timer_target_count_reached_multi_repeating_diff_expiries(void)
     TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&t1));
 
     _set_interrupts_enabled_expect(false);
+    _duration_stop_reads_expect(true);
     _read_timer_counts_expect();
     _set_timer_running_expect(false);
     _set_timer_period_counts_expect(1300u);
@@ -1772,6 +1952,7 @@ void test_app_timer_target_count_reached_multi_repeating_diff_expiries(void)
     TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&t2));
 
     _set_interrupts_enabled_expect(false);
+    _duration_stop_reads_expect(true);
     _set_timer_running_expect(false);
     _set_interrupts_enabled_expect(true);
     TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&t3));
@@ -1821,6 +2002,7 @@ void test_app_timer_target_count_reached_repeating_inactive_when_stopped(void)
     _set_interrupts_enabled_expect(false);
     _units_to_timer_counts_expect(1200u);
     _units_to_timer_counts_retval = 1200;
+    _duration_start_reads_expect();
     _set_interrupts_enabled_expect(true);
 
     // Starting timer2
@@ -1837,14 +2019,17 @@ void test_app_timer_target_count_reached_repeating_inactive_when_stopped(void)
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
 
+    _read_timer_counts_expect();
     _read_timer_counts_expect();
     _set_timer_running_expect(false);
     _set_timer_period_counts_expect(200u);
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
     _set_interrupts_enabled_expect(true);
+    _lateness_read_timer_counts_expect(1u);
+    _duration_target_count_reached_reads_expect(1u);
 
-    app_timer_target_count_reached();
+    _target_count_reached();
 
     // Verify only t1 callback was run
     TEST_ASSERT_TRUE(_t1_callback_called);
@@ -1863,14 +2048,17 @@ void test_app_timer_target_count_reached_repeating_inactive_when_stopped(void)
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
 
+    _read_timer_counts_expect();
     _read_timer_counts_expect();
     _set_timer_running_expect(false);
     _set_timer_period_counts_expect(800u);
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
     _set_interrupts_enabled_expect(true);
+    _lateness_read_timer_counts_expect(1u);
+    _duration_target_count_reached_reads_expect(1u);
 
-    app_timer_target_count_reached();
+    _target_count_reached();
 
     // Verify t1 and t2 callbacks have run
     TEST_ASSERT_TRUE(_t1_callback_called);
@@ -1893,14 +2081,17 @@ void test_app_timer_target_count_reached_repeating_inactive_when_stopped(void)
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
 
+    _read_timer_counts_expect();
     _read_timer_counts_expect();
     _set_timer_running_expect(false);
     _set_timer_period_counts_expect(400u);
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
     _set_interrupts_enabled_expect(true);
+    _lateness_read_timer_counts_expect(1u);
+    _duration_target_count_reached_reads_expect(1u);
 
-    app_timer_target_count_reached();
+    _target_count_reached();
 
     // Verify t1 callback run
     TEST_ASSERT_TRUE(_t1_callback_called);
@@ -1919,14 +2110,17 @@ void test_app_timer_target_count_reached_repeating_inactive_when_stopped(void)
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
 
+    _read_timer_counts_expect();
     _read_timer_counts_expect();
     _set_timer_running_expect(false);
     _set_timer_period_counts_expect(600u);
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
     _set_interrupts_enabled_expect(true);
+    _lateness_read_timer_counts_expect(1u);
+    _duration_target_count_reached_reads_expect(1u);
 
-    app_timer_target_count_reached();
+    _target_count_reached();
 
     // Verify both callbacks run again
     TEST_ASSERT_TRUE(_t1_callback_called);
@@ -1934,6 +2128,7 @@ void test_app_timer_target_count_reached_repeating_inactive_when_stopped(void)
 
     // Stop all timers
     _set_interrupts_enabled_expect(false);
+    _duration_stop_reads_expect(true);
     _read_timer_counts_expect();
     _set_timer_running_expect(false);
     _set_timer_period_counts_expect(1200u);
@@ -1943,6 +2138,7 @@ void test_app_timer_target_count_reached_repeating_inactive_when_stopped(void)
     TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&t1));
 
     _set_interrupts_enabled_expect(false);
+    _duration_stop_reads_expect(true);
     _set_timer_running_expect(false);
     _set_interrupts_enabled_expect(true);
     TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&t2));
@@ -1996,6 +2192,7 @@ void test_app_timer_target_count_reached_repeating_handler_restarted(void)
     _set_interrupts_enabled_expect(false);
     _read_timer_counts_expect();
     _units_to_timer_counts_expect(1000u);
+    _duration_start_reads_expect();
     _set_interrupts_enabled_expect(true);
 
     _read_timer_counts_expect();
@@ -2004,8 +2201,10 @@ void test_app_timer_target_count_reached_repeating_handler_restarted(void)
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
     _set_interrupts_enabled_expect(true);
+    _lateness_read_timer_counts_expect(1u);
+    _duration_target_count_reached_reads_expect(1u);
 
-    app_timer_target_count_reached();
+    _target_count_reached();
 
     // Verify only t1 callback was run
     TEST_ASSERT_TRUE(_t1_restart_callback_called);
@@ -2024,6 +2223,7 @@ void test_app_timer_target_count_reached_repeating_handler_restarted(void)
     _set_interrupts_enabled_expect(false);
     _read_timer_counts_expect();
     _units_to_timer_counts_expect(1000u);
+    _duration_start_reads_expect();
     _set_interrupts_enabled_expect(true);
 
     _read_timer_counts_expect();
@@ -2032,8 +2232,10 @@ void test_app_timer_target_count_reached_repeating_handler_restarted(void)
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
     _set_interrupts_enabled_expect(true);
+    _lateness_read_timer_counts_expect(1u);
+    _duration_target_count_reached_reads_expect(1u);
 
-    app_timer_target_count_reached();
+    _target_count_reached();
 
     // Verify t1 and t2 callbacks have run
     TEST_ASSERT_TRUE(_t1_restart_callback_called);
@@ -2047,6 +2249,7 @@ void test_app_timer_target_count_reached_repeating_handler_restarted(void)
 
     // Stop timer
     _set_interrupts_enabled_expect(false);
+    _duration_stop_reads_expect(true);
     _set_timer_running_expect(false);
     _set_interrupts_enabled_expect(true);
     TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&_t1_restart));
@@ -2084,6 +2287,7 @@ void test_app_timer_stop_null_timer(void)
     TEST_ASSERT_EQUAL_INT(APP_TIMER_NULL_PARAM, app_timer_stop(NULL));
 
     _set_interrupts_enabled_expect(false);
+    _duration_stop_reads_expect(true);
     _set_timer_running_expect(false);
     _set_interrupts_enabled_expect(true);
     TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&t));
@@ -2124,6 +2328,7 @@ void test_app_timer_stop_already_stopped(void)
 
     // Stop the timer
     _set_interrupts_enabled_expect(false);
+    _duration_stop_reads_expect(true);
     _set_timer_running_expect(false);
     _set_interrupts_enabled_expect(true);
     TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&t));
@@ -2132,7 +2337,7 @@ void test_app_timer_stop_already_stopped(void)
     TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_is_active(&t, &active));
     TEST_ASSERT_FALSE(active);
 
-    // Stop the timer again
+    // Stop the timer again; no active timers, so the counter isn't running and no extra reads
     _set_interrupts_enabled_expect(false);
     _set_interrupts_enabled_expect(true);
     TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&t));
@@ -2174,6 +2379,7 @@ void test_app_timer_stop_repeating_hwcounter_only_stopped_on_last(void)
     _set_interrupts_enabled_expect(false);
     _units_to_timer_counts_expect(1200u);
     _units_to_timer_counts_retval = 1200;
+    _duration_start_reads_expect();
     _set_interrupts_enabled_expect(true);
 
     // Starting timer2
@@ -2181,11 +2387,13 @@ void test_app_timer_stop_repeating_hwcounter_only_stopped_on_last(void)
 
     // Stop timer 2, HW counter should be left alone
     _set_interrupts_enabled_expect(false);
+    _duration_stop_reads_expect(false);
     _set_interrupts_enabled_expect(true);
     TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&t2));
 
     // Stop timer 1, HW counter should be stopped now
     _set_interrupts_enabled_expect(false);
+    _duration_stop_reads_expect(true);
     _set_timer_running_expect(false);
     _set_interrupts_enabled_expect(true);
     TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&t1));
@@ -2223,6 +2431,7 @@ void test_app_timer_stop_single_shot_hwcounter_only_stopped_on_last(void)
     _set_interrupts_enabled_expect(false);
     _units_to_timer_counts_expect(1200u);
     _units_to_timer_counts_retval = 1200;
+    _duration_start_reads_expect();
     _set_interrupts_enabled_expect(true);
 
     // Starting timer2
@@ -2230,11 +2439,13 @@ void test_app_timer_stop_single_shot_hwcounter_only_stopped_on_last(void)
 
     // Stop timer 2, HW counter should be left alone
     _set_interrupts_enabled_expect(false);
+    _duration_stop_reads_expect(false);
     _set_interrupts_enabled_expect(true);
     TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&t2));
 
     // Stop timer 1, HW counter should be stopped now
     _set_interrupts_enabled_expect(false);
+    _duration_stop_reads_expect(true);
     _set_timer_running_expect(false);
     _set_interrupts_enabled_expect(true);
     TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&t1));
@@ -2287,6 +2498,7 @@ void test_app_timer_stop_repeating_reconfig_for_new_head(void)
     _set_interrupts_enabled_expect(false);
     _units_to_timer_counts_expect(1444u);
     _units_to_timer_counts_retval = 1444;
+    _duration_start_reads_expect();
     _set_interrupts_enabled_expect(true);
 
     // Starting timer2
@@ -2305,6 +2517,7 @@ void test_app_timer_stop_repeating_reconfig_for_new_head(void)
     // Stop timer 1, HW counter should be re-configured for timer2
     _read_timer_counts_add_retval(44u); // Simulate 44 ticks having passed since timer start
     _set_interrupts_enabled_expect(false);
+    _duration_read_timer_counts_add_retval(44u);
     _read_timer_counts_expect();
     _set_timer_running_expect(false);
     _set_timer_period_counts_expect(1400u);
@@ -2330,14 +2543,17 @@ void test_app_timer_stop_repeating_reconfig_for_new_head(void)
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
 
+    _read_timer_counts_expect();
     _read_timer_counts_expect();
     _set_timer_running_expect(false);
     _set_timer_period_counts_expect(1444u);
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
     _set_interrupts_enabled_expect(true);
+    _lateness_read_timer_counts_expect(1u);
+    _duration_target_count_reached_reads_expect(1u);
 
-    app_timer_target_count_reached();
+    _target_count_reached();
 
     // Verify timer2 is still active
     TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_is_active(&t1, &active1));
@@ -2351,6 +2567,7 @@ void test_app_timer_stop_repeating_reconfig_for_new_head(void)
 
     // Stop timer 2, HW counter should be stopped now
     _set_interrupts_enabled_expect(false);
+    _duration_stop_reads_expect(true);
     _set_timer_running_expect(false);
     _set_interrupts_enabled_expect(true);
     TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&t2));
@@ -2409,6 +2626,7 @@ void test_app_timer_stop_single_shot_reconfig_for_new_head(void)
     _set_interrupts_enabled_expect(false);
     _units_to_timer_counts_expect(1444u);
     _units_to_timer_counts_retval = 1444;
+    _duration_start_reads_expect();
     _set_interrupts_enabled_expect(true);
 
     // Starting timer2
@@ -2427,6 +2645,7 @@ void test_app_timer_stop_single_shot_reconfig_for_new_head(void)
     // Stop timer 1, HW counter should be re-configured for timer2
     _read_timer_counts_add_retval(44u); // Simulate 44 ticks having passed since timer start
     _set_interrupts_enabled_expect(false);
+    _duration_read_timer_counts_add_retval(44u);
     _read_timer_counts_expect();
     _set_timer_running_expect(false);
     _set_timer_period_counts_expect(1400u);
@@ -2452,11 +2671,12 @@ void test_app_timer_stop_single_shot_reconfig_for_new_head(void)
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
 
-    _read_timer_counts_expect();
     _set_timer_running_expect(false);
     _set_interrupts_enabled_expect(true);
+    _lateness_read_timer_counts_expect(1u);
+    _duration_target_count_reached_reads_expect(1u);
 
-    app_timer_target_count_reached();
+    _target_count_reached();
 
     // Verify both timers inactive
     TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_is_active(&t1, &active1));
@@ -2523,6 +2743,7 @@ void test_app_timer_target_count_context_matches_expected(void)
     _set_interrupts_enabled_expect(false);
     _units_to_timer_counts_expect(1000u);
     _units_to_timer_counts_retval = 1000;
+    _duration_start_reads_expect();
     _set_interrupts_enabled_expect(true);
 
     // Starting timer2
@@ -2545,11 +2766,12 @@ void test_app_timer_target_count_context_matches_expected(void)
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
 
-    _read_timer_counts_expect();
     _set_timer_running_expect(false);
     _set_interrupts_enabled_expect(true);
+    _lateness_read_timer_counts_expect(2u);
+    _duration_target_count_reached_reads_expect(2u);
 
-    app_timer_target_count_reached();
+    _target_count_reached();
 
     // Verify all callbacks were run
     TEST_ASSERT_TRUE(_t1_ctx_callback_called);
@@ -2632,6 +2854,7 @@ void test_app_timer_create_single_to_repeating_in_handler(void)
     _read_timer_counts_expect();
     _units_to_timer_counts_expect(250u);
     _units_to_timer_counts_retval = 250u;
+    _duration_start_reads_expect();
     _set_interrupts_enabled_expect(true);
 
     _read_timer_counts_expect();
@@ -2640,8 +2863,10 @@ void test_app_timer_create_single_to_repeating_in_handler(void)
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
     _set_interrupts_enabled_expect(true);
+    _lateness_read_timer_counts_expect(1u);
+    _duration_target_count_reached_reads_expect(1u);
 
-    app_timer_target_count_reached();
+    _target_count_reached();
 
     // verify timer is still active
     TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_is_active(&_changetype_timer, &active));
@@ -2661,14 +2886,17 @@ void test_app_timer_create_single_to_repeating_in_handler(void)
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
 
+    _read_timer_counts_expect();
     _read_timer_counts_expect();
     _set_timer_running_expect(false);
     _set_timer_period_counts_expect(250u);
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
     _set_interrupts_enabled_expect(true);
+    _lateness_read_timer_counts_expect(1u);
+    _duration_target_count_reached_reads_expect(1u);
 
-    app_timer_target_count_reached();
+    _target_count_reached();
 
     // verify timer is still active
     TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_is_active(&_changetype_timer, &active));
@@ -2688,14 +2916,17 @@ void test_app_timer_create_single_to_repeating_in_handler(void)
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
 
+    _read_timer_counts_expect();
     _read_timer_counts_expect();
     _set_timer_running_expect(false);
     _set_timer_period_counts_expect(250u);
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
     _set_interrupts_enabled_expect(true);
+    _lateness_read_timer_counts_expect(1u);
+    _duration_target_count_reached_reads_expect(1u);
 
-    app_timer_target_count_reached();
+    _target_count_reached();
 
     // verify timer is still active
     TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_is_active(&_changetype_timer, &active));
@@ -2707,6 +2938,7 @@ void test_app_timer_create_single_to_repeating_in_handler(void)
 
     // Stop timer, HW counter should be stopped now
     _set_interrupts_enabled_expect(false);
+    _duration_stop_reads_expect(true);
     _set_timer_running_expect(false);
     _set_interrupts_enabled_expect(true);
     TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&_changetype_timer));
@@ -2786,14 +3018,17 @@ void test_app_timer_create_repeating_to_single_in_handler(void)
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
 
+    _read_timer_counts_expect();
     _read_timer_counts_expect();
     _set_timer_running_expect(false);
     _set_timer_period_counts_expect(250u);
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
     _set_interrupts_enabled_expect(true);
+    _lateness_read_timer_counts_expect(1u);
+    _duration_target_count_reached_reads_expect(1u);
 
-    app_timer_target_count_reached();
+    _target_count_reached();
 
     // Verify only repeat callback was run
     TEST_ASSERT_FALSE(_single_callback2_called);
@@ -2813,14 +3048,17 @@ void test_app_timer_create_repeating_to_single_in_handler(void)
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
 
+    _read_timer_counts_expect();
     _read_timer_counts_expect();
     _set_timer_running_expect(false);
     _set_timer_period_counts_expect(250u);
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
     _set_interrupts_enabled_expect(true);
+    _lateness_read_timer_counts_expect(1u);
+    _duration_target_count_reached_reads_expect(1u);
 
-    app_timer_target_count_reached();
+    _target_count_reached();
 
     // Verify only repeat callback was run
     TEST_ASSERT_FALSE(_single_callback2_called);
@@ -2848,6 +3086,7 @@ void test_app_timer_create_repeating_to_single_in_handler(void)
     _read_timer_counts_expect();
     _units_to_timer_counts_expect(1000u);
     _units_to_timer_counts_retval = 1000u;
+    _duration_start_reads_expect();
     _set_interrupts_enabled_expect(true);
 
     _read_timer_counts_expect();
@@ -2856,8 +3095,10 @@ void test_app_timer_create_repeating_to_single_in_handler(void)
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
     _set_interrupts_enabled_expect(true);
+    _lateness_read_timer_counts_expect(1u);
+    _duration_target_count_reached_reads_expect(1u);
 
-    app_timer_target_count_reached();
+    _target_count_reached();
 
     // Verify only repeat callback has run
     TEST_ASSERT_FALSE(_single_callback2_called);
@@ -2878,12 +3119,13 @@ void test_app_timer_create_repeating_to_single_in_handler(void)
     _read_timer_counts_expect();
 
     // Counter should be disabled this time, since no more active timers
-    _read_timer_counts_expect();
     _set_timer_running_expect(false);
     _set_interrupts_enabled_expect(true);
+    _lateness_read_timer_counts_expect(1u);
+    _duration_target_count_reached_reads_expect(1u);
 
     // Third and final simulated counter overflow/reset
-    app_timer_target_count_reached();
+    _target_count_reached();
 
     // Verify only single callback has run
     TEST_ASSERT_TRUE(_single_callback2_called);
@@ -2952,14 +3194,17 @@ void test_app_timer_stop_repeating_inside_handler(void)
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
 
+    _read_timer_counts_expect();
     _read_timer_counts_expect();
     _set_timer_running_expect(false);
     _set_timer_period_counts_expect(200u);
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
     _set_interrupts_enabled_expect(true);
+    _lateness_read_timer_counts_expect(1u);
+    _duration_target_count_reached_reads_expect(1u);
 
-    app_timer_target_count_reached();
+    _target_count_reached();
 
     // Verify timer is still active
     TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_is_active(&_stop_timer, &active));
@@ -2977,14 +3222,17 @@ void test_app_timer_stop_repeating_inside_handler(void)
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
 
+    _read_timer_counts_expect();
     _read_timer_counts_expect();
     _set_timer_running_expect(false);
     _set_timer_period_counts_expect(200u);
     _set_timer_running_expect(true);
     _read_timer_counts_expect();
     _set_interrupts_enabled_expect(true);
+    _lateness_read_timer_counts_expect(1u);
+    _duration_target_count_reached_reads_expect(1u);
 
-    app_timer_target_count_reached();
+    _target_count_reached();
 
     // Verify timer is still active
     TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_is_active(&_stop_timer, &active));
@@ -3003,15 +3251,17 @@ void test_app_timer_stop_repeating_inside_handler(void)
     _read_timer_counts_expect();
 
     _set_interrupts_enabled_expect(false);
+    _duration_stop_reads_expect(false);
     _set_interrupts_enabled_expect(true);
 
     // Counter should be disabled this time, since no more active timers
-    _read_timer_counts_expect();
     _set_timer_running_expect(false);
     _set_interrupts_enabled_expect(true);
+    _lateness_read_timer_counts_expect(1u);
+    _duration_target_count_reached_reads_expect(1u);
 
     // Third and final simulated counter overflow/reset
-    app_timer_target_count_reached();
+    _target_count_reached();
 
     // verify timer is inactive
     TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_is_active(&_stop_timer, &active));
@@ -3067,44 +3317,61 @@ void test_app_timer_target_count_repeating_reached_compensate_handler_runtime(vo
     _set_timer_running_expect(false);
     _set_timer_period_counts_expect(_hw_model.max_count);
     _set_timer_running_expect(true);
+    _duration_read_timer_counts_add_retval(0u); // After the counter is re-started
     _read_timer_counts_add_retval(0u);
     _read_timer_counts_expect();
 
     _read_timer_counts_add_retval(250u);
     _read_timer_counts_expect();
+    _read_timer_counts_add_retval(250u);
+    _read_timer_counts_expect();
+    _duration_read_timer_counts_add_retval(250u); // After the handler
+    _duration_read_timer_counts_add_retval(0u); // Before the handler
+    _lateness_read_timer_counts_add_retval(0u);
     _set_timer_running_expect(false);
     _set_timer_period_counts_expect(750u);
     _set_timer_running_expect(true);
     _read_timer_counts_add_retval(0u);
     _read_timer_counts_expect();
+    _duration_read_timer_counts_add_retval(0u); // Before the counter is stopped
+    _duration_read_timer_counts_add_retval(0u); // After interrupts are disabled
     _set_interrupts_enabled_expect(true);
 
-    app_timer_target_count_reached();
+    _target_count_reached();
 
     // Expectations for 2nd app_timer_target_count_reached call
     _set_interrupts_enabled_expect(false);
     _set_timer_running_expect(false);
     _set_timer_period_counts_expect(_hw_model.max_count);
     _set_timer_running_expect(true);
+    _duration_read_timer_counts_add_retval(0u); // After the counter is re-started
     _read_timer_counts_add_retval(0u);
     _read_timer_counts_expect();
 
     _read_timer_counts_add_retval(333u);
     _read_timer_counts_expect();
+    _read_timer_counts_add_retval(333u);
+    _read_timer_counts_expect();
+    _duration_read_timer_counts_add_retval(333u); // After the handler
+    _duration_read_timer_counts_add_retval(0u); // Before the handler
+    _lateness_read_timer_counts_add_retval(0u);
     _set_timer_running_expect(false);
     _set_timer_period_counts_expect(667u);
     _set_timer_running_expect(true);
     _read_timer_counts_add_retval(0u);
     _read_timer_counts_expect();
+    _duration_read_timer_counts_add_retval(0u); // Before the counter is stopped
+    _duration_read_timer_counts_add_retval(0u); // After interrupts are disabled
     _set_interrupts_enabled_expect(true);
 
-    app_timer_target_count_reached();
+    _target_count_reached();
 
     // Verify callback was run
     TEST_ASSERT_TRUE(_t1_callback_called);
 
     // Stop the timer
     _set_interrupts_enabled_expect(false);
+    _duration_stop_reads_expect(true);
     _set_timer_running_expect(false);
     _set_interrupts_enabled_expect(true);
     TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&t1));
@@ -3161,25 +3428,34 @@ void test_app_timer_target_count_repeating_handler_runtime_gt_maxcount(void)
     _set_timer_running_expect(false);
     _set_timer_period_counts_expect(_hw_model.max_count);
     _set_timer_running_expect(true);
+    _duration_read_timer_counts_add_retval(0u); // After the counter is re-started
     _read_timer_counts_add_retval(0u);
     _read_timer_counts_expect();
 
     _read_timer_counts_add_retval(0xffffu);
     _read_timer_counts_expect();
+    _read_timer_counts_add_retval(0xffffu);
+    _read_timer_counts_expect();
+    _duration_read_timer_counts_add_retval(0xffffu); // After the handler
+    _duration_read_timer_counts_add_retval(0u); // Before the handler
+    _lateness_read_timer_counts_add_retval(0u);
     _set_timer_running_expect(false);
     _set_timer_period_counts_expect(1u);
     _set_timer_running_expect(true);
     _read_timer_counts_add_retval(0u);
     _read_timer_counts_expect();
+    _duration_read_timer_counts_add_retval(0u); // Before the counter is stopped
+    _duration_read_timer_counts_add_retval(0u); // After interrupts are disabled
     _set_interrupts_enabled_expect(true);
 
-    app_timer_target_count_reached();
+    _target_count_reached();
 
     // Verify callback was run
     TEST_ASSERT_TRUE(_t1_callback_called);
 
     // Stop the timer
     _set_interrupts_enabled_expect(false);
+    _duration_stop_reads_expect(true);
     _set_timer_running_expect(false);
     _set_interrupts_enabled_expect(true);
     TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&t1));
@@ -3194,6 +3470,2109 @@ void test_app_timer_target_count_repeating_handler_runtime_gt_maxcount(void)
 }
 
 
+// Tests that app_timer_start_many checks all parameters before starting any timers
+void test_app_timer_start_many_invalid_params(void)
+{
+    app_timer_t t1, t2;
+    app_timer_t *timers[2] = {&t1, &t2};
+    app_timer_t *null_timers[2] = {&t1, NULL};
+    app_timer_period_t periods[2] = {1000u, 2000u};
+    app_timer_period_t zero_periods[2] = {1000u, 0u};
+    bool active;
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&t1, _dummy_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&t2, _dummy_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+
+    app_timer_hw_model_t saved_model;
+    _setup_mock_funcs(&_hw_model, &saved_model);
+
+    // No HW model functions should be called
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_NULL_PARAM, app_timer_start_many(NULL, periods, NULL, 2u));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_NULL_PARAM, app_timer_start_many(timers, NULL, NULL, 2u));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_NULL_PARAM, app_timer_start_many(null_timers, periods, NULL, 2u));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_INVALID_PARAM, app_timer_start_many(timers, zero_periods, NULL, 2u));
+
+    // Period too long for the running counter, no timers should be started (last timer is converted first)
+    _units_to_timer_counts_expect(2000u);
+    _units_to_timer_counts_retval = ((app_timer_running_count_t) 1u) << ((sizeof(app_timer_running_count_t) * 8u) - 1u);
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_INVALID_PARAM, app_timer_start_many(timers, periods, NULL, 2u));
+    checkExpectedCalls();
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_is_active(&t1, &active));
+    TEST_ASSERT_FALSE(active);
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_is_active(&t2, &active));
+    TEST_ASSERT_FALSE(active);
+
+    // Restore valid values
+    _cleanup_mock_funcs(&_hw_model, &saved_model);
+}
+
+
+// Tests that app_timer_start_many only disables interrupts once, and only configures the counter once
+void test_app_timer_start_many_single_reconfig(void)
+{
+    app_timer_t t1, t2, t3, t4;
+    app_timer_t *timers[3] = {&t1, &t2, &t3};
+    app_timer_period_t periods[3] = {3000u, 1000u, 2000u};
+    int contexts[3] = {1, 2, 3};
+    void *context_ptrs[3] = {&contexts[0], &contexts[1], &contexts[2]};
+    bool active;
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&t1, _dummy_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&t2, _dummy_handler, APP_TIMER_TYPE_REPEATING));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&t3, _dummy_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&t4, _dummy_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+
+    app_timer_hw_model_t saved_model;
+    _setup_mock_funcs(&_hw_model, &saved_model);
+
+    /* No timers running; periods converted before the critical section (last timer first), one
+     * critical section, and one counter configuration for the whole batch */
+    _units_to_timer_counts_expect(2000u);
+    _units_to_timer_counts_expect(1000u);
+    _units_to_timer_counts_expect(3000u);
+    _units_to_timer_counts_retval = 1234;
+    _set_interrupts_enabled_expect(false);
+    _set_timer_running_expect(false);
+    _set_timer_period_counts_expect(1234);
+    _set_timer_running_expect(true);
+    _read_timer_counts_expect();
+    _set_interrupts_enabled_expect(true);
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start_many(timers, periods, context_ptrs, 3u));
+    checkExpectedCalls();
+
+    for (uint32_t i = 0u; i < 3u; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_is_active(timers[i], &active));
+        TEST_ASSERT_TRUE(active);
+        TEST_ASSERT_EQUAL_PTR(context_ptrs[i], timers[i]->context);
+    }
+
+    // Second batch, with already-active timers and a new timer that does not become the head
+    app_timer_t *timers2[3] = {&t2, &t4, &t2};
+    app_timer_period_t periods2[3] = {1000u, 5000u, 1000u};
+
+    _units_to_timer_counts_expect(5000u);
+    _units_to_timer_counts_retval = 5678;
+    _set_interrupts_enabled_expect(false);
+    _read_timer_counts_expect();
+    _set_interrupts_enabled_expect(true);
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start_many(timers2, periods2, NULL, 3u));
+    checkExpectedCalls();
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_is_active(&t4, &active));
+    TEST_ASSERT_TRUE(active);
+    TEST_ASSERT_EQUAL_PTR(NULL, t4.context);
+
+    // Stop all timers without checking expectations
+    _hw_model.read_timer_counts = _callcount_read_timer_counts;
+    _hw_model.set_timer_running = _callcount_set_timer_running;
+    _hw_model.set_interrupts_enabled = _callcount_set_interrupts_enabled;
+    _hw_model.set_timer_period_counts = _callcount_set_timer_period_counts;
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&t1));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&t2));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&t3));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&t4));
+
+    // Restore valid values
+    _cleanup_mock_funcs(&_hw_model, &saved_model);
+}
+
+
+// Helper function, starts three timers with the call-count HW model functions (so no
+// expectations are needed), and then re-populates the mock HW model functions
+static void _start_three_timers(app_timer_t *t1, app_timer_t *t2, app_timer_t *t3)
+{
+    _hw_model.read_timer_counts = _callcount_read_timer_counts;
+    _hw_model.set_timer_running = _callcount_set_timer_running;
+    _hw_model.set_interrupts_enabled = _callcount_set_interrupts_enabled;
+    _hw_model.set_timer_period_counts = _callcount_set_timer_period_counts;
+    _hw_model.units_to_timer_counts = _callcount_units_to_timer_counts;
+    _callcount_read_timer_counts_returnval = 0u;
+
+    _callcount_units_to_timer_counts_returnval = 1000u;
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start(t1, 1000u, NULL));
+    _callcount_units_to_timer_counts_returnval = 2000u;
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start(t2, 2000u, NULL));
+    _callcount_units_to_timer_counts_returnval = 3000u;
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start(t3, 3000u, NULL));
+
+    _hw_model.read_timer_counts = _mock_read_timer_counts;
+    _hw_model.set_timer_running = _mock_set_timer_running;
+    _hw_model.set_interrupts_enabled = _mock_set_interrupts_enabled;
+    _hw_model.set_timer_period_counts = _mock_set_timer_period_counts;
+    _hw_model.units_to_timer_counts = _mock_units_to_timer_counts;
+}
+
+
+// Tests that app_timer_stop_many only disables interrupts once, and only re-configures the
+// counter once, after the whole batch has been stopped
+void test_app_timer_stop_many_single_reconfig(void)
+{
+    app_timer_t t1, t2, t3;
+    app_timer_t *timers[2] = {&t1, &t2};
+    app_timer_t *null_timers[2] = {&t3, NULL};
+    bool active;
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&t1, _dummy_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&t2, _dummy_handler, APP_TIMER_TYPE_REPEATING));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&t3, _dummy_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+
+    app_timer_hw_model_t saved_model;
+    _setup_mock_funcs(&_hw_model, &saved_model);
+    _start_three_timers(&t1, &t2, &t3);
+
+    // Stop the first two timers, counter should be re-configured once for timer3
+    _read_timer_counts_add_retval(100u); // Simulate 100 ticks having passed since timer start
+    _set_interrupts_enabled_expect(false);
+    _read_timer_counts_expect();
+    _set_timer_running_expect(false);
+    _set_timer_period_counts_expect(2900u);
+    _set_timer_running_expect(true);
+    _read_timer_counts_expect();
+    _set_interrupts_enabled_expect(true);
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop_many(timers, 2u));
+    checkExpectedCalls();
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_is_active(&t1, &active));
+    TEST_ASSERT_FALSE(active);
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_is_active(&t2, &active));
+    TEST_ASSERT_FALSE(active);
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_is_active(&t3, &active));
+    TEST_ASSERT_TRUE(active);
+
+    // Stopping already-stopped timers should not touch the counter
+    _set_interrupts_enabled_expect(false);
+    _set_interrupts_enabled_expect(true);
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop_many(timers, 2u));
+    checkExpectedCalls();
+
+    // Invalid parameters; no HW model functions should be called, and no timers stopped
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_NULL_PARAM, app_timer_stop_many(NULL, 2u));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_NULL_PARAM, app_timer_stop_many(null_timers, 2u));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_is_active(&t3, &active));
+    TEST_ASSERT_TRUE(active);
+
+    // Stop the last timer, counter should be stopped
+    _set_interrupts_enabled_expect(false);
+    _set_timer_running_expect(false);
+    _set_interrupts_enabled_expect(true);
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop_many(null_timers, 1u));
+    checkExpectedCalls();
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_is_active(&t3, &active));
+    TEST_ASSERT_FALSE(active);
+
+    // Restore valid values
+    _cleanup_mock_funcs(&_hw_model, &saved_model);
+}
+
+
+// Tests that app_timer_stop_all stops all active timers, and only stops the counter once
+void test_app_timer_stop_all(void)
+{
+    app_timer_t t1, t2, t3;
+    bool active;
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&t1, _dummy_handler, APP_TIMER_TYPE_REPEATING));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&t2, _dummy_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&t3, _dummy_handler, APP_TIMER_TYPE_REPEATING));
+
+    app_timer_hw_model_t saved_model;
+    _setup_mock_funcs(&_hw_model, &saved_model);
+    _start_three_timers(&t1, &t2, &t3);
+
+    _set_interrupts_enabled_expect(false);
+    _set_timer_running_expect(false);
+    _set_interrupts_enabled_expect(true);
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop_all());
+    checkExpectedCalls();
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_is_active(&t1, &active));
+    TEST_ASSERT_FALSE(active);
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_is_active(&t2, &active));
+    TEST_ASSERT_FALSE(active);
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_is_active(&t3, &active));
+    TEST_ASSERT_FALSE(active);
+
+    // No active timers, counter should not be touched
+    _set_interrupts_enabled_expect(false);
+    _set_interrupts_enabled_expect(true);
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop_all());
+    checkExpectedCalls();
+
+    // Restore valid values
+    _cleanup_mock_funcs(&_hw_model, &saved_model);
+}
+
+
+// Tests that app_timer_restart returns expected error codes for invalid parameters
+void test_app_timer_restart_invalid_params(void)
+{
+    app_timer_t t;
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&t, _dummy_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_NULL_PARAM, app_timer_restart(NULL, 1000u, NULL));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_INVALID_PARAM, app_timer_restart(&t, 0u, NULL));
+}
+
+
+// Tests that app_timer_restart only re-configures the counter when the head timer changes
+void test_app_timer_restart_reconfig_only_for_head(void)
+{
+    app_timer_t t1, t2, t3;
+    int context = 5;
+    bool active;
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&t1, _dummy_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&t2, _dummy_handler, APP_TIMER_TYPE_REPEATING));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&t3, _dummy_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+
+    app_timer_hw_model_t saved_model;
+    _setup_mock_funcs(&_hw_model, &saved_model);
+    _start_three_timers(&t1, &t2, &t3);
+
+    // Restart timer3 with a later expiry time, counter should not be touched
+    _units_to_timer_counts_expect(5000u);
+    _units_to_timer_counts_retval = 5000u;
+    _set_interrupts_enabled_expect(false);
+    _read_timer_counts_expect();
+    _set_interrupts_enabled_expect(true);
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_restart(&t3, 5000u, &context));
+    checkExpectedCalls();
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_is_active(&t3, &active));
+    TEST_ASSERT_TRUE(active);
+    TEST_ASSERT_EQUAL_PTR(&context, t3.context);
+
+    /* Restart timer1 (head) so that it expires after timer2, counter should be
+     * re-configured for timer2 */
+    _read_timer_counts_add_retval(0u);
+    _read_timer_counts_add_retval(100u); // Simulate 100 ticks having passed since timer start
+    _read_timer_counts_add_retval(100u);
+    _units_to_timer_counts_expect(2500u);
+    _units_to_timer_counts_retval = 2500u;
+    _set_interrupts_enabled_expect(false);
+    _read_timer_counts_expect();
+    _read_timer_counts_expect();
+    _set_timer_running_expect(false);
+    _set_timer_period_counts_expect(1900u);
+    _set_timer_running_expect(true);
+    _read_timer_counts_expect();
+    _set_interrupts_enabled_expect(true);
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_restart(&t1, 2500u, NULL));
+    checkExpectedCalls();
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_is_active(&t1, &active));
+    TEST_ASSERT_TRUE(active);
+
+    // Restart timer3 so that it becomes the head, counter should be re-configured for timer3
+    _read_timer_counts_add_retval(0u);
+    _read_timer_counts_add_retval(150u);
+    _read_timer_counts_add_retval(150u);
+    _units_to_timer_counts_expect(50u);
+    _units_to_timer_counts_retval = 50u;
+    _set_interrupts_enabled_expect(false);
+    _read_timer_counts_expect();
+    _read_timer_counts_expect();
+    _set_timer_running_expect(false);
+    _set_timer_period_counts_expect(50u);
+    _set_timer_running_expect(true);
+    _read_timer_counts_expect();
+    _set_interrupts_enabled_expect(true);
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_restart(&t3, 50u, NULL));
+    checkExpectedCalls();
+
+    // Stop all timers
+    _set_interrupts_enabled_expect(false);
+    _set_timer_running_expect(false);
+    _set_interrupts_enabled_expect(true);
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop_all());
+    checkExpectedCalls();
+
+    // Restarting a stopped timer should start it
+    _units_to_timer_counts_expect(1234u);
+    _units_to_timer_counts_retval = 1234u;
+    _set_interrupts_enabled_expect(false);
+    _set_timer_running_expect(false);
+    _set_timer_period_counts_expect(1234u);
+    _set_timer_running_expect(true);
+    _read_timer_counts_expect();
+    _set_interrupts_enabled_expect(true);
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_restart(&t2, 1234u, NULL));
+    checkExpectedCalls();
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_is_active(&t2, &active));
+    TEST_ASSERT_TRUE(active);
+
+    _set_interrupts_enabled_expect(false);
+    _duration_stop_reads_expect(true);
+    _set_timer_running_expect(false);
+    _set_interrupts_enabled_expect(true);
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&t2));
+    checkExpectedCalls();
+
+    // Restore valid values
+    _cleanup_mock_funcs(&_hw_model, &saved_model);
+}
+
+
+#ifdef APP_TIMER_TOUCH_ENABLE
+// Tests that app_timer_touch only records a later expiry time, and that the timer is
+// re-inserted at the later expiry time instead of running its handler
+void test_app_timer_touch_lazy_reinsert(void)
+{
+    app_timer_t t1, t2, t3;
+    bool active;
+
+    _t1_callback_called = false;
+    _t2_callback_called = false;
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&t1, _t1_callback, APP_TIMER_TYPE_SINGLE_SHOT));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&t2, _t2_callback, APP_TIMER_TYPE_SINGLE_SHOT));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&t3, _dummy_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+
+    app_timer_hw_model_t saved_model;
+    _setup_mock_funcs(&_hw_model, &saved_model);
+    _start_three_timers(&t1, &t2, &t3);
+
+#ifdef APP_TIMER_STATS_ENABLE
+    app_timer_stats_t stats;
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stats(&stats));
+    uint32_t reinserts = stats.num_touch_reinserts;
+#endif // APP_TIMER_STATS_ENABLE
+
+    // Extend timer1 (head) to expire after timer2, counter should not be touched
+    _read_timer_counts_add_retval(100u); // Simulate 100 ticks having passed since timer start
+    _units_to_timer_counts_expect(2500u);
+    _units_to_timer_counts_retval = 2500u;
+    _set_interrupts_enabled_expect(false);
+    _read_timer_counts_expect();
+    _set_interrupts_enabled_expect(true);
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_touch(&t1, 2500u));
+    checkExpectedCalls();
+
+    /* Old expiry time of timer1 reached; handler should not run, and counter should
+     * be configured for timer2 */
+    _set_interrupts_enabled_expect(false);
+    _set_timer_running_expect(false);
+    _set_timer_period_counts_expect(_hw_model.max_count);
+    _set_timer_running_expect(true);
+    _read_timer_counts_expect();
+
+    _read_timer_counts_expect();
+    _set_timer_running_expect(false);
+    _set_timer_period_counts_expect(1000u);
+    _set_timer_running_expect(true);
+    _read_timer_counts_expect();
+    _set_interrupts_enabled_expect(true);
+    _duration_target_count_reached_reads_expect(0u);
+
+    _target_count_reached();
+    checkExpectedCalls();
+
+    TEST_ASSERT_FALSE(_t1_callback_called);
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_is_active(&t1, &active));
+    TEST_ASSERT_TRUE(active);
+
+#ifdef APP_TIMER_STATS_ENABLE
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stats(&stats));
+    TEST_ASSERT_EQUAL_UINT32(reinserts + 1u, stats.num_touch_reinserts);
+#endif // APP_TIMER_STATS_ENABLE
+
+    // Timer2 expires, counter should be configured for the new expiry time of timer1
+    _set_interrupts_enabled_expect(false);
+    _set_timer_running_expect(false);
+    _set_timer_period_counts_expect(_hw_model.max_count);
+    _set_timer_running_expect(true);
+    _read_timer_counts_expect();
+
+    _read_timer_counts_expect();
+    _set_timer_running_expect(false);
+    _set_timer_period_counts_expect(600u);
+    _set_timer_running_expect(true);
+    _read_timer_counts_expect();
+    _set_interrupts_enabled_expect(true);
+    _duration_target_count_reached_reads_expect(1u);
+
+    _target_count_reached();
+    checkExpectedCalls();
+
+    TEST_ASSERT_FALSE(_t1_callback_called);
+    TEST_ASSERT_TRUE(_t2_callback_called);
+
+    // Earlier expiry time, timer1 should be moved, and counter re-configured, in one critical section
+    _units_to_timer_counts_expect(10u);
+    _units_to_timer_counts_retval = 10u;
+    _set_interrupts_enabled_expect(false);
+    _read_timer_counts_expect();
+    _read_timer_counts_expect();
+    _set_timer_running_expect(false);
+    _set_timer_period_counts_expect(10u);
+    _set_timer_running_expect(true);
+    _read_timer_counts_expect();
+    _set_interrupts_enabled_expect(true);
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_touch(&t1, 10u));
+    checkExpectedCalls();
+
+    // Timer1 expires at its new expiry time, and the handler should run
+    _set_interrupts_enabled_expect(false);
+    _set_timer_running_expect(false);
+    _set_timer_period_counts_expect(_hw_model.max_count);
+    _set_timer_running_expect(true);
+    _read_timer_counts_expect();
+
+    _read_timer_counts_expect();
+    _set_timer_running_expect(false);
+    _set_timer_period_counts_expect(990u);
+    _set_timer_running_expect(true);
+    _read_timer_counts_expect();
+    _set_interrupts_enabled_expect(true);
+    _duration_target_count_reached_reads_expect(1u);
+
+    _target_count_reached();
+    checkExpectedCalls();
+
+    TEST_ASSERT_TRUE(_t1_callback_called);
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_is_active(&t1, &active));
+    TEST_ASSERT_FALSE(active);
+
+    // Stop all timers
+    _set_interrupts_enabled_expect(false);
+    _set_timer_running_expect(false);
+    _set_interrupts_enabled_expect(true);
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop_all());
+    checkExpectedCalls();
+
+    // Restore valid values
+    _cleanup_mock_funcs(&_hw_model, &saved_model);
+}
+#endif // APP_TIMER_TOUCH_ENABLE
+
+
+// Virtual-time hardware model, for tests that need to run timers for a long time
+
+#define VIRTUAL_TIME_NUM_TIMERS (4u)
+
+typedef struct
+{
+    app_timer_t timer;
+    uint64_t period;
+    uint64_t expected_expiry;
+    uint32_t expiry_count;
+} virtual_time_timer_t;
+
+// Simulated hardware counter, driven by virtual time
+typedef struct
+{
+    uint64_t now;           // Current virtual time, in counts
+    uint64_t period_start;  // Virtual time when the counter period was last configured
+    uint64_t period;        // Counter period, in counts
+    bool running;           // True if the counter is running
+} virtual_counter_t;
+
+static app_timer_count_t _virtual_counter_read(virtual_counter_t *counter)
+{
+    return (app_timer_count_t) (counter->now - counter->period_start);
+}
+
+static void _virtual_counter_set_period(virtual_counter_t *counter, app_timer_count_t counts)
+{
+    counter->period_start = counter->now;
+    counter->period = counts;
+}
+
+// Counter used by the default timer context
+static virtual_counter_t _virtual_time;
+static uint32_t _virtual_time_late_expiries = 0u;
+static virtual_time_timer_t _virtual_time_timers[VIRTUAL_TIME_NUM_TIMERS];
+
+static app_timer_running_count_t _virtual_time_units_to_timer_counts(app_timer_period_t time)
+{
+    return (app_timer_running_count_t) time;
+}
+
+static app_timer_count_t _virtual_time_read_timer_counts(void)
+{
+    return _virtual_counter_read(&_virtual_time);
+}
+
+static void _virtual_time_set_timer_period_counts(app_timer_count_t counts)
+{
+    _virtual_counter_set_period(&_virtual_time, counts);
+}
+
+static void _virtual_time_set_timer_running(bool enabled)
+{
+    _virtual_time.running = enabled;
+}
+
+// HW model saved by _virtual_time_setup, restored by _virtual_time_restore
+static app_timer_hw_model_t _virtual_time_saved_model;
+
+// Sets up the virtual-time HW model, with timer periods in timer counts, and virtual time at 0
+static void _virtual_time_setup(void)
+{
+    _virtual_time_saved_model = _hw_model;
+    _hw_model.max_count = (app_timer_count_t) 0xffffffu;
+    _hw_model.units_to_timer_counts = _virtual_time_units_to_timer_counts;
+    _hw_model.read_timer_counts = _virtual_time_read_timer_counts;
+    _hw_model.set_timer_period_counts = _virtual_time_set_timer_period_counts;
+    _hw_model.set_timer_running = _virtual_time_set_timer_running;
+    _hw_model.set_interrupts_enabled = _callcount_set_interrupts_enabled;
+    _hw_model.timer_counts_to_units = NULL;
+
+    (void) memset(&_virtual_time, 0, sizeof(_virtual_time));
+}
+
+// Restores the HW model saved by _virtual_time_setup
+static void _virtual_time_restore(void)
+{
+    _hw_model = _virtual_time_saved_model;
+}
+
+static void _virtual_time_handler(void *context)
+{
+    virtual_time_timer_t *vt = (virtual_time_timer_t *) context;
+
+    if (_virtual_time.now != vt->expected_expiry)
+    {
+        // Stop the timer, so a timer that keeps expiring at the wrong time can't hang the test
+        _virtual_time_late_expiries += 1u;
+        app_timer_stop(&vt->timer);
+    }
+
+    vt->expected_expiry += vt->period;
+    vt->expiry_count += 1u;
+}
+
+
+// Tests that repeating timers keep expiring on time while the running counter wraps around many times
+void test_app_timer_target_count_reached_running_count_wraparound(void)
+{
+    // Periods chosen so expiries do not line up, longest is just under half the range of a 32-bit running count
+    const uint64_t periods[VIRTUAL_TIME_NUM_TIMERS] = {0x7ffffff0u, 0x12345678u, 0x00f00001u, 0x0000fffdu};
+    const uint64_t end_time = 64ull * 0x100000000ull;
+
+    _virtual_time_setup();
+    _virtual_time_late_expiries = 0u;
+
+    for (uint32_t i = 0u; i < VIRTUAL_TIME_NUM_TIMERS; i++)
+    {
+        virtual_time_timer_t *vt = &_virtual_time_timers[i];
+        vt->period = periods[i];
+        vt->expected_expiry = periods[i];
+        vt->expiry_count = 0u;
+
+        TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&vt->timer, _virtual_time_handler, APP_TIMER_TYPE_REPEATING));
+        TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start(&vt->timer, (app_timer_period_t) periods[i], vt));
+    }
+
+    // Advance virtual time to the end of each configured counter period, until the end time is reached
+    while (_virtual_time.now < end_time)
+    {
+        TEST_ASSERT_TRUE(_virtual_time.running);
+        _virtual_time.now = _virtual_time.period_start + _virtual_time.period;
+        _target_count_reached();
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(0u, _virtual_time_late_expiries);
+
+    for (uint32_t i = 0u; i < VIRTUAL_TIME_NUM_TIMERS; i++)
+    {
+        virtual_time_timer_t *vt = &_virtual_time_timers[i];
+
+        // Every timer should have expired once for every period that has fully elapsed
+        TEST_ASSERT_EQUAL_UINT32((uint32_t) (_virtual_time.now / vt->period), vt->expiry_count);
+        TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&vt->timer));
+    }
+
+    TEST_ASSERT_FALSE(_virtual_time.running);
+
+    // Restore HW model
+    _virtual_time_restore();
+}
+
+
+// Second virtual-time counter, so that two timer contexts can be driven by separate counters
+
+static virtual_counter_t _ctx_b_time;
+
+static app_timer_count_t _ctx_b_read_timer_counts(void)
+{
+    return _virtual_counter_read(&_ctx_b_time);
+}
+
+static void _ctx_b_set_timer_period_counts(app_timer_count_t counts)
+{
+    _virtual_counter_set_period(&_ctx_b_time, counts);
+}
+
+static void _ctx_b_set_timer_running(bool enabled)
+{
+    _ctx_b_time.running = enabled;
+}
+
+static void _ctx_expiry_handler(void *context)
+{
+    *((uint32_t *) context) += 1u;
+}
+
+static app_timer_ctx_t _ctx_a;
+static app_timer_ctx_t _ctx_b;
+
+static app_timer_hw_model_t _ctx_a_model =
+{
+    .max_count = (app_timer_count_t) 0xffffffu,
+    .init = _callcount_init,
+    .units_to_timer_counts = _virtual_time_units_to_timer_counts,
+    .read_timer_counts = _virtual_time_read_timer_counts,
+    .set_timer_period_counts = _virtual_time_set_timer_period_counts,
+    .set_timer_running = _virtual_time_set_timer_running,
+    .set_interrupts_enabled = _callcount_set_interrupts_enabled
+};
+
+static app_timer_hw_model_t _ctx_b_model =
+{
+    .max_count = (app_timer_count_t) 0xffffffu,
+    .init = _callcount_init,
+    .units_to_timer_counts = _virtual_time_units_to_timer_counts,
+    .read_timer_counts = _ctx_b_read_timer_counts,
+    .set_timer_period_counts = _ctx_b_set_timer_period_counts,
+    .set_timer_running = _ctx_b_set_timer_running,
+    .set_interrupts_enabled = _callcount_set_interrupts_enabled
+};
+
+
+// Helper function, handles a counter expiry for a specific timer context
+static void _ctx_target_count_reached(app_timer_ctx_t *ctx)
+{
+    app_timer_ctx_target_count_reached(ctx);
+#ifdef APP_TIMER_DEFERRED_DISPATCH
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_dispatch_pending(ctx));
+#endif // APP_TIMER_DEFERRED_DISPATCH
+}
+
+
+// Tests that app_timer_ctx_* functions return expected error codes for a NULL or uninitialized context
+void test_app_timer_ctx_invalid(void)
+{
+    app_timer_t t;
+    bool active;
+    app_timer_t *timers[1] = {&t};
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_NULL_PARAM, app_timer_ctx_init(NULL, &_ctx_a_model));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_NULL_PARAM, app_timer_ctx_init(&_ctx_a, NULL));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_NULL_PARAM, app_timer_ctx_create(NULL, &t, _dummy_handler, APP_TIMER_TYPE_REPEATING));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_NULL_PARAM, app_timer_ctx_start(NULL, &t, 1000u, NULL));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_NULL_PARAM, app_timer_ctx_stop(NULL, &t));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_NULL_PARAM, app_timer_ctx_stop_all(NULL));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_NULL_PARAM, app_timer_ctx_is_active(NULL, &t, &active));
+
+    // A zero-initialized context has not been initialized yet
+    (void) memset(&_ctx_a, 0, sizeof(_ctx_a));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_INVALID_STATE, app_timer_ctx_create(&_ctx_a, &t, _dummy_handler, APP_TIMER_TYPE_REPEATING));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_INVALID_STATE, app_timer_ctx_start(&_ctx_a, &t, 1000u, NULL));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_INVALID_STATE, app_timer_ctx_stop(&_ctx_a, &t));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_INVALID_STATE, app_timer_ctx_stop_many(&_ctx_a, timers, 1u));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_INVALID_STATE, app_timer_ctx_stop_all(&_ctx_a));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_INVALID_STATE, app_timer_ctx_is_active(&_ctx_a, &t, &active));
+}
+
+
+// Tests that timers in separate contexts are driven only by the counter and interrupt of their own context
+void test_app_timer_ctx_independent(void)
+{
+    app_timer_t timer_a1;
+    app_timer_t timer_a2;
+    app_timer_t timer_b;
+    uint32_t count_a = 0u;
+    uint32_t count_b = 0u;
+    bool active;
+
+    (void) memset(&_virtual_time, 0, sizeof(_virtual_time));
+    (void) memset(&_ctx_b_time, 0, sizeof(_ctx_b_time));
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_init(&_ctx_a, &_ctx_a_model));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_init(&_ctx_b, &_ctx_b_model));
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_create(&_ctx_a, &timer_a1, _ctx_expiry_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_create(&_ctx_a, &timer_a2, _ctx_expiry_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_create(&_ctx_b, &timer_b, _ctx_expiry_handler, APP_TIMER_TYPE_REPEATING));
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_start(&_ctx_a, &timer_a1, 1000u, &count_a));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_start(&_ctx_b, &timer_b, 1500u, &count_b));
+
+    // Each context configures its own counter
+    TEST_ASSERT_TRUE(_virtual_time.running);
+    TEST_ASSERT_TRUE(_ctx_b_time.running);
+    TEST_ASSERT_EQUAL_UINT64(1000u, _virtual_time.period);
+    TEST_ASSERT_EQUAL_UINT64(1500u, _ctx_b_time.period);
+
+    // Expiry of counter A only expires timers in context A
+    _virtual_time.now = 1000u;
+    _ctx_b_time.now = 1000u;
+    _ctx_target_count_reached(&_ctx_a);
+
+    TEST_ASSERT_EQUAL_UINT32(1u, count_a);
+    TEST_ASSERT_EQUAL_UINT32(0u, count_b);
+    TEST_ASSERT_FALSE(_virtual_time.running);
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_is_active(&_ctx_b, &timer_b, &active));
+    TEST_ASSERT_TRUE(active);
+
+    // Stopping all timers in context A leaves timers in context B running
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_start(&_ctx_a, &timer_a2, 2000u, &count_a));
+    TEST_ASSERT_TRUE(_virtual_time.running);
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_stop_all(&_ctx_a));
+    TEST_ASSERT_FALSE(_virtual_time.running);
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_is_active(&_ctx_a, &timer_a2, &active));
+    TEST_ASSERT_FALSE(active);
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_is_active(&_ctx_b, &timer_b, &active));
+    TEST_ASSERT_TRUE(active);
+    TEST_ASSERT_TRUE(_ctx_b_time.running);
+
+    // Counter B expires at 1500 counts, as configured before counter A expired
+    _ctx_b_time.now = _ctx_b_time.period_start + _ctx_b_time.period;
+    TEST_ASSERT_EQUAL_UINT64(1500u, _ctx_b_time.now);
+    _ctx_target_count_reached(&_ctx_b);
+
+    TEST_ASSERT_EQUAL_UINT32(1u, count_a);
+    TEST_ASSERT_EQUAL_UINT32(1u, count_b);
+    TEST_ASSERT_TRUE(_ctx_b_time.running);
+    TEST_ASSERT_EQUAL_UINT64(1500u, _ctx_b_time.period);
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_stop(&_ctx_b, &timer_b));
+    TEST_ASSERT_FALSE(_ctx_b_time.running);
+}
+
+
+// Tests that app_timer_ctx_init does not discard the active timers of an initialized context
+void test_app_timer_ctx_init_already_initialized(void)
+{
+    static app_timer_ctx_t ctx;
+    app_timer_t t;
+    uint32_t count = 0u;
+    bool active;
+
+    _virtual_time_setup();
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_init(&ctx, &_hw_model));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_create(&ctx, &t, _ctx_expiry_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_start(&ctx, &t, 1000u, &count));
+
+    // Second call does nothing, even with a different HW model, or none
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_init(&ctx, &_ctx_b_model));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_init(&ctx, NULL));
+    TEST_ASSERT_EQUAL_PTR(&_hw_model, ctx.hw_model);
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_is_active(&ctx, &t, &active));
+    TEST_ASSERT_TRUE(active);
+    TEST_ASSERT_TRUE(_virtual_time.running);
+
+    _virtual_time.now = _virtual_time.period_start + _virtual_time.period;
+    _ctx_target_count_reached(&ctx);
+    TEST_ASSERT_EQUAL_UINT32(1u, count);
+
+    // Restore HW model
+    _virtual_time_restore();
+}
+
+
+// Tests that stopping a single-shot timer after it has expired does not disturb other active timers
+void test_app_timer_stop_single_shot_after_expiry(void)
+{
+    app_timer_t expired_timer;
+    app_timer_t active_timer;
+    uint32_t expired_count = 0u;
+    uint32_t active_count = 0u;
+    bool active;
+
+    _virtual_time_setup();
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&expired_timer, _ctx_expiry_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&active_timer, _ctx_expiry_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start(&expired_timer, 1000u, &expired_count));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start(&active_timer, 5000u, &active_count));
+
+    _virtual_time.now = _virtual_time.period_start + _virtual_time.period;
+    _target_count_reached();
+    TEST_ASSERT_EQUAL_UINT32(1u, expired_count);
+
+    // Expired timer is no longer in the set of active timers, so this must not touch the set
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&expired_timer));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_is_active(&active_timer, &active));
+    TEST_ASSERT_TRUE(active);
+    TEST_ASSERT_TRUE(_virtual_time.running);
+
+#ifdef APP_TIMER_STATS_ENABLE
+    app_timer_stats_t stats;
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stats(&stats));
+    TEST_ASSERT_EQUAL_UINT32(1u, stats.num_timers);
+#endif // APP_TIMER_STATS_ENABLE
+
+    _virtual_time.now = _virtual_time.period_start + _virtual_time.period;
+    _target_count_reached();
+    TEST_ASSERT_EQUAL_UINT64(5000u, _virtual_time.now);
+    TEST_ASSERT_EQUAL_UINT32(1u, active_count);
+    TEST_ASSERT_FALSE(_virtual_time.running);
+
+#ifdef APP_TIMER_STATS_ENABLE
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stats(&stats));
+    TEST_ASSERT_EQUAL_UINT32(0u, stats.num_timers);
+#endif // APP_TIMER_STATS_ENABLE
+
+    // Restore HW model
+    _virtual_time_restore();
+}
+
+
+// Tests that app_timer_stop_all empties the active set, and that it can be used again afterwards
+void test_app_timer_stop_all_then_restart(void)
+{
+    app_timer_t timers[6];
+    app_timer_period_t periods[6] = {100u, 3u, 70000u, 100u, 1000u, 9u};
+    uint32_t counts[6] = {0u};
+    bool active;
+
+    _virtual_time_setup();
+
+    // Periods spread over several wheel levels, and several period FIFOs
+    for (uint32_t i = 0u; i < 6u; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&timers[i], _ctx_expiry_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+        TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start(&timers[i], periods[i], &counts[i]));
+    }
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop_all());
+    TEST_ASSERT_FALSE(_virtual_time.running);
+
+    for (uint32_t i = 0u; i < 6u; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_is_active(&timers[i], &active));
+        TEST_ASSERT_FALSE(active);
+    }
+
+#ifdef APP_TIMER_STATS_ENABLE
+    app_timer_stats_t stats;
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stats(&stats));
+    TEST_ASSERT_EQUAL_UINT32(0u, stats.num_timers);
+#endif // APP_TIMER_STATS_ENABLE
+
+    // Stopped timers can be started again, and expire in order
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start(&timers[2], 500u, &counts[2]));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start(&timers[0], 200u, &counts[0]));
+    TEST_ASSERT_EQUAL_UINT64(200u, _virtual_time.period);
+
+    _virtual_time.now = _virtual_time.period_start + _virtual_time.period;
+    _target_count_reached();
+    TEST_ASSERT_EQUAL_UINT32(1u, counts[0]);
+    TEST_ASSERT_EQUAL_UINT32(0u, counts[2]);
+
+    _virtual_time.now = _virtual_time.period_start + _virtual_time.period;
+    _target_count_reached();
+    TEST_ASSERT_EQUAL_UINT64(500u, _virtual_time.now);
+    TEST_ASSERT_EQUAL_UINT32(1u, counts[2]);
+    TEST_ASSERT_FALSE(_virtual_time.running);
+
+    for (uint32_t i = 0u; i < 6u; i++)
+    {
+        if ((0u != i) && (2u != i))
+        {
+            TEST_ASSERT_EQUAL_UINT32(0u, counts[i]);
+        }
+    }
+
+    // Restore HW model
+    _virtual_time_restore();
+}
+
+
+#ifdef APP_TIMER_TOUCH_ENABLE
+// Tests that app_timer_touch does not start a timer that is not running
+void test_app_timer_touch_not_running(void)
+{
+    app_timer_t t1, t2;
+    uint32_t count1 = 0u;
+    uint32_t count2 = 0u;
+    bool active;
+
+    _virtual_time_setup();
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&t1, _ctx_expiry_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&t2, _ctx_expiry_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+
+    // Never started
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_INVALID_STATE, app_timer_touch(&t1, 1000u));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_is_active(&t1, &active));
+    TEST_ASSERT_FALSE(active);
+    TEST_ASSERT_FALSE(_virtual_time.running);
+
+    // Stopped
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start(&t1, 1000u, &count1));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start(&t2, 3000u, &count2));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&t1));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_INVALID_STATE, app_timer_touch(&t1, 500u));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_is_active(&t1, &active));
+    TEST_ASSERT_FALSE(active);
+
+    // Only timer2 expires, at its original expiry time
+    _virtual_time.now = _virtual_time.period_start + _virtual_time.period;
+    _target_count_reached();
+    TEST_ASSERT_EQUAL_UINT64(3000u, _virtual_time.now);
+    TEST_ASSERT_EQUAL_UINT32(0u, count1);
+    TEST_ASSERT_EQUAL_UINT32(1u, count2);
+    TEST_ASSERT_FALSE(_virtual_time.running);
+
+    // Expired single-shot timer
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_INVALID_STATE, app_timer_touch(&t2, 1000u));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_is_active(&t2, &active));
+    TEST_ASSERT_FALSE(active);
+    TEST_ASSERT_FALSE(_virtual_time.running);
+
+    // Restore HW model
+    _virtual_time_restore();
+}
+#endif // APP_TIMER_TOUCH_ENABLE
+
+
+// Converts virtual time counts to units of 10 counts, rounding down
+static app_timer_period_t _virtual_time_timer_counts_to_units(app_timer_running_count_t counts)
+{
+    return (app_timer_period_t) (counts / 10u);
+}
+
+
+// Tests that app_timer_ticks_until_next_expiry reports the time until the next timer expires
+void test_app_timer_ticks_until_next_expiry(void)
+{
+    app_timer_t t1;
+    app_timer_t t2;
+    uint32_t t1_count = 0u;
+    uint32_t t2_count = 0u;
+    app_timer_running_count_t ticks;
+    app_timer_period_t units;
+
+    _virtual_time_setup();
+    _hw_model.max_count = (app_timer_count_t) 0xffffu;
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_NULL_PARAM, app_timer_ticks_until_next_expiry(NULL));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_NULL_PARAM, app_timer_units_until_next_expiry(NULL));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_NO_ACTIVE_TIMERS, app_timer_ticks_until_next_expiry(&ticks));
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&t1, _ctx_expiry_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&t2, _ctx_expiry_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start(&t1, 1000u, &t1_count));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start(&t2, 100000u, &t2_count));
+
+    // Counts_to_units not provided by HW model
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_INVALID_STATE, app_timer_units_until_next_expiry(&units));
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ticks_until_next_expiry(&ticks));
+    TEST_ASSERT_EQUAL_UINT32(1000u, (uint32_t) ticks);
+
+    _virtual_time.now += 246u;
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ticks_until_next_expiry(&ticks));
+    TEST_ASSERT_EQUAL_UINT32(754u, (uint32_t) ticks);
+
+    _hw_model.timer_counts_to_units = _virtual_time_timer_counts_to_units;
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_units_until_next_expiry(&units));
+    TEST_ASSERT_EQUAL_UINT32(75u, (uint32_t) units);
+
+    // Expired but not yet handled
+    _virtual_time.now = _virtual_time.period_start + _virtual_time.period;
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ticks_until_next_expiry(&ticks));
+    TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t) ticks);
+
+    _target_count_reached();
+    TEST_ASSERT_EQUAL_UINT32(1u, t1_count);
+
+    // Next expiry is further away than max_count, so the result is larger than the counter period
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ticks_until_next_expiry(&ticks));
+    TEST_ASSERT_EQUAL_UINT32(99000u, (uint32_t) ticks);
+
+    while (_virtual_time.running)
+    {
+        _virtual_time.now = _virtual_time.period_start + _virtual_time.period;
+        _target_count_reached();
+    }
+
+    TEST_ASSERT_EQUAL_UINT64(100000u, _virtual_time.now);
+    TEST_ASSERT_EQUAL_UINT32(1u, t2_count);
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_NO_ACTIVE_TIMERS, app_timer_ticks_until_next_expiry(&ticks));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_NO_ACTIVE_TIMERS, app_timer_units_until_next_expiry(&units));
+
+    // Restore HW model
+    _virtual_time_restore();
+}
+
+
+// Reads the virtual-time counter, after some time has passed since the last call
+static app_timer_count_t _slow_read_timer_counts(void)
+{
+    _virtual_time.now += 50u;
+    return _virtual_time_read_timer_counts();
+}
+
+
+// Tests that the counter is configured for the real expiry time of the new head timer when
+// time passes while app_timer_start_many is starting a batch of timers
+void test_app_timer_start_many_time_moves_during_batch(void)
+{
+    app_timer_t t0, t1, t2, t3;
+    app_timer_t *timers[3] = {&t1, &t2, &t3};
+    app_timer_period_t periods[3] = {300u, 100u, 200u};
+    uint32_t counts[4] = {0u, 0u, 0u, 0u};
+    void *context_ptrs[3] = {&counts[1], &counts[2], &counts[3]};
+
+    _virtual_time_setup();
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&t0, _ctx_expiry_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&t1, _ctx_expiry_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&t2, _ctx_expiry_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&t3, _ctx_expiry_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start(&t0, 1000u, &counts[0]));
+
+    /* Batch is started at 450 counts (first read), and the new head timer expires 100 counts
+     * later, even though the counter is configured at 500 counts (second read) */
+    _virtual_time.now = 400u;
+    _hw_model.read_timer_counts = _slow_read_timer_counts;
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start_many(timers, periods, context_ptrs, 3u));
+    _hw_model.read_timer_counts = _virtual_time_read_timer_counts;
+
+    TEST_ASSERT_TRUE(_virtual_time.running);
+    TEST_ASSERT_EQUAL_UINT64(550u, _virtual_time.period_start + _virtual_time.period);
+
+    // All timers expire at the expected times
+    const uint64_t expiry_times[4] = {550u, 650u, 750u, 1000u};
+    const uint32_t expiry_index[4] = {2u, 3u, 1u, 0u};
+
+    for (uint32_t i = 0u; i < 4u; i++)
+    {
+        _virtual_time.now = _virtual_time.period_start + _virtual_time.period;
+        TEST_ASSERT_EQUAL_UINT64(expiry_times[i], _virtual_time.now);
+        _target_count_reached();
+        TEST_ASSERT_EQUAL_UINT32(1u, counts[expiry_index[i]]);
+    }
+
+    TEST_ASSERT_FALSE(_virtual_time.running);
+
+    _virtual_time_restore();
+}
+
+
+/* Hardware model call-count regression tests. Each hardware model function may be an expensive
+ * register access on a real MCU, so these tests pin the exact number of calls made to
+ * read_timer_counts, set_timer_period_counts, set_timer_running and set_interrupts_enabled
+ * by each API operation, in each scenario. If a change makes one of these tests fail by adding
+ * calls, then either remove the extra calls, or update the expected counts if they are really needed.
+ * The expected counts are for the default counter handling (APP_TIMER_RECONFIG_WITHOUT_STOPPING,
+ * APP_TIMER_FREERUNNING_COUNTER and APP_TIMER_ENABLE_INTERRUPTS_FOR_HANDLER not defined). */
+
+// Number of extra read_timer_counts calls made for each expired timer, to record its lateness
+#ifdef APP_TIMER_LATENESS_STATS_ENABLE
+#define CALLCOUNT_LATENESS_READS (1u)
+#else
+#define CALLCOUNT_LATENESS_READS (0u)
+#endif // APP_TIMER_LATENESS_STATS_ENABLE
+
+// Number of extra read_timer_counts calls made to time handlers and critical sections, if enabled
+#ifdef APP_TIMER_DURATION_STATS_ENABLE
+#define CALLCOUNT_DURATION_READS(n) (n)
+#else
+#define CALLCOUNT_DURATION_READS(n) (0u)
+#endif // APP_TIMER_DURATION_STATS_ENABLE
+
+// Sets up the _callcount_* HW model, with timer periods in timer counts, and the counter at 0
+static void _callcount_setup(void)
+{
+    _hw_model.max_count = (app_timer_count_t) 0xffffffu;
+    _hw_model.units_to_timer_counts = _virtual_time_units_to_timer_counts;
+    _hw_model.read_timer_counts = _callcount_read_timer_counts;
+    _hw_model.set_timer_period_counts = _callcount_set_timer_period_counts;
+    _hw_model.set_timer_running = _callcount_set_timer_running;
+    _hw_model.set_interrupts_enabled = _callcount_set_interrupts_enabled;
+    _callcount_read_timer_counts_returnval = 0u;
+}
+
+// Resets call counts for all HW model functions
+static void _callcount_reset(void)
+{
+    _read_timer_counts_callcount = 0u;
+    _set_timer_period_counts_callcount = 0u;
+    _set_timer_running_callcount = 0u;
+    _set_interrupts_enabled_callcount = 0u;
+}
+
+// Checks call counts for all HW model functions since the last _callcount_reset, and resets them
+static void _callcount_check(uint32_t reads, uint32_t periods, uint32_t runnings, uint32_t interrupts, const char *msg)
+{
+    char buf[128];
+
+    (void) snprintf(buf, sizeof(buf), "%s: read_timer_counts", msg);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(reads, _read_timer_counts_callcount, buf);
+    (void) snprintf(buf, sizeof(buf), "%s: set_timer_period_counts", msg);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(periods, _set_timer_period_counts_callcount, buf);
+    (void) snprintf(buf, sizeof(buf), "%s: set_timer_running", msg);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(runnings, _set_timer_running_callcount, buf);
+    (void) snprintf(buf, sizeof(buf), "%s: set_interrupts_enabled", msg);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(interrupts, _set_interrupts_enabled_callcount, buf);
+
+    _callcount_reset();
+}
+
+
+// Pins HW model calls made by app_timer_start
+void test_app_timer_callcount_start(void)
+{
+    app_timer_t t1, t2, t3;
+
+    app_timer_hw_model_t saved_model = _hw_model;
+    _callcount_setup();
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&t1, _dummy_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&t2, _dummy_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&t3, _dummy_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+    _callcount_reset();
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start(&t1, 1000u, NULL));
+    _callcount_check(1u, 1u, 2u, 2u, "start, no active timers");
+
+    _callcount_read_timer_counts_returnval += 10u;
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start(&t2, 2000u, NULL));
+    _callcount_check(1u + CALLCOUNT_DURATION_READS(1u), 0u, 0u, 2u, "start, not the next timer to expire");
+
+    _callcount_read_timer_counts_returnval += 10u;
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start(&t3, 500u, NULL));
+    _callcount_check(3u, 1u, 2u, 2u, "start, next timer to expire");
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop_all());
+
+    _hw_model = saved_model;
+}
+
+
+// Pins HW model calls made by app_timer_stop
+void test_app_timer_callcount_stop(void)
+{
+    app_timer_t t1, t2, t3;
+
+    app_timer_hw_model_t saved_model = _hw_model;
+    _callcount_setup();
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&t1, _dummy_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&t2, _dummy_handler, APP_TIMER_TYPE_REPEATING));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&t3, _dummy_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start(&t1, 1000u, NULL));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start(&t2, 2000u, NULL));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start(&t3, 3000u, NULL));
+    _callcount_reset();
+
+    _callcount_read_timer_counts_returnval += 10u;
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&t2));
+    _callcount_check(CALLCOUNT_DURATION_READS(2u), 0u, 0u, 2u, "stop, not the next timer to expire");
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&t1));
+    _callcount_check(2u + CALLCOUNT_DURATION_READS(1u), 1u, 2u, 2u, "stop, next timer to expire");
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&t3));
+    _callcount_check(CALLCOUNT_DURATION_READS(1u), 0u, 1u, 2u, "stop, last active timer");
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&t3));
+    _callcount_check(0u, 0u, 0u, 2u, "stop, already stopped");
+
+    _hw_model = saved_model;
+}
+
+
+// Pins HW model calls made by app_timer_target_count_reached
+void test_app_timer_callcount_target_count_reached(void)
+{
+    app_timer_t single, repeat, later;
+
+    app_timer_hw_model_t saved_model = _hw_model;
+    _callcount_setup();
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&single, _dummy_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&repeat, _dummy_handler, APP_TIMER_TYPE_REPEATING));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&later, _dummy_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start(&single, 1000u, NULL));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start(&repeat, 1500u, NULL));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start(&later, 5000u, NULL));
+    _callcount_reset();
+
+    _callcount_read_timer_counts_returnval = 1000u;
+    _target_count_reached();
+    _callcount_check(3u + CALLCOUNT_LATENESS_READS + CALLCOUNT_DURATION_READS(5u), 2u, 4u, 2u, "single-shot timer expired");
+
+    _callcount_read_timer_counts_returnval = 1500u;
+    _target_count_reached();
+    _callcount_check(4u + CALLCOUNT_LATENESS_READS + CALLCOUNT_DURATION_READS(5u), 2u, 4u, 2u, "repeating timer expired");
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&repeat));
+    _callcount_reset();
+
+    _callcount_read_timer_counts_returnval = 5000u;
+    _target_count_reached();
+    _callcount_check(1u + CALLCOUNT_LATENESS_READS + CALLCOUNT_DURATION_READS(5u), 1u, 3u, 2u, "last active timer expired");
+
+    _hw_model = saved_model;
+}
+
+
+// Pins HW model calls made by app_timer_restart and app_timer_stop_all
+void test_app_timer_callcount_restart_stop_all(void)
+{
+    app_timer_t t1, t2;
+
+    app_timer_hw_model_t saved_model = _hw_model;
+    _callcount_setup();
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&t1, _dummy_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&t2, _dummy_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start(&t1, 1000u, NULL));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start(&t2, 2000u, NULL));
+    _callcount_reset();
+
+    _callcount_read_timer_counts_returnval += 10u;
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_restart(&t2, 3000u, NULL));
+    _callcount_check(1u, 0u, 0u, 2u, "restart, not the next timer to expire");
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_restart(&t1, 500u, NULL));
+    _callcount_check(3u, 1u, 2u, 2u, "restart, next timer to expire");
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop_all());
+    _callcount_check(0u, 0u, 1u, 2u, "stop_all");
+
+    _hw_model = saved_model;
+}
+
+
+// Pins HW model calls made by functions that only read the state of timers
+void test_app_timer_callcount_queries(void)
+{
+    app_timer_t t1;
+    bool active;
+    app_timer_running_count_t ticks;
+
+    app_timer_hw_model_t saved_model = _hw_model;
+    _callcount_setup();
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&t1, _dummy_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start(&t1, 1000u, NULL));
+    _callcount_reset();
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_is_active(&t1, &active));
+    _callcount_check(0u, 0u, 0u, 0u, "is_active");
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ticks_until_next_expiry(&ticks));
+    _callcount_check(1u, 0u, 0u, 2u, "ticks_until_next_expiry");
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&t1));
+
+    _hw_model = saved_model;
+}
+
+
+#ifdef APP_TIMER_SLACK_ENABLE
+#define SLACK_NUM_TIMERS (3u)
+
+static uint64_t _slack_expiry_times[SLACK_NUM_TIMERS];
+
+static void _slack_handler(void *context)
+{
+    *((uint64_t *) context) = _virtual_time.now;
+}
+
+
+// Tests that timers started with overlapping slack windows expire in the same interrupt
+void test_app_timer_start_slack_coalesces_expiries(void)
+{
+    app_timer_t timers[SLACK_NUM_TIMERS];
+    const uint64_t slack = 100000u;
+    uint32_t interrupts = 0u;
+
+    _virtual_time_setup();
+
+#ifdef APP_TIMER_STATS_ENABLE
+    app_timer_stats_t stats;
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stats(&stats));
+    uint32_t coalesced = stats.num_coalesced_expiries;
+#endif // APP_TIMER_STATS_ENABLE
+
+    for (uint32_t i = 0u; i < SLACK_NUM_TIMERS; i++)
+    {
+        _slack_expiry_times[i] = 0u;
+        TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&timers[i], _slack_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+        TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start_slack(&timers[i], 1000u + i, (app_timer_period_t) slack,
+                                                                  &_slack_expiry_times[i]));
+    }
+
+    // Advance virtual time to the end of each configured counter period, until all timers have expired
+    while (_virtual_time.running && (interrupts < 10u))
+    {
+        _virtual_time.now = _virtual_time.period_start + _virtual_time.period;
+        _target_count_reached();
+        interrupts += 1u;
+    }
+
+    // All timers should have expired in a single interrupt, within their slack windows
+    TEST_ASSERT_EQUAL_UINT32(1u, interrupts);
+
+    for (uint32_t i = 0u; i < SLACK_NUM_TIMERS; i++)
+    {
+        TEST_ASSERT_TRUE(_slack_expiry_times[i] >= (1000u + i));
+        TEST_ASSERT_TRUE(_slack_expiry_times[i] <= (1000u + i + slack));
+    }
+
+#ifdef APP_TIMER_STATS_ENABLE
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stats(&stats));
+    TEST_ASSERT_EQUAL_UINT32(coalesced + SLACK_NUM_TIMERS - 1u, stats.num_coalesced_expiries);
+#endif // APP_TIMER_STATS_ENABLE
+
+    // Restore HW model
+    _virtual_time_restore();
+}
+#endif // APP_TIMER_SLACK_ENABLE
+
+
+#ifdef APP_TIMER_DEFERRED_DISPATCH
+static uint32_t _dispatch_handler_calls = 0u;
+
+static void _dispatch_handler(void *context)
+{
+    _dispatch_handler_calls += 1u;
+}
+
+
+// Tests that app_timer_target_count_reached only queues handlers, and app_timer_dispatch_pending runs them
+void test_app_timer_dispatch_pending_runs_handlers(void)
+{
+    app_timer_t t1, t2;
+    bool active;
+
+    _virtual_time_setup();
+    _dispatch_handler_calls = 0u;
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&t1, _dispatch_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&t2, _dispatch_handler, APP_TIMER_TYPE_REPEATING));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start(&t1, 100u, NULL));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start(&t2, 100u, NULL));
+
+    // Both timers expire, but no handlers should run yet
+    _virtual_time.now = _virtual_time.period_start + _virtual_time.period;
+    app_timer_target_count_reached();
+    TEST_ASSERT_EQUAL_UINT32(0u, _dispatch_handler_calls);
+
+    // Repeating timer should already be re-started
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_is_active(&t1, &active));
+    TEST_ASSERT_FALSE(active);
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_is_active(&t2, &active));
+    TEST_ASSERT_TRUE(active);
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_dispatch_pending());
+    TEST_ASSERT_EQUAL_UINT32(2u, _dispatch_handler_calls);
+
+    // Nothing left to dispatch
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_dispatch_pending());
+    TEST_ASSERT_EQUAL_UINT32(2u, _dispatch_handler_calls);
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&t2));
+
+    // Restore HW model
+    _virtual_time_restore();
+}
+
+
+// Needs more timers than the dispatch ring can hold to be active at once, and to expire in one interrupt
+#if (!defined(APP_TIMER_ACTIVE_SET_HEAP) || (APP_TIMER_HEAP_CAPACITY >= (APP_TIMER_DISPATCH_RING_SIZE + 2u))) && \
+    (!defined(APP_TIMER_MAX_EXPIRIES_PER_INTERRUPT) || (APP_TIMER_MAX_EXPIRIES_PER_INTERRUPT >= (APP_TIMER_DISPATCH_RING_SIZE + 2u))) && \
+    !defined(APP_TIMER_MAX_COUNTS_PER_INTERRUPT)
+#define TEST_DISPATCH_RING_FULL
+#endif
+
+#ifdef TEST_DISPATCH_RING_FULL
+// Tests that handlers are never run by app_timer_target_count_reached, even when the dispatch ring is full
+void test_app_timer_dispatch_pending_ring_full(void)
+{
+    app_timer_t timers[APP_TIMER_DISPATCH_RING_SIZE + 2u];
+    bool active;
+
+    _virtual_time_setup();
+    _dispatch_handler_calls = 0u;
+
+#ifdef APP_TIMER_STATS_ENABLE
+    app_timer_stats_t stats;
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stats(&stats));
+    uint32_t overflows = stats.num_dispatch_overflows;
+    uint32_t expiry_overflows = stats.num_expiry_overflows;
+#endif // APP_TIMER_STATS_ENABLE
+
+    for (uint32_t i = 0u; i < (APP_TIMER_DISPATCH_RING_SIZE + 2u); i++)
+    {
+        TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&timers[i], _dispatch_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+        TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start(&timers[i], 100u, NULL));
+    }
+
+    // All timers expire, but only the ones that fit in the ring are queued, and no handlers run
+    _virtual_time.now = _virtual_time.period_start + _virtual_time.period;
+    app_timer_target_count_reached();
+    TEST_ASSERT_EQUAL_UINT32(0u, _dispatch_handler_calls);
+
+    // Timers that did not fit are still active, and the counter is configured for 1 tick
+    for (uint32_t i = 0u; i < (APP_TIMER_DISPATCH_RING_SIZE + 2u); i++)
+    {
+        TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_is_active(&timers[i], &active));
+        TEST_ASSERT_TRUE((i >= APP_TIMER_DISPATCH_RING_SIZE) == active);
+    }
+
+    TEST_ASSERT_TRUE(_virtual_time.running);
+    TEST_ASSERT_EQUAL_UINT64(1u, _virtual_time.period);
+
+    // Ring is still full in the next interrupt, so nothing changes
+    _virtual_time.now = _virtual_time.period_start + _virtual_time.period;
+    app_timer_target_count_reached();
+    TEST_ASSERT_EQUAL_UINT32(0u, _dispatch_handler_calls);
+
+#ifdef APP_TIMER_STATS_ENABLE
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stats(&stats));
+    TEST_ASSERT_EQUAL_UINT32(overflows + 2u, stats.num_dispatch_overflows);
+    TEST_ASSERT_EQUAL_UINT32(expiry_overflows, stats.num_expiry_overflows);
+    TEST_ASSERT_EQUAL_UINT32(2u, stats.num_timers);
+#endif // APP_TIMER_STATS_ENABLE
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_dispatch_pending());
+    TEST_ASSERT_EQUAL_UINT32(APP_TIMER_DISPATCH_RING_SIZE, _dispatch_handler_calls);
+
+    // Remaining timers are queued in the next interrupt, now that there is space
+    _virtual_time.now = _virtual_time.period_start + _virtual_time.period;
+    app_timer_target_count_reached();
+    TEST_ASSERT_EQUAL_UINT32(APP_TIMER_DISPATCH_RING_SIZE, _dispatch_handler_calls);
+    TEST_ASSERT_FALSE(_virtual_time.running);
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_dispatch_pending());
+    TEST_ASSERT_EQUAL_UINT32(APP_TIMER_DISPATCH_RING_SIZE + 2u, _dispatch_handler_calls);
+
+    // Restore HW model
+    _virtual_time_restore();
+}
+#endif // TEST_DISPATCH_RING_FULL
+#endif // APP_TIMER_DEFERRED_DISPATCH
+
+
+#ifdef APP_TIMER_MAX_EXPIRIES_PER_INTERRUPT
+#define BUDGET_NUM_TIMERS (5u)
+
+// Number of handlers run in the current call to app_timer_target_count_reached
+static uint32_t _budget_handler_calls = 0u;
+
+static void _budget_handler(void *context)
+{
+    *((uint64_t *) context) = _virtual_time.now;
+    _budget_handler_calls += 1u;
+}
+
+
+// Tests that app_timer_target_count_reached handles no more than APP_TIMER_MAX_EXPIRIES_PER_INTERRUPT
+// expired timers per call, and leaves the rest for the following interrupts
+void test_app_timer_target_count_reached_budget(void)
+{
+    app_timer_t timers[BUDGET_NUM_TIMERS];
+    uint64_t expiry_times[BUDGET_NUM_TIMERS];
+    const uint32_t expected_interrupts = (BUDGET_NUM_TIMERS + APP_TIMER_MAX_EXPIRIES_PER_INTERRUPT - 1u) /
+                                         APP_TIMER_MAX_EXPIRIES_PER_INTERRUPT;
+    uint32_t interrupts = 0u;
+
+    _virtual_time_setup();
+
+#ifdef APP_TIMER_STATS_ENABLE
+    app_timer_stats_t stats;
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stats(&stats));
+    uint32_t exhausted = stats.num_budget_exhausted;
+    uint32_t overflows = stats.num_expiry_overflows;
+#endif // APP_TIMER_STATS_ENABLE
+
+    // All timers expire on the same tick
+    for (uint32_t i = 0u; i < BUDGET_NUM_TIMERS; i++)
+    {
+        expiry_times[i] = 0u;
+        TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&timers[i], _budget_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+        TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start(&timers[i], 1000u, &expiry_times[i]));
+    }
+
+    // Advance virtual time to the end of each configured counter period, until all timers have expired
+    while (_virtual_time.running && (interrupts < 10u))
+    {
+        _virtual_time.now = _virtual_time.period_start + _virtual_time.period;
+        _budget_handler_calls = 0u;
+        _target_count_reached();
+        TEST_ASSERT_TRUE(_budget_handler_calls <= APP_TIMER_MAX_EXPIRIES_PER_INTERRUPT);
+        interrupts += 1u;
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(expected_interrupts, interrupts);
+
+    /* Timers left over by each interrupt should expire 1 tick later (timers with the same
+     * expiry time are not necessarily handled in the order they were started) */
+    for (uint32_t i = 0u; i < expected_interrupts; i++)
+    {
+        uint32_t num_expired = 0u;
+        uint32_t remaining = BUDGET_NUM_TIMERS - (i * APP_TIMER_MAX_EXPIRIES_PER_INTERRUPT);
+
+        for (uint32_t j = 0u; j < BUDGET_NUM_TIMERS; j++)
+        {
+            num_expired += (uint32_t) (expiry_times[j] == (1000u + i));
+        }
+
+        TEST_ASSERT_EQUAL_UINT32((remaining < APP_TIMER_MAX_EXPIRIES_PER_INTERRUPT) ?
+                                 remaining : APP_TIMER_MAX_EXPIRIES_PER_INTERRUPT, num_expired);
+    }
+
+#ifdef APP_TIMER_STATS_ENABLE
+    // Stopping early is counted separately from timers expiring while handling other timers
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stats(&stats));
+    TEST_ASSERT_EQUAL_UINT32(exhausted + expected_interrupts - 1u, stats.num_budget_exhausted);
+    TEST_ASSERT_EQUAL_UINT32(overflows, stats.num_expiry_overflows);
+#endif // APP_TIMER_STATS_ENABLE
+
+    // Restore HW model
+    _virtual_time_restore();
+}
+#endif // APP_TIMER_MAX_EXPIRIES_PER_INTERRUPT
+
+
+// Tests that app_timer_start rejects timer periods that are not less than half the range of app_timer_running_count_t
+void test_app_timer_start_period_too_long(void)
+{
+    app_timer_t t;
+    bool active;
+
+    app_timer_hw_model_t saved_model = _hw_model;
+    _hw_model.units_to_timer_counts = _virtual_time_units_to_timer_counts;
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&t, _dummy_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_INVALID_PARAM, app_timer_start(&t, (app_timer_period_t) 0x80000000u, NULL));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_is_active(&t, &active));
+    TEST_ASSERT_FALSE(active);
+
+    // Restore HW model
+    _hw_model = saved_model;
+}
+
+
+#ifdef APP_TIMER_ACTIVE_SET_HEAP
+// Tests that app_timer_start fails with APP_TIMER_FULL when the heap of active timers is full,
+// and succeeds again once one of the active timers has been stopped
+void test_app_timer_start_heap_full(void)
+{
+    app_timer_t timers[APP_TIMER_HEAP_CAPACITY];
+    app_timer_t extra;
+    bool active;
+
+    // Use the call-counting HW model functions, no expectations needed for this test
+    app_timer_hw_model_t saved_model = _hw_model;
+    _hw_model.read_timer_counts = _callcount_read_timer_counts;
+    _hw_model.set_timer_running = _callcount_set_timer_running;
+    _hw_model.set_interrupts_enabled = _callcount_set_interrupts_enabled;
+    _hw_model.set_timer_period_counts = _callcount_set_timer_period_counts;
+    _hw_model.units_to_timer_counts = _callcount_units_to_timer_counts;
+    _callcount_units_to_timer_counts_returnval = 100u;
+
+    for (uint32_t i = 0u; i < APP_TIMER_HEAP_CAPACITY; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&timers[i], _dummy_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+        TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start(&timers[i], 100u + i, NULL));
+    }
+
+    // Heap is full, starting another timer should fail, and leave the timer inactive
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&extra, _dummy_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_FULL, app_timer_start(&extra, 100u, NULL));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_is_active(&extra, &active));
+    TEST_ASSERT_FALSE(active);
+
+    // Stop one timer, there should be space again
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&timers[APP_TIMER_HEAP_CAPACITY / 2u]));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start(&extra, 100u, NULL));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_is_active(&extra, &active));
+    TEST_ASSERT_TRUE(active);
+
+    // Stop all timers
+    for (uint32_t i = 0u; i < APP_TIMER_HEAP_CAPACITY; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&timers[i]));
+    }
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&extra));
+
+    // Restore HW model
+    _callcount_units_to_timer_counts_returnval = 0u;
+    _hw_model = saved_model;
+}
+#endif // APP_TIMER_ACTIVE_SET_HEAP
+
+#if defined(APP_TIMER_ACTIVE_SET_TIMING_WHEEL) || defined(APP_TIMER_ACTIVE_SET_PERIOD_FIFO) || \
+    defined(APP_TIMER_ACTIVE_SET_DELTA_LIST)
+// Order and virtual time of timer expiries, for tests that check which order timers expire in
+#define EXPIRY_LOG_SIZE (32u)
+
+static uint32_t _expiry_log_ids[EXPIRY_LOG_SIZE];
+static uint64_t _expiry_log_times[EXPIRY_LOG_SIZE];
+static uint32_t _expiry_log_count = 0u;
+
+// Handler that records its timer ID (pointed to by the context) and the virtual time
+static void _expiry_log_handler(void *context)
+{
+    TEST_ASSERT_TRUE(_expiry_log_count < EXPIRY_LOG_SIZE);
+    _expiry_log_ids[_expiry_log_count] = *((uint32_t *) context);
+    _expiry_log_times[_expiry_log_count] = _virtual_time.now;
+    _expiry_log_count += 1u;
+}
+
+// Moves virtual time to the end of each configured counter period, until no timers are active
+static void _virtual_time_run_until_idle(void)
+{
+    while (_virtual_time.running)
+    {
+        _virtual_time.now = _virtual_time.period_start + _virtual_time.period;
+        _target_count_reached();
+    }
+}
+#endif // APP_TIMER_ACTIVE_SET_TIMING_WHEEL || APP_TIMER_ACTIVE_SET_PERIOD_FIFO || APP_TIMER_ACTIVE_SET_DELTA_LIST
+
+
+#ifdef APP_TIMER_ACTIVE_SET_TIMING_WHEEL
+#define WHEEL_TEST_NUM_TIMERS (9u)
+
+/* Tests that timers in the higher levels of the timing wheel are cascaded down as time moves on,
+ * and expire on time and in order, including periods longer than max_count, and a period long
+ * enough to put the timer in the top level (with a 32-bit running count and 16 slots per level) */
+void test_app_timer_wheel_cascade(void)
+{
+    app_timer_t timers[WHEEL_TEST_NUM_TIMERS];
+    uint32_t ids[WHEEL_TEST_NUM_TIMERS];
+    const app_timer_period_t periods[WHEEL_TEST_NUM_TIMERS - 1u] = {5u, 300u, 17u, 310u, 301u, 70000u, 0x1000003u, 0x50000000u};
+    const uint32_t expected_ids[WHEEL_TEST_NUM_TIMERS] = {0u, 2u, 8u, 1u, 4u, 3u, 5u, 6u, 7u};
+    const uint64_t expected_times[WHEEL_TEST_NUM_TIMERS] = {5u, 17u, 256u, 300u, 301u, 310u, 70000u, 0x1000003u, 0x50000000u};
+
+    _virtual_time_setup();
+    _hw_model.max_count = (app_timer_count_t) 0xffffu;
+    _expiry_log_count = 0u;
+
+    for (uint32_t i = 0u; i < WHEEL_TEST_NUM_TIMERS; i++)
+    {
+        ids[i] = i;
+        TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&timers[i], _expiry_log_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+    }
+
+    for (uint32_t i = 0u; i < (WHEEL_TEST_NUM_TIMERS - 1u); i++)
+    {
+        TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start(&timers[i], periods[i], &ids[i]));
+    }
+
+    _virtual_time.now = _virtual_time.period_start + _virtual_time.period;
+    _target_count_reached();
+    TEST_ASSERT_EQUAL_UINT32(1u, _expiry_log_count);
+
+    /* Started at 5, so that the wheel has moved on from 0, and expires at 256, in the
+     * same higher-level slot as the timers expiring at 300, 301 and 310 */
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start(&timers[8], 251u, &ids[8]));
+
+    _virtual_time_run_until_idle();
+
+    TEST_ASSERT_EQUAL_UINT32(WHEEL_TEST_NUM_TIMERS, _expiry_log_count);
+
+    for (uint32_t i = 0u; i < WHEEL_TEST_NUM_TIMERS; i++)
+    {
+        TEST_ASSERT_EQUAL_UINT32(expected_ids[i], _expiry_log_ids[i]);
+        TEST_ASSERT_EQUAL_UINT64(expected_times[i], _expiry_log_times[i]);
+    }
+
+    // Restore HW model
+    _virtual_time_restore();
+}
+#endif // APP_TIMER_ACTIVE_SET_TIMING_WHEEL
+
+#ifdef APP_TIMER_ACTIVE_SET_PERIOD_FIFO
+#define FIFO_TEST_NUM_TIMERS (APP_TIMER_PERIOD_FIFO_COUNT + 3u)
+
+/* Tests that when more distinct periods are active than there are per-period FIFOs, the extra
+ * timers go into the overflow FIFO, and all timers still expire on time and in order */
+void test_app_timer_fifo_overflow(void)
+{
+    app_timer_t timers[FIFO_TEST_NUM_TIMERS];
+    uint32_t ids[FIFO_TEST_NUM_TIMERS];
+
+    _virtual_time_setup();
+    _expiry_log_count = 0u;
+
+    // Descending periods, so that each timer started after the FIFOs run out expires first
+    for (uint32_t i = 0u; i < FIFO_TEST_NUM_TIMERS; i++)
+    {
+        ids[i] = i;
+        TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&timers[i], _expiry_log_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+        TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start(&timers[i], 1000u - (10u * i), &ids[i]));
+
+        // FIFO index is held in bits 4-7 of the timer flags
+        uint32_t fifo_index = (timers[i].flags >> 4u) & 0xFu;
+        TEST_ASSERT_EQUAL_UINT32((i < APP_TIMER_PERIOD_FIFO_COUNT) ? i : APP_TIMER_PERIOD_FIFO_COUNT, fifo_index);
+    }
+
+    _virtual_time_run_until_idle();
+
+    TEST_ASSERT_EQUAL_UINT32(FIFO_TEST_NUM_TIMERS, _expiry_log_count);
+
+    for (uint32_t i = 0u; i < FIFO_TEST_NUM_TIMERS; i++)
+    {
+        uint32_t id = FIFO_TEST_NUM_TIMERS - 1u - i;
+        TEST_ASSERT_EQUAL_UINT32(id, _expiry_log_ids[i]);
+        TEST_ASSERT_EQUAL_UINT64(1000u - (10u * id), _expiry_log_times[i]);
+    }
+
+    // Restore HW model
+    _virtual_time_restore();
+}
+
+
+/* Tests that timers with the same period expire in the order they were last started in, when
+ * some of them have been stopped and started again, or restarted, in the meantime */
+void test_app_timer_fifo_same_period_order(void)
+{
+    app_timer_t timers[3];
+    uint32_t ids[3] = {0u, 1u, 2u};
+
+    _virtual_time_setup();
+    _expiry_log_count = 0u;
+
+    for (uint32_t i = 0u; i < 3u; i++)
+    {
+        _virtual_time.now = 10u * i;
+        TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&timers[i], _expiry_log_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+        TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start(&timers[i], 100u, &ids[i]));
+    }
+
+    // Timer 0 was first, and is stopped and started again at 30
+    _virtual_time.now = 30u;
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&timers[0]));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start(&timers[0], 100u, &ids[0]));
+
+    // Timer 1 is restarted at 40
+    _virtual_time.now = 40u;
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_restart(&timers[1], 100u, &ids[1]));
+
+    _virtual_time_run_until_idle();
+
+    const uint32_t expected_ids[3] = {2u, 0u, 1u};
+    const uint64_t expected_times[3] = {120u, 130u, 140u};
+
+    TEST_ASSERT_EQUAL_UINT32(3u, _expiry_log_count);
+
+    for (uint32_t i = 0u; i < 3u; i++)
+    {
+        TEST_ASSERT_EQUAL_UINT32(expected_ids[i], _expiry_log_ids[i]);
+        TEST_ASSERT_EQUAL_UINT64(expected_times[i], _expiry_log_times[i]);
+    }
+
+    // Restore HW model
+    _virtual_time_restore();
+}
+#endif // APP_TIMER_ACTIVE_SET_PERIOD_FIFO
+
+#ifdef APP_TIMER_ACTIVE_SET_DELTA_LIST
+/* Tests that removing a timer from the middle of the delta list adds its delta to the timer
+ * after it, and that inserting a timer in the gap splits the delta again */
+void test_app_timer_delta_list_remove_middle(void)
+{
+    app_timer_t timers[5];
+    uint32_t ids[5] = {0u, 1u, 2u, 3u, 4u};
+    const app_timer_period_t periods[4] = {100u, 250u, 400u, 600u};
+
+    _virtual_time_setup();
+    _expiry_log_count = 0u;
+
+    for (uint32_t i = 0u; i < 5u; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_create(&timers[i], _expiry_log_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+    }
+
+    for (uint32_t i = 0u; i < 4u; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start(&timers[i], periods[i], &ids[i]));
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(150u, (uint32_t) timers[1].delta_counts);
+    TEST_ASSERT_EQUAL_UINT32(150u, (uint32_t) timers[2].delta_counts);
+    TEST_ASSERT_EQUAL_UINT32(200u, (uint32_t) timers[3].delta_counts);
+
+    // Timer after the removed one is now relative to the head timer
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_stop(&timers[1]));
+    TEST_ASSERT_EQUAL_UINT32(300u, (uint32_t) timers[2].delta_counts);
+    TEST_ASSERT_EQUAL_UINT32(200u, (uint32_t) timers[3].delta_counts);
+
+    // New timer in the gap takes part of the delta
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_start(&timers[4], 300u, &ids[4]));
+    TEST_ASSERT_EQUAL_UINT32(200u, (uint32_t) timers[4].delta_counts);
+    TEST_ASSERT_EQUAL_UINT32(100u, (uint32_t) timers[2].delta_counts);
+
+    _virtual_time_run_until_idle();
+
+    const uint32_t expected_ids[4] = {0u, 4u, 2u, 3u};
+    const uint64_t expected_times[4] = {100u, 300u, 400u, 600u};
+
+    TEST_ASSERT_EQUAL_UINT32(4u, _expiry_log_count);
+
+    for (uint32_t i = 0u; i < 4u; i++)
+    {
+        TEST_ASSERT_EQUAL_UINT32(expected_ids[i], _expiry_log_ids[i]);
+        TEST_ASSERT_EQUAL_UINT64(expected_times[i], _expiry_log_times[i]);
+    }
+
+    // Restore HW model
+    _virtual_time_restore();
+}
+#endif // APP_TIMER_ACTIVE_SET_DELTA_LIST
+
+
+#ifdef APP_TIMER_LATENESS_STATS_ENABLE
+#define LATENESS_HANDLER_COUNTS (5u)
+
+// Handler that takes LATENESS_HANDLER_COUNTS timer counts to run
+static void _lateness_handler(void *context)
+{
+    _virtual_time.now += LATENESS_HANDLER_COUNTS;
+}
+
+
+// Tests that the lateness of each expired timer is recorded in the histogram, max and mean
+void test_app_timer_stats_lateness(void)
+{
+    static app_timer_ctx_t ctx;
+    app_timer_t timers[3];
+    app_timer_stats_t stats;
+
+    _virtual_time_setup();
+
+    // Separate context, so stats collected by other tests are not included
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_init(&ctx, &_hw_model));
+
+    for (uint32_t i = 0u; i < 3u; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_create(&ctx, &timers[i], _lateness_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+        TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_start(&ctx, &timers[i], 1000u, NULL));
+    }
+
+    /* All timers expire on the same tick; the first one is handled on time, and each
+     * handler delays the next timer by LATENESS_HANDLER_COUNTS */
+    _virtual_time.now = _virtual_time.period_start + _virtual_time.period;
+    _ctx_target_count_reached(&ctx);
+    TEST_ASSERT_FALSE(_virtual_time.running);
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_stats(&ctx, &stats));
+    TEST_ASSERT_EQUAL_UINT32(3u, stats.num_lateness_samples);
+    TEST_ASSERT_EQUAL_UINT64(3u * LATENESS_HANDLER_COUNTS, stats.lateness_total);
+    TEST_ASSERT_EQUAL_UINT(2u * LATENESS_HANDLER_COUNTS, stats.lateness_max);
+    TEST_ASSERT_EQUAL_UINT(LATENESS_HANDLER_COUNTS, stats.lateness_mean);
+
+    /* 0 counts late in bucket 0, 5 counts late in bucket 3 (4-7), 10 counts late in bucket 4 (8-15),
+     * unless there are fewer buckets, in which case the last bucket holds the later timers */
+    const uint32_t last_bucket = APP_TIMER_LATENESS_HISTOGRAM_BUCKETS - 1u;
+    uint32_t expected[APP_TIMER_LATENESS_HISTOGRAM_BUCKETS] = {0u};
+    expected[0] += 1u;
+    expected[(3u < last_bucket) ? 3u : last_bucket] += 1u;
+    expected[(4u < last_bucket) ? 4u : last_bucket] += 1u;
+
+    for (uint32_t i = 0u; i < APP_TIMER_LATENESS_HISTOGRAM_BUCKETS; i++)
+    {
+        TEST_ASSERT_EQUAL_UINT32(expected[i], stats.lateness_histogram[i]);
+    }
+
+    // Restore HW model
+    _virtual_time_restore();
+}
+#endif // APP_TIMER_LATENESS_STATS_ENABLE
+
+
+#ifdef APP_TIMER_DURATION_STATS_ENABLE
+// Handler that takes the number of timer counts pointed to by context to run
+static void _duration_handler(void *context)
+{
+    _virtual_time.now += *((uint32_t *) context);
+}
+
+
+// Tests that handler, critical section and app_timer_target_count_reached durations are measured
+void test_app_timer_stats_durations(void)
+{
+    static app_timer_ctx_t ctx;
+    app_timer_t fast, slow, later;
+    uint32_t fast_counts = 5u;
+    uint32_t slow_counts = 20u;
+    app_timer_stats_t stats;
+
+    _virtual_time_setup();
+
+    // Separate context, so stats collected by other tests are not included
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_init(&ctx, &_hw_model));
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_create(&ctx, &fast, _duration_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_create(&ctx, &slow, _duration_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_create(&ctx, &later, _dummy_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_start(&ctx, &fast, 1000u, &fast_counts));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_start(&ctx, &slow, 1000u, &slow_counts));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_start(&ctx, &later, 5000u, NULL));
+
+    // Both handlers run in the same call
+    _virtual_time.now = _virtual_time.period_start + _virtual_time.period;
+    _ctx_target_count_reached(&ctx);
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_stats(&ctx, &stats));
+
+    TEST_ASSERT_EQUAL_UINT32(2u, stats.handler_duration.count);
+    TEST_ASSERT_EQUAL_UINT64(fast_counts + slow_counts, stats.handler_duration.total);
+    TEST_ASSERT_EQUAL_UINT(slow_counts, stats.handler_duration.max);
+    TEST_ASSERT_EQUAL_PTR(&slow, stats.slowest_handler_timer);
+
+    TEST_ASSERT_EQUAL_UINT32(1u, stats.target_count_reached_duration.count);
+    TEST_ASSERT_EQUAL_UINT(fast_counts + slow_counts, stats.target_count_reached_duration.max);
+    TEST_ASSERT_EQUAL_UINT32(1u, stats.target_count_reached_critical_duration.count);
+#ifdef APP_TIMER_ENABLE_INTERRUPTS_FOR_HANDLER
+    TEST_ASSERT_EQUAL_UINT(0u, stats.target_count_reached_critical_duration.max);
+#else
+    TEST_ASSERT_EQUAL_UINT(fast_counts + slow_counts, stats.target_count_reached_critical_duration.max);
+#endif // APP_TIMER_ENABLE_INTERRUPTS_FOR_HANDLER
+
+    // Virtual time does not advance inside app_timer_start, and the first call started the counter so was not measured
+    TEST_ASSERT_EQUAL_UINT32(2u, stats.start_critical_duration.count);
+    TEST_ASSERT_EQUAL_UINT64(0u, stats.start_critical_duration.total);
+
+    // Stopping a timer that is not the head is measured
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_start(&ctx, &fast, 1000u, &fast_counts));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_stop(&ctx, &later));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_stats(&ctx, &stats));
+    TEST_ASSERT_EQUAL_UINT32(1u, stats.stop_critical_duration.count);
+
+    // Stopping the last active timer stops the counter, so it is not measured
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_stop(&ctx, &fast));
+    TEST_ASSERT_FALSE(_virtual_time.running);
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_stats(&ctx, &stats));
+    TEST_ASSERT_EQUAL_UINT32(1u, stats.stop_critical_duration.count);
+    TEST_ASSERT_EQUAL_UINT32(0u, stats.num_duration_overruns);
+
+    // Restore HW model
+    _virtual_time_restore();
+}
+
+
+// Handler that takes the number of timer counts pointed to by context to run, which may be more than max_count
+static void _long_duration_handler(void *context)
+{
+    _virtual_time.now += *((uint64_t *) context);
+}
+
+
+// Tests that durations that reach max_count are recorded as max_count, and counted as overruns
+void test_app_timer_stats_duration_overruns(void)
+{
+    static app_timer_ctx_t ctx;
+    app_timer_t longer;
+    uint64_t longer_counts = 150u;
+    app_timer_stats_t stats;
+
+    _virtual_time_setup();
+    _hw_model.max_count = 100u;
+
+    // Separate context, so stats collected by other tests are not included
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_init(&ctx, &_hw_model));
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_create(&ctx, &longer, _long_duration_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_start(&ctx, &longer, 50u, &longer_counts));
+
+    _virtual_time.now = _virtual_time.period_start + _virtual_time.period;
+    _ctx_target_count_reached(&ctx);
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_stats(&ctx, &stats));
+
+    TEST_ASSERT_EQUAL_UINT32(1u, stats.handler_duration.count);
+    TEST_ASSERT_EQUAL_UINT64(100u, stats.handler_duration.total);
+    TEST_ASSERT_EQUAL_UINT(100u, stats.handler_duration.max);
+
+    // Whole call is also too long, but no time was spent with interrupts disabled outside the handler
+    TEST_ASSERT_EQUAL_UINT(100u, stats.target_count_reached_duration.max);
+#ifdef APP_TIMER_ENABLE_INTERRUPTS_FOR_HANDLER
+    TEST_ASSERT_EQUAL_UINT(0u, stats.target_count_reached_critical_duration.max);
+    TEST_ASSERT_EQUAL_UINT32(2u, stats.num_duration_overruns);
+#else
+    TEST_ASSERT_EQUAL_UINT(100u, stats.target_count_reached_critical_duration.max);
+    TEST_ASSERT_EQUAL_UINT32(3u, stats.num_duration_overruns);
+#endif // APP_TIMER_ENABLE_INTERRUPTS_FOR_HANDLER
+
+    // Restore HW model
+    _virtual_time_restore();
+}
+
+
+#ifndef APP_TIMER_FREERUNNING_COUNTER
+// Counter that is reset to 0 at the end of each period, like most hardware counters
+static app_timer_count_t _resetting_read_timer_counts(void)
+{
+    return (app_timer_count_t) ((_virtual_time.now - _virtual_time.period_start) % _virtual_time.period);
+}
+
+
+// Tests that a handler running across the end of the counter period is measured correctly
+void test_app_timer_stats_duration_counter_reset(void)
+{
+    static app_timer_ctx_t ctx;
+    app_timer_t first, second;
+    uint32_t first_counts = 97u;
+    // Starts at 97 counts, and ends at 1 count after the counter is reset at 100 counts
+    uint32_t second_counts = 4u;
+    app_timer_stats_t stats;
+
+    _virtual_time_setup();
+    _hw_model.max_count = 100u;
+    _hw_model.read_timer_counts = _resetting_read_timer_counts;
+
+    // Separate context, so stats collected by other tests are not included
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_init(&ctx, &_hw_model));
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_create(&ctx, &first, _duration_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_create(&ctx, &second, _duration_handler, APP_TIMER_TYPE_SINGLE_SHOT));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_start(&ctx, &first, 50u, &first_counts));
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_start(&ctx, &second, 50u, &second_counts));
+
+    _virtual_time.now = _virtual_time.period_start + _virtual_time.period;
+    _ctx_target_count_reached(&ctx);
+
+    TEST_ASSERT_EQUAL_INT(APP_TIMER_OK, app_timer_ctx_stats(&ctx, &stats));
+
+    // Neither handler reached max_count
+    TEST_ASSERT_EQUAL_UINT32(2u, stats.handler_duration.count);
+    TEST_ASSERT_EQUAL_UINT64(first_counts + second_counts, stats.handler_duration.total);
+    TEST_ASSERT_EQUAL_UINT(first_counts, stats.handler_duration.max);
+    TEST_ASSERT_EQUAL_PTR(&first, stats.slowest_handler_timer);
+
+    // The whole call did, so only that is counted as an overrun
+    TEST_ASSERT_EQUAL_UINT(100u, stats.target_count_reached_duration.max);
+#ifdef APP_TIMER_ENABLE_INTERRUPTS_FOR_HANDLER
+    TEST_ASSERT_EQUAL_UINT32(1u, stats.num_duration_overruns);
+#else
+    TEST_ASSERT_EQUAL_UINT32(2u, stats.num_duration_overruns);
+#endif // APP_TIMER_ENABLE_INTERRUPTS_FOR_HANDLER
+
+    // Restore HW model
+    _virtual_time_restore();
+}
+#endif // APP_TIMER_FREERUNNING_COUNTER
+#endif // APP_TIMER_DURATION_STATS_ENABLE
+
+
 int main(void)
 {
     UNITY_BEGIN();
@@ -3201,7 +5580,11 @@ int main(void)
     RUN_TEST(test_app_timer_create_not_init);
     RUN_TEST(test_app_timer_start_not_init);
     RUN_TEST(test_app_timer_stop_not_init);
+    RUN_TEST(test_app_timer_stop_many_not_init);
+    RUN_TEST(test_app_timer_stop_all_not_init);
+    RUN_TEST(test_app_timer_restart_not_init);
     RUN_TEST(test_app_timer_is_active_not_init);
+    RUN_TEST(test_app_timer_ticks_until_next_expiry_not_init);
     RUN_TEST(test_app_timer_init_null_hwmodel_ptr);
     RUN_TEST(test_app_timer_init_max_count_invalid);
     RUN_TEST(test_app_timer_init_null_init);
@@ -3228,13 +5611,19 @@ int main(void)
     RUN_TEST(test_app_timer_start_success_hwcounter_already_running);
     RUN_TEST(test_app_timer_start_new_head_timer_changes_counter);
     RUN_TEST(test_app_timer_target_count_reached_multi_singleshot_diff_expiries);
+#if !defined(APP_TIMER_MAX_EXPIRIES_PER_INTERRUPT) && !defined(APP_TIMER_MAX_COUNTS_PER_INTERRUPT)
+    // Expects all timers to be handled in a single interrupt
     RUN_TEST(test_app_timer_target_count_reached_multi_singleshot_same_expiry);
+#endif // !APP_TIMER_MAX_EXPIRIES_PER_INTERRUPT && !APP_TIMER_MAX_COUNTS_PER_INTERRUPT
     RUN_TEST(test_app_timer_target_count_reached_singleshot_period_gt_maxcount);
     RUN_TEST(test_app_timer_target_count_reached_repeating_period_gt_maxcount);
+#ifndef APP_TIMER_DEFERRED_DISPATCH
+    // These tests expect handlers to call app_timer functions from inside app_timer_target_count_reached
     RUN_TEST(test_app_timer_target_count_reached_singleshot_handler_restarted);
     RUN_TEST(test_app_timer_target_count_reached_multi_repeating_diff_expiries);
     RUN_TEST(test_app_timer_target_count_reached_repeating_inactive_when_stopped);
     RUN_TEST(test_app_timer_target_count_reached_repeating_handler_restarted);
+#endif // APP_TIMER_DEFERRED_DISPATCH
     RUN_TEST(test_app_timer_stop_null_timer);
     RUN_TEST(test_app_timer_stop_already_stopped);
     RUN_TEST(test_app_timer_stop_repeating_hwcounter_only_stopped_on_last);
@@ -3242,11 +5631,75 @@ int main(void)
     RUN_TEST(test_app_timer_stop_repeating_reconfig_for_new_head);
     RUN_TEST(test_app_timer_stop_single_shot_reconfig_for_new_head);
     RUN_TEST(test_app_timer_target_count_context_matches_expected);
+#ifndef APP_TIMER_DEFERRED_DISPATCH
+    // These tests expect handlers to run inside app_timer_target_count_reached
     RUN_TEST(test_app_timer_create_single_to_repeating_in_handler);
     RUN_TEST(test_app_timer_create_repeating_to_single_in_handler);
     RUN_TEST(test_app_timer_stop_repeating_inside_handler);
     RUN_TEST(test_app_timer_target_count_repeating_reached_compensate_handler_runtime);
     RUN_TEST(test_app_timer_target_count_repeating_handler_runtime_gt_maxcount);
+#endif // APP_TIMER_DEFERRED_DISPATCH
+    RUN_TEST(test_app_timer_start_many_invalid_params);
+    RUN_TEST(test_app_timer_start_many_single_reconfig);
+    RUN_TEST(test_app_timer_stop_many_single_reconfig);
+    RUN_TEST(test_app_timer_stop_all);
+    RUN_TEST(test_app_timer_restart_invalid_params);
+    RUN_TEST(test_app_timer_restart_reconfig_only_for_head);
+#ifdef APP_TIMER_TOUCH_ENABLE
+    RUN_TEST(test_app_timer_touch_lazy_reinsert);
+    RUN_TEST(test_app_timer_touch_not_running);
+#endif // APP_TIMER_TOUCH_ENABLE
+    RUN_TEST(test_app_timer_target_count_reached_running_count_wraparound);
+#ifdef APP_TIMER_DEFERRED_DISPATCH
+    RUN_TEST(test_app_timer_dispatch_pending_runs_handlers);
+#ifdef TEST_DISPATCH_RING_FULL
+    RUN_TEST(test_app_timer_dispatch_pending_ring_full);
+#endif // TEST_DISPATCH_RING_FULL
+#endif // APP_TIMER_DEFERRED_DISPATCH
+#ifdef APP_TIMER_SLACK_ENABLE
+    RUN_TEST(test_app_timer_start_slack_coalesces_expiries);
+#endif // APP_TIMER_SLACK_ENABLE
+#ifdef APP_TIMER_MAX_EXPIRIES_PER_INTERRUPT
+    RUN_TEST(test_app_timer_target_count_reached_budget);
+#endif // APP_TIMER_MAX_EXPIRIES_PER_INTERRUPT
+    RUN_TEST(test_app_timer_stop_single_shot_after_expiry);
+    RUN_TEST(test_app_timer_stop_all_then_restart);
+    RUN_TEST(test_app_timer_ticks_until_next_expiry);
+    RUN_TEST(test_app_timer_start_many_time_moves_during_batch);
+    RUN_TEST(test_app_timer_callcount_start);
+    RUN_TEST(test_app_timer_callcount_stop);
+    RUN_TEST(test_app_timer_callcount_target_count_reached);
+    RUN_TEST(test_app_timer_callcount_restart_stop_all);
+    RUN_TEST(test_app_timer_callcount_queries);
+#ifdef APP_TIMER_LATENESS_STATS_ENABLE
+    RUN_TEST(test_app_timer_stats_lateness);
+#endif // APP_TIMER_LATENESS_STATS_ENABLE
+#ifdef APP_TIMER_DURATION_STATS_ENABLE
+    RUN_TEST(test_app_timer_stats_durations);
+    RUN_TEST(test_app_timer_stats_duration_overruns);
+#ifndef APP_TIMER_FREERUNNING_COUNTER
+    RUN_TEST(test_app_timer_stats_duration_counter_reset);
+#endif // APP_TIMER_FREERUNNING_COUNTER
+#endif // APP_TIMER_DURATION_STATS_ENABLE
+    RUN_TEST(test_app_timer_ctx_invalid);
+    RUN_TEST(test_app_timer_ctx_independent);
+    RUN_TEST(test_app_timer_ctx_init_already_initialized);
+#ifdef APP_TIMER_RUNNING_COUNT_UINT32
+    RUN_TEST(test_app_timer_start_period_too_long);
+#endif // APP_TIMER_RUNNING_COUNT_UINT32
+#ifdef APP_TIMER_ACTIVE_SET_HEAP
+    RUN_TEST(test_app_timer_start_heap_full);
+#endif // APP_TIMER_ACTIVE_SET_HEAP
+#ifdef APP_TIMER_ACTIVE_SET_TIMING_WHEEL
+    RUN_TEST(test_app_timer_wheel_cascade);
+#endif // APP_TIMER_ACTIVE_SET_TIMING_WHEEL
+#ifdef APP_TIMER_ACTIVE_SET_PERIOD_FIFO
+    RUN_TEST(test_app_timer_fifo_overflow);
+    RUN_TEST(test_app_timer_fifo_same_period_order);
+#endif // APP_TIMER_ACTIVE_SET_PERIOD_FIFO
+#ifdef APP_TIMER_ACTIVE_SET_DELTA_LIST
+    RUN_TEST(test_app_timer_delta_list_remove_middle);
+#endif // APP_TIMER_ACTIVE_SET_DELTA_LIST
 
     return UNITY_END();
 }